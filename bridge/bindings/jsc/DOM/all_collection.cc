@@ -9,7 +9,6 @@ namespace kraken::binding::jsc {
 
 JSValueRef JSAllCollection::getProperty(std::string &name, JSValueRef *exception) {
   auto &propertyMap = getAllCollectionPropertyMap();
-  JSStringHolder nameStringHolder = JSStringHolder(context, name);
 
   if (propertyMap.count(name) > 0) {
     auto &property = propertyMap[name];
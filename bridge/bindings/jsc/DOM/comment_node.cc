@@ -14,10 +14,9 @@ void bindCommentNode(std::unique_ptr<JSContext> &context) {
 
 JSCommentNode::JSCommentNode(JSContext *context) : JSNode(context, "CommentNode") {}
 
-std::unordered_map<JSContext *, JSCommentNode *> JSCommentNode::instanceMap{};
 
 JSCommentNode::~JSCommentNode() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSCommentNode, this);
 }
 
 JSObjectRef JSCommentNode::instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -40,9 +39,9 @@ JSCommentNode::CommentNodeInstance::CommentNodeInstance(JSCommentNode *jsComment
 
   std::string str = m_data.string();
   NativeString args_01{};
-  buildUICommandArgs(str, args_01);
+  buildUICommandArgs(jsCommentNode->context, str, args_01);
 
-  ::foundation::UICommandBuffer::instance(jsCommentNode->contextId)
+  jsCommentNode->context->commandBuffer()
     ->addCommand(eventTargetId, UICommand::createComment, args_01, nativeComment);
 }
 
@@ -55,14 +54,13 @@ JSValueRef JSCommentNode::CommentNodeInstance::getProperty(std::string &name, JS
 
   if (propertyMap.count(name) == 0) return NodeInstance::getProperty(name, exception);
 
-  CommentNodeProperty &property = propertyMap[name];
+  auto &property = propertyMap[name];
 
   switch (property) {
   case CommentNodeProperty::data:
     return m_data.makeString();
   case CommentNodeProperty::nodeName: {
-    JSStringRef nodeName = JSStringCreateWithUTF8CString("#comment");
-    return JSValueMakeString(_hostClass->ctx, nodeName);
+    return context->atomValue(context->atom("#comment"));
   }
   case CommentNodeProperty::length:
     return JSValueMakeNumber(_hostClass->ctx, m_data.size());
@@ -82,7 +80,7 @@ std::string JSCommentNode::CommentNodeInstance::internalGetTextContent() {
 }
 
 JSCommentNode::CommentNodeInstance::~CommentNodeInstance() {
-  ::foundation::UICommandCallbackQueue::instance()->registerCallback([](void *ptr) {
+  context->commandBuffer()->registerCallback([](void *ptr) {
     delete reinterpret_cast<NativeComment *>(ptr);
   }, nativeComment);
 }
@@ -17,7 +17,6 @@ struct NativeComment;
 
 class JSCommentNode : public JSNode {
 public:
-  static std::unordered_map<JSContext *, JSCommentNode *> instanceMap;
   OBJECT_INSTANCE(JSCommentNode)
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
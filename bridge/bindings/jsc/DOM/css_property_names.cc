@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+#include "css_property_names.h"
+#include <cassert>
+
+namespace kraken::binding::jsc {
+
+namespace {
+
+constexpr const char *camelCaseNames[]{
+#define KRAKEN_CSS_PROPERTY_CAMEL_NAME(NAME, _) #NAME,
+  KRAKEN_CSS_PROPERTY_NAMES(KRAKEN_CSS_PROPERTY_CAMEL_NAME)
+#undef KRAKEN_CSS_PROPERTY_CAMEL_NAME
+};
+
+constexpr const char *kebabCaseNames[]{
+#define KRAKEN_CSS_PROPERTY_KEBAB_NAME(_, NAME) NAME,
+  KRAKEN_CSS_PROPERTY_NAMES(KRAKEN_CSS_PROPERTY_KEBAB_NAME)
+#undef KRAKEN_CSS_PROPERTY_KEBAB_NAME
+};
+
+static_assert(sizeof(camelCaseNames) / sizeof(camelCaseNames[0]) == CSS_PROPERTY_COUNT);
+
+// Open addressing hash table of both spellings, built once at the first lookup and read only after that, so it can
+// be shared by all contexts without locking. A lookup hashes the name once and probes a few bytes.
+class CSSPropertyTable {
+public:
+  CSSPropertyTable() {
+    for (size_t i = 0; i < SLOT_COUNT; i++) {
+      m_slots[i] = EMPTY_SLOT;
+    }
+    for (size_t i = 0; i < CSS_PROPERTY_COUNT; i++) {
+      m_lengths[i] = std::char_traits<char>::length(camelCaseNames[i]);
+      insert(camelCaseNames[i], m_lengths[i], i);
+      // Single word names have the same spelling in both cases.
+      size_t kebabLength = std::char_traits<char>::length(kebabCaseNames[i]);
+      if (kebabLength != m_lengths[i]) insert(kebabCaseNames[i], kebabLength, i);
+    }
+  }
+
+  template <typename CharT> CSSPropertyID find(const CharT *chars, size_t length) const {
+    for (size_t slot = hash(chars, length) & (SLOT_COUNT - 1);; slot = (slot + 1) & (SLOT_COUNT - 1)) {
+      uint8_t index = m_slots[slot];
+      if (index == EMPTY_SLOT) return CSSPropertyID::Unknown;
+      if (matches(chars, length, index)) return static_cast<CSSPropertyID>(index);
+    }
+  }
+
+private:
+  // Two spellings per property with a load factor under one half.
+  static constexpr size_t SLOT_COUNT = 512;
+  static constexpr uint8_t EMPTY_SLOT = 0xff;
+  static_assert(CSS_PROPERTY_COUNT * 4 <= SLOT_COUNT && CSS_PROPERTY_COUNT < EMPTY_SLOT);
+
+  // FNV-1a over code units, property names are ASCII so UTF-8 and UTF-16 names have the same hash.
+  template <typename CharT> static uint32_t hash(const CharT *chars, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+      hash ^= static_cast<uint32_t>(chars[i]) & 0xffff;
+      hash *= 16777619u;
+    }
+    return hash ^ (hash >> 16);
+  }
+
+  template <typename CharT> static bool equals(const CharT *chars, size_t length, const char *name) {
+    for (size_t i = 0; i < length; i++) {
+      if (static_cast<uint32_t>(chars[i]) != static_cast<uint8_t>(name[i]) || name[i] == '\0') return false;
+    }
+    return name[length] == '\0';
+  }
+
+  template <typename CharT> bool matches(const CharT *chars, size_t length, uint8_t index) const {
+    if (length == m_lengths[index]) return equals(chars, length, camelCaseNames[index]);
+    return equals(chars, length, kebabCaseNames[index]);
+  }
+
+  void insert(const char *name, size_t length, size_t index) {
+    size_t slot = hash(name, length) & (SLOT_COUNT - 1);
+    while (m_slots[slot] != EMPTY_SLOT) slot = (slot + 1) & (SLOT_COUNT - 1);
+    m_slots[slot] = static_cast<uint8_t>(index);
+  }
+
+  uint8_t m_slots[SLOT_COUNT];
+  size_t m_lengths[CSS_PROPERTY_COUNT];
+};
+
+const CSSPropertyTable &propertyTable() {
+  static const CSSPropertyTable table;
+  return table;
+}
+
+} // namespace
+
+CSSPropertyID cssPropertyID(const std::string &name) {
+  return propertyTable().find(name.data(), name.size());
+}
+
+CSSPropertyID cssPropertyID(const uint16_t *chars, size_t length) {
+  return propertyTable().find(chars, length);
+}
+
+const std::string &cssPropertyName(CSSPropertyID id) {
+  assert(id < CSSPropertyID::COUNT);
+  static const std::string *names = [] {
+    auto names = new std::string[CSS_PROPERTY_COUNT];
+    for (size_t i = 0; i < CSS_PROPERTY_COUNT; i++) {
+      names[i] = camelCaseNames[i];
+    }
+    return names;
+  }();
+  return names[static_cast<size_t>(id)];
+}
+
+const char *cssPropertyKebabName(CSSPropertyID id) {
+  assert(id < CSSPropertyID::COUNT);
+  return kebabCaseNames[static_cast<size_t>(id)];
+}
+
+} // namespace kraken::binding::jsc
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+#ifndef KRAKENBRIDGE_CSS_PROPERTY_NAMES_H
+#define KRAKENBRIDGE_CSS_PROPERTY_NAMES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace kraken::binding::jsc {
+
+// CSS properties supported by dart side, in (camelCase, kebab-case) pairs. Property ids are dense and follow the
+// order of this list.
+#define KRAKEN_CSS_PROPERTY_NAMES(V)                                                                                   \
+  V(display, "display")                                                                                                \
+  V(position, "position")                                                                                              \
+  V(top, "top")                                                                                                        \
+  V(right, "right")                                                                                                    \
+  V(bottom, "bottom")                                                                                                  \
+  V(left, "left")                                                                                                      \
+  V(zIndex, "z-index")                                                                                                 \
+  V(opacity, "opacity")                                                                                                \
+  V(visibility, "visibility")                                                                                          \
+  V(contentVisibility, "content-visibility")                                                                           \
+  V(overflow, "overflow")                                                                                              \
+  V(overflowX, "overflow-x")                                                                                           \
+  V(overflowY, "overflow-y")                                                                                           \
+  V(width, "width")                                                                                                    \
+  V(height, "height")                                                                                                  \
+  V(minWidth, "min-width")                                                                                             \
+  V(maxWidth, "max-width")                                                                                             \
+  V(minHeight, "min-height")                                                                                           \
+  V(maxHeight, "max-height")                                                                                           \
+  V(margin, "margin")                                                                                                  \
+  V(marginTop, "margin-top")                                                                                           \
+  V(marginRight, "margin-right")                                                                                       \
+  V(marginBottom, "margin-bottom")                                                                                     \
+  V(marginLeft, "margin-left")                                                                                         \
+  V(padding, "padding")                                                                                                \
+  V(paddingTop, "padding-top")                                                                                         \
+  V(paddingRight, "padding-right")                                                                                     \
+  V(paddingBottom, "padding-bottom")                                                                                   \
+  V(paddingLeft, "padding-left")                                                                                       \
+  V(border, "border")                                                                                                  \
+  V(borderTop, "border-top")                                                                                           \
+  V(borderRight, "border-right")                                                                                       \
+  V(borderBottom, "border-bottom")                                                                                     \
+  V(borderLeft, "border-left")                                                                                         \
+  V(borderWidth, "border-width")                                                                                       \
+  V(borderTopWidth, "border-top-width")                                                                                \
+  V(borderRightWidth, "border-right-width")                                                                            \
+  V(borderBottomWidth, "border-bottom-width")                                                                          \
+  V(borderLeftWidth, "border-left-width")                                                                              \
+  V(borderStyle, "border-style")                                                                                       \
+  V(borderTopStyle, "border-top-style")                                                                                \
+  V(borderRightStyle, "border-right-style")                                                                            \
+  V(borderBottomStyle, "border-bottom-style")                                                                          \
+  V(borderLeftStyle, "border-left-style")                                                                              \
+  V(borderColor, "border-color")                                                                                       \
+  V(borderTopColor, "border-top-color")                                                                                \
+  V(borderRightColor, "border-right-color")                                                                            \
+  V(borderBottomColor, "border-bottom-color")                                                                          \
+  V(borderLeftColor, "border-left-color")                                                                              \
+  V(borderRadius, "border-radius")                                                                                     \
+  V(borderTopLeftRadius, "border-top-left-radius")                                                                     \
+  V(borderTopRightRadius, "border-top-right-radius")                                                                   \
+  V(borderBottomRightRadius, "border-bottom-right-radius")                                                             \
+  V(borderBottomLeftRadius, "border-bottom-left-radius")                                                               \
+  V(boxShadow, "box-shadow")                                                                                           \
+  V(background, "background")                                                                                          \
+  V(backgroundAttachment, "background-attachment")                                                                     \
+  V(backgroundClip, "background-clip")                                                                                 \
+  V(backgroundColor, "background-color")                                                                               \
+  V(backgroundImage, "background-image")                                                                               \
+  V(backgroundOrigin, "background-origin")                                                                             \
+  V(backgroundPosition, "background-position")                                                                         \
+  V(backgroundPositionX, "background-position-x")                                                                      \
+  V(backgroundPositionY, "background-position-y")                                                                      \
+  V(backgroundRepeat, "background-repeat")                                                                             \
+  V(backgroundSize, "background-size")                                                                                 \
+  V(color, "color")                                                                                                    \
+  V(font, "font")                                                                                                      \
+  V(fontFamily, "font-family")                                                                                         \
+  V(fontSize, "font-size")                                                                                             \
+  V(fontStyle, "font-style")                                                                                           \
+  V(fontWeight, "font-weight")                                                                                         \
+  V(lineHeight, "line-height")                                                                                         \
+  V(letterSpacing, "letter-spacing")                                                                                   \
+  V(wordSpacing, "word-spacing")                                                                                       \
+  V(whiteSpace, "white-space")                                                                                         \
+  V(textAlign, "text-align")                                                                                           \
+  V(textDecoration, "text-decoration")                                                                                 \
+  V(textDecorationColor, "text-decoration-color")                                                                      \
+  V(textDecorationLine, "text-decoration-line")                                                                        \
+  V(textDecorationStyle, "text-decoration-style")                                                                      \
+  V(textOverflow, "text-overflow")                                                                                     \
+  V(textShadow, "text-shadow")                                                                                         \
+  V(lineClamp, "line-clamp")                                                                                           \
+  V(verticalAlign, "vertical-align")                                                                                   \
+  V(flex, "flex")                                                                                                      \
+  V(flexBasis, "flex-basis")                                                                                           \
+  V(flexDirection, "flex-direction")                                                                                   \
+  V(flexFlow, "flex-flow")                                                                                             \
+  V(flexGrow, "flex-grow")                                                                                             \
+  V(flexShrink, "flex-shrink")                                                                                         \
+  V(flexWrap, "flex-wrap")                                                                                             \
+  V(alignContent, "align-content")                                                                                     \
+  V(alignItems, "align-items")                                                                                         \
+  V(alignSelf, "align-self")                                                                                           \
+  V(justifyContent, "justify-content")                                                                                 \
+  V(sliverDirection, "sliver-direction")                                                                               \
+  V(objectFit, "object-fit")                                                                                           \
+  V(objectPosition, "object-position")                                                                                 \
+  V(filter, "filter")                                                                                                  \
+  V(transform, "transform")                                                                                            \
+  V(transformOrigin, "transform-origin")                                                                               \
+  V(transition, "transition")                                                                                          \
+  V(transitionDelay, "transition-delay")                                                                               \
+  V(transitionDuration, "transition-duration")                                                                         \
+  V(transitionProperty, "transition-property")                                                                         \
+  V(transitionTimingFunction, "transition-timing-function")
+
+enum class CSSPropertyID : uint8_t {
+#define KRAKEN_CSS_PROPERTY_ID(NAME, _) NAME,
+  KRAKEN_CSS_PROPERTY_NAMES(KRAKEN_CSS_PROPERTY_ID)
+#undef KRAKEN_CSS_PROPERTY_ID
+  COUNT,
+  // Custom properties and properties not known by dart side.
+  Unknown = COUNT
+};
+
+constexpr size_t CSS_PROPERTY_COUNT = static_cast<size_t>(CSSPropertyID::COUNT);
+
+// Look up a property by either its camelCase or kebab-case name, UTF-8 or UTF-16 code units, returns
+// CSSPropertyID::Unknown if the property is not in the list.
+CSSPropertyID cssPropertyID(const std::string &name);
+CSSPropertyID cssPropertyID(const uint16_t *chars, size_t length);
+
+// camelCase name of the property, which is also the key of setStyle commands.
+const std::string &cssPropertyName(CSSPropertyID id);
+// kebab-case name of the property, used by cssText.
+const char *cssPropertyKebabName(CSSPropertyID id);
+
+} // namespace kraken::binding::jsc
+
+#endif // KRAKENBRIDGE_CSS_PROPERTY_NAMES_H
@@ -14,10 +14,9 @@ void bindCustomEvent(std::unique_ptr<JSContext> &context) {
   JSC_GLOBAL_SET_PROPERTY(context, "CustomEvent", CustomEvent->classObject);
 };
 
-std::unordered_map<JSContext *, JSCustomEvent *> JSCustomEvent::instanceMap{};
 
 JSCustomEvent::~JSCustomEvent() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSCustomEvent, this);
 }
 
 JSCustomEvent::JSCustomEvent(JSContext *context) : JSEvent(context, "CustomEvent") {}
@@ -67,8 +66,7 @@ JSValueRef CustomEventInstance::getProperty(std::string &name, JSValueRef *excep
   auto &prototypePropertyMap = JSCustomEvent::getCustomEventPrototypePropertyMap();
 
   if (prototypePropertyMap.count(name) > 0) {
-    JSStringHolder nameStringHolder = JSStringHolder(context, name);
-    return JSObjectGetProperty(ctx, prototype<JSCustomEvent>()->prototypeObject, nameStringHolder.getString(), exception);
+    return JSObjectGetProperty(ctx, prototype<JSCustomEvent>()->prototypeObject, context->atom(name), exception);
   };
 
   if (propertyMap.count(name) == 0) return EventInstance::getProperty(name, exception);
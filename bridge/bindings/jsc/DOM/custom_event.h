@@ -31,7 +31,6 @@ public:
   DEFINE_OBJECT_PROPERTY(CustomEvent, 1, detail)
   DEFINE_PROTOTYPE_OBJECT_PROPERTY(CustomEvent, 1, initCustomEvent)
 
-  static std::unordered_map<JSContext *, JSCustomEvent *> instanceMap;
   OBJECT_INSTANCE(JSCustomEvent)
 
   static JSValueRef initCustomEvent(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argumentCount,
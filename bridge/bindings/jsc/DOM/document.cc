@@ -20,17 +20,19 @@ void bindDocument(std::unique_ptr<JSContext> &context) {
   JSC_GLOBAL_SET_PROPERTY(context, "document", documentObjectRef);
 }
 
-std::unordered_map<JSContext *, JSDocument *> JSDocument::instanceMap{};
 
 JSDocument *JSDocument::instance(JSContext *context) {
-  if (instanceMap.count(context) == 0) {
-    instanceMap[context] = new JSDocument(context);
+  auto &bindingState = context->bindingState();
+  auto hostClass = bindingState.hostClass<JSDocument>(BindingSlot::JSDocument);
+  if (hostClass == nullptr) {
+    hostClass = new JSDocument(context);
+    bindingState.setHostClass(BindingSlot::JSDocument, hostClass);
   }
-  return instanceMap[context];
+  return hostClass;
 }
 
 JSDocument::~JSDocument() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSDocument, this);
 }
 
 JSValueRef JSDocument::createEvent(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
@@ -200,8 +202,6 @@ JSObjectRef JSDocument::instanceConstructor(JSContextRef ctx, JSObjectRef constr
   return instance->object;
 }
 
-static std::unordered_map<JSContext *, DocumentInstance *> instanceMap{};
-
 std::string DocumentCookie::getCookie() {
   std::string result;
   size_t i = 0;
@@ -249,7 +249,7 @@ void DocumentCookie::setCookie(std::string &cookieStr) {
 }
 
 DocumentInstance *DocumentInstance::instance(JSContext *context) {
-  return instanceMap[context];
+  return context->bindingState().document;
 }
 
 DocumentInstance::DocumentInstance(JSDocument *document)
@@ -257,7 +257,7 @@ DocumentInstance::DocumentInstance(JSDocument *document)
     nativeDocument(new NativeDocument(nativeNode)) {
   m_document = this;
 
-  JSStringRef tagName = JSStringCreateWithUTF8CString("HTML");
+  JSStringRef tagName = context->atom("HTML");
   documentElement = new ElementInstance(JSElement::instance(document->context), tagName, HTML_TARGET_ID);
   documentElement->m_document = this;
   documentElement->parentNode = this;
@@ -265,24 +265,23 @@ DocumentInstance::DocumentInstance(JSDocument *document)
   JSObjectSetProperty(ctx, object, documentElementStringHolder.getString(),
                       documentElement->object, kJSPropertyAttributeReadOnly, nullptr);
 
-  instanceMap[document->context] = this;
+  context->bindingState().document = this;
   getDartMethod()->initDocument(contextId, nativeDocument);
 }
 
 JSValueRef DocumentInstance::getProperty(std::string &name, JSValueRef *exception) {
   auto &propertyMap = getDocumentPropertyMap();
   auto &prototypePropertyMap = getDocumentPrototypePropertyMap();
-  JSStringHolder nameStringHolder = JSStringHolder(context, name);
 
   if (prototypePropertyMap.count(name) > 0) {
-    return JSObjectGetProperty(ctx, prototype<JSDocument>()->prototypeObject, nameStringHolder.getString(), exception);
+    return JSObjectGetProperty(ctx, prototype<JSDocument>()->prototypeObject, context->atom(name), exception);
   }
 
   if (propertyMap.count(name) == 0) {
     return NodeInstance::getProperty(name, exception);
   }
 
-  DocumentProperty &property = propertyMap[name];
+  auto &property = propertyMap[name];
 
   switch (property) {
   case DocumentProperty::documentElement: {
@@ -303,8 +302,7 @@ JSValueRef DocumentInstance::getProperty(std::string &name, JSValueRef *exceptio
     return JSValueMakeString(ctx, JSStringCreateWithUTF8CString(cookie.c_str()));
   }
   case DocumentProperty::nodeName: {
-    JSStringRef nodeName = JSStringCreateWithUTF8CString("#document");
-    return JSValueMakeString(_hostClass->ctx, nodeName);
+    return context->atomValue(context->atom("#document"));
   }
   }
 
@@ -312,9 +310,9 @@ JSValueRef DocumentInstance::getProperty(std::string &name, JSValueRef *exceptio
 }
 
 DocumentInstance::~DocumentInstance() {
-  ::foundation::UICommandCallbackQueue::instance()->registerCallback(
+  context->commandBuffer()->registerCallback(
     [](void *ptr) { delete reinterpret_cast<NativeDocument *>(ptr); }, nativeDocument);
-  instanceMap.erase(context);
+  if (context->bindingState().document == this) context->bindingState().document = nullptr;
 }
 
 void DocumentInstance::getPropertyNames(JSPropertyNameAccumulatorRef accumulator) {
@@ -4,6 +4,7 @@
  */
 
 #include "element.h"
+#include "bindings/jsc/DOM/elements/canvas_element.h"
 #include "bindings/jsc/KOM/blob.h"
 #include "bridge_jsc.h"
 #include "dart_methods.h"
@@ -13,10 +14,22 @@
 namespace kraken::binding::jsc {
 using namespace foundation;
 
+namespace {
+
+// Doubles of NativeBoundingClientRect.
+constexpr size_t BOUNDING_CLIENT_RECT_SIZE = 8;
+
+NativeBoundingClientRect *createBoundingClientRect(const double *rect) {
+  return new NativeBoundingClientRect{rect[0], rect[1], rect[2], rect[3], rect[4], rect[5], rect[6], rect[7]};
+}
+
+} // namespace
+
 void bindElement(std::unique_ptr<JSContext> &context) {
   auto element = JSElement::instance(context.get());
   JSC_GLOBAL_SET_PROPERTY(context, "Element", element->classObject);
   JSC_GLOBAL_SET_PROPERTY(context, "HTMLElement", element->classObject);
+  JSC_GLOBAL_BINDING_FUNCTION(context, "__kraken_get_bounding_client_rects__", JSElement::getBoundingClientRects);
 }
 
 std::vector<JSStringRef> &JSElementAttributes::getAttributePropertyNames() {
@@ -37,10 +50,8 @@ JSValueRef JSElementAttributes::getProperty(std::string &name, JSValueRef *excep
     case AttributeProperty::kLength:
       return JSValueMakeNumber(ctx, m_attributes.size());
     }
-  } else if (hasAttribute(name)) {
-    return getAttribute(name);
   }
-  return nullptr;
+  return getAttribute(name);
 }
 
 bool JSElementAttributes::setProperty(std::string &name, JSValueRef value, JSValueRef *exception) {
@@ -52,86 +63,76 @@ void JSElementAttributes::getPropertyNames(JSPropertyNameAccumulatorRef accumula
     JSPropertyNameAccumulatorAddName(accumulator, property);
   }
 
-  for (auto &property : m_attributes) {
-    JSPropertyNameAccumulatorAddName(accumulator, JSValueToStringCopy(ctx, property.second, nullptr));
+  for (auto &attribute : m_attributes) {
+    JSPropertyNameAccumulatorAddName(accumulator, attribute.name);
+  }
+}
+JSElementAttributes::~JSElementAttributes() {
+  for (auto &attribute : m_attributes) {
+    JSStringRelease(attribute.value);
   }
 }
-JSElementAttributes::~JSElementAttributes() {}
 
-JSValueRef JSElementAttributes::getAttribute(std::string &name) {
-  bool numberIndex = isNumberIndex(name);
+int32_t JSElementAttributes::indexOf(std::string &name) {
+  if (isNumberIndex(name)) {
+    uint64_t index = std::strtoull(name.c_str(), nullptr, 10);
+    return index < m_attributes.size() ? static_cast<int32_t>(index) : -1;
+  }
 
-  if (numberIndex) {
-    int64_t index = std::stoi(name);
-    return v_attributes[index];
+  // Attribute lists are short, comparing names does not intern the names which are only looked up.
+  for (uint32_t i = 0; i < m_attributes.size(); i++) {
+    if (JSStringIsEqualToUTF8CString(m_attributes[i].name, name.c_str())) return i;
   }
+  return -1;
+}
 
-  return m_attributes[name];
+JSValueRef JSElementAttributes::getAttribute(std::string &name) {
+  int32_t index = indexOf(name);
+  if (index < 0) return nullptr;
+  return JSValueMakeString(ctx, m_attributes[index].value);
 }
 
 void JSElementAttributes::setAttribute(std::string &name, JSValueRef value) {
-  bool numberIndex = isNumberIndex(name);
-
-  JSValueProtect(ctx, value);
+  JSStringRef string = JSValueToStringCopy(ctx, value, nullptr);
+  if (string == nullptr) return;
 
-  if (numberIndex) {
-    int64_t index = std::stoi(name);
-
-    v_attributes[index] = value;
+  int32_t index = indexOf(name);
+  if (index >= 0) {
+    JSStringRelease(m_attributes[index].value);
+    m_attributes[index].value = string;
   } else {
-    v_attributes.emplace_back(value);
+    m_attributes.push_back({context->atom(name), string});
   }
-
-  m_attributes[name] = value;
 }
 
 bool JSElementAttributes::hasAttribute(std::string &name) {
-  bool numberIndex = isNumberIndex(name);
-
-  if (numberIndex) {
-    size_t index = std::stoi(name);
-    return v_attributes[index] != nullptr;
-  }
-
-  return m_attributes.count(name) > 0;
+  return indexOf(name) >= 0;
 }
 
 void JSElementAttributes::removeAttribute(std::string &name) {
-  JSValueRef value = m_attributes[name];
-  JSValueUnprotect(ctx, value);
-  auto index = std::find(v_attributes.begin(), v_attributes.end(), value);
-  v_attributes.erase(index);
-
-  m_attributes.erase(name);
-}
+  int32_t index = indexOf(name);
+  if (index < 0) return;
 
-std::map<std::string, JSValueRef> &JSElementAttributes::getAttributesMap() {
-  return m_attributes;
+  JSStringRelease(m_attributes[index].value);
+  m_attributes.erase(index);
 }
 
-void JSElementAttributes::setAttributesMap(std::map<std::string, JSValueRef> &attributes) {
-  auto &&iter = attributes.begin();
-  while (iter != attributes.end()) {
-    m_attributes[iter->first] = iter->second;
-    iter++;
+void JSElementAttributes::copyWith(JSElementAttributes *other) {
+  for (auto &attribute : m_attributes) {
+    JSStringRelease(attribute.value);
+  }
+  m_attributes = other->m_attributes;
+  for (auto &attribute : m_attributes) {
+    JSStringRetain(attribute.value);
   }
 }
 
-std::vector<JSValueRef> &JSElementAttributes::getAttributesVector() {
-  return v_attributes;
-}
-
-void JSElementAttributes::setAttributesVector(std::vector<JSValueRef> &attributes) {
-  v_attributes.assign(attributes.begin(), attributes.end());
-}
-
-std::unordered_map<JSContext *, JSElement *> JSElement::instanceMap{};
 std::unordered_map<std::string, ElementCreator> JSElement::elementCreatorMap{};
 
 JSElement::JSElement(JSContext *context) : JSNode(context, "Element") {}
 
 JSElement::~JSElement() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSElement, this);
 }
 
 JSObjectRef JSElement::instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -149,20 +150,20 @@ JSObjectRef JSElement::instanceConstructor(JSContextRef ctx, JSObjectRef constru
 
 ElementInstance::ElementInstance(JSElement *element, const char *tagName, bool shouldAddUICommand)
   : NodeInstance(element, NodeType::ELEMENT_NODE), nativeElement(new NativeElement(nativeNode)) {
-  m_tagName.setString(JSStringCreateWithUTF8CString(tagName));
+  m_tagName = context->atom(tagName);
 
   if (shouldAddUICommand) {
     std::string t = std::string(tagName);
     NativeString args_01{};
-    buildUICommandArgs(t, args_01);
-    ::foundation::UICommandBuffer::instance(element->context->getContextId())
+    buildUICommandAtomArgs(element->context, t, args_01);
+    element->context->commandBuffer()
         ->addCommand(eventTargetId, UICommand::createElement, args_01, nativeElement);
   }
 }
 // Only for init HTML element
 ElementInstance::ElementInstance(JSElement *element, JSStringRef tagNameStringRef, double targetId)
   : NodeInstance(element, NodeType::ELEMENT_NODE, targetId), nativeElement(new NativeElement(nativeNode)) {
-  m_tagName.setString(tagNameStringRef);
+  m_tagName = context->atom(tagNameStringRef);
   // Do not needs to send create element for HTML element.
   if (targetId == HTML_TARGET_ID) {
     assert_m(getDartMethod()->initHTML != nullptr, "Failed to execute initHTML(): dart method is nullptr.");
@@ -171,133 +172,179 @@ ElementInstance::ElementInstance(JSElement *element, JSStringRef tagNameStringRe
 }
 
 ElementInstance::~ElementInstance() {
-  ::foundation::UICommandCallbackQueue::instance()->registerCallback(
+  ::foundation::UIGeometrySnapshot::instance(_hostClass->contextId)->unwatch(eventTargetId);
+  context->commandBuffer()->registerCallback(
     [](void *ptr) { delete reinterpret_cast<NativeElement *>(ptr); }, nativeElement);
 }
 
 JSValueRef JSElement::getBoundingClientRect(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
                                             size_t argumentCount, const JSValueRef *arguments, JSValueRef *exception) {
   auto elementInstance = reinterpret_cast<ElementInstance *>(JSObjectGetPrivate(thisObject));
-  getDartMethod()->flushUICommand();
-  assert_m(elementInstance->nativeElement->getBoundingClientRect != nullptr,
-           "Failed to execute getBoundingClientRect(): dart method is nullptr.");
-  NativeBoundingClientRect *nativeBoundingClientRect =
-    elementInstance->nativeElement->getBoundingClientRect(elementInstance->nativeElement);
-  auto boundingClientRect = new BoundingClientRect(elementInstance->context, nativeBoundingClientRect);
+  auto boundingClientRect = new BoundingClientRect(elementInstance->context, elementInstance->getBoundingClientRect());
   return boundingClientRect->jsObject;
 }
 
+JSValueRef JSElement::getBoundingClientRects(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+                                             size_t argumentCount, const JSValueRef *arguments,
+                                             JSValueRef *exception) {
+  if (argumentCount < 1 || !JSValueIsArray(ctx, arguments[0])) {
+    throwJSError(ctx, "Failed to execute 'getBoundingClientRects': first argument should be an array of elements.",
+                 exception);
+    return nullptr;
+  }
+
+  auto context = static_cast<JSContext *>(JSObjectGetPrivate(function));
+  JSObjectRef arrayObjectRef = JSValueToObject(ctx, arguments[0], exception);
+  JSStringHolder lengthStringHolder = JSStringHolder(context, "length");
+  auto length = static_cast<size_t>(
+    JSValueToNumber(ctx, JSObjectGetProperty(ctx, arrayObjectRef, lengthStringHolder.getString(), exception), exception));
+
+  std::vector<ElementInstance *> elements;
+  elements.reserve(length);
+  for (size_t i = 0; i < length; i++) {
+    JSValueRef elementValueRef = JSObjectGetPropertyAtIndex(ctx, arrayObjectRef, i, exception);
+    auto nodeInstance = JSValueIsObject(ctx, elementValueRef)
+                          ? static_cast<NodeInstance *>(JSObjectGetPrivate(JSValueToObject(ctx, elementValueRef, exception)))
+                          : nullptr;
+    if (nodeInstance == nullptr || nodeInstance->nodeType != NodeType::ELEMENT_NODE) {
+      throwJSError(ctx, "Failed to execute 'getBoundingClientRects': array items should be elements.", exception);
+      return nullptr;
+    }
+    elements.emplace_back(static_cast<ElementInstance *>(nodeInstance));
+  }
+
+  // Flush once for the whole batch, elements missed in the snapshot will be published after the next layout.
+  context->commandBuffer()->flushForLayout();
+
+  auto snapshot = ::foundation::UIGeometrySnapshot::instance(context->getContextId());
+  std::vector<NativeBoundingClientRect *> nativeRects(length, nullptr);
+  std::vector<int32_t> missedTargetIds;
+  for (size_t i = 0; i < length; i++) {
+    if (const double *row = snapshot->read(elements[i]->eventTargetId)) {
+      nativeRects[i] = createBoundingClientRect(row + GEOMETRY_BOUNDING_CLIENT_RECT_OFFSET);
+    } else {
+      missedTargetIds.emplace_back(elements[i]->eventTargetId);
+    }
+  }
+
+  // Read all missed elements from dart side with one call.
+  if (!missedTargetIds.empty()) {
+    auto getBoundingClientRects = getDartMethod()->getBoundingClientRects;
+    std::vector<double> missedRects;
+    if (getBoundingClientRects != nullptr) {
+      missedRects.resize(missedTargetIds.size() * BOUNDING_CLIENT_RECT_SIZE);
+      getBoundingClientRects(context->getContextId(), missedTargetIds.data(),
+                             static_cast<int32_t>(missedTargetIds.size()), missedRects.data());
+    }
+    size_t missed = 0;
+    for (size_t i = 0; i < length; i++) {
+      if (nativeRects[i] != nullptr) continue;
+      nativeRects[i] = getBoundingClientRects != nullptr
+                         ? createBoundingClientRect(missedRects.data() + missed * BOUNDING_CLIENT_RECT_SIZE)
+                         : elements[i]->getBoundingClientRect();
+      missed++;
+    }
+  }
+
+  std::vector<JSValueRef> rects;
+  rects.reserve(length);
+  for (auto &nativeRect : nativeRects) {
+    auto boundingClientRect = new BoundingClientRect(context, nativeRect);
+    rects.emplace_back(boundingClientRect->jsObject);
+  }
+
+  return JSObjectMakeArray(ctx, rects.size(), rects.data(), exception);
+}
+
+double ElementInstance::getViewModuleProperty(ViewModuleProperty property) {
+  auto snapshot = ::foundation::UIGeometrySnapshot::instance(_hostClass->contextId);
+  if (const double *row = snapshot->read(eventTargetId)) {
+    return row[static_cast<int32_t>(property)];
+  }
+
+  context->commandBuffer()->flushForLayout();
+  assert_m(nativeElement->getViewModuleProperty != nullptr,
+           "Failed to execute getViewModuleProperty(): dart method is nullptr.");
+  return nativeElement->getViewModuleProperty(nativeElement, static_cast<int64_t>(property));
+}
+
+NativeBoundingClientRect *ElementInstance::getBoundingClientRect() {
+  auto snapshot = ::foundation::UIGeometrySnapshot::instance(_hostClass->contextId);
+  if (const double *row = snapshot->read(eventTargetId)) {
+    return createBoundingClientRect(row + GEOMETRY_BOUNDING_CLIENT_RECT_OFFSET);
+  }
+
+  context->commandBuffer()->flushForLayout();
+  assert_m(nativeElement->getBoundingClientRect != nullptr,
+           "Failed to execute getBoundingClientRect(): dart method is nullptr.");
+  return nativeElement->getBoundingClientRect(nativeElement);
+}
+
 JSValueRef ElementInstance::getProperty(std::string &name, JSValueRef *exception) {
   auto &propertyMap = JSElement::getElementPropertyMap();
   auto &prototypePropertyMap = JSElement::getElementPrototypePropertyMap();
-  JSStringHolder nameStringHolder = JSStringHolder(context, name);
 
   if (prototypePropertyMap.count(name) > 0) {
-    return JSObjectGetProperty(ctx, prototype<JSElement>()->prototypeObject, nameStringHolder.getString(), exception);
+    return JSObjectGetProperty(ctx, prototype<JSElement>()->prototypeObject, context->atom(name), exception);
   }
 
   if (propertyMap.count(name) == 0) {
     return NodeInstance::getProperty(name, exception);
   }
 
-  JSElement::ElementProperty &property = propertyMap[name];
+  auto &property = propertyMap[name];
 
   switch (property) {
   case JSElement::ElementProperty::nodeName:
   case JSElement::ElementProperty::tagName: {
-    return JSValueMakeString(_hostClass->ctx, JSStringCreateWithUTF8CString(tagName().c_str()));
+    if (m_upperCaseTagName == nullptr) {
+      m_upperCaseTagName = context->atom(tagName());
+    }
+    return context->atomValue(m_upperCaseTagName);
   }
   case JSElement::ElementProperty::attributes:
   case JSElement::ElementProperty::style: {
     return nullptr;
   }
   case JSElement::ElementProperty::offsetLeft: {
-    getDartMethod()->flushUICommand();
-    assert_m(nativeElement->getViewModuleProperty != nullptr,
-             "Failed to execute getViewModuleProperty(): dart method is nullptr.");
-    return JSValueMakeNumber(_hostClass->ctx, nativeElement->getViewModuleProperty(
-                                                nativeElement, static_cast<int64_t>(ViewModuleProperty::offsetLeft)));
+    return JSValueMakeNumber(_hostClass->ctx, getViewModuleProperty(ViewModuleProperty::offsetLeft));
   }
   case JSElement::ElementProperty::offsetTop: {
-    getDartMethod()->flushUICommand();
-    assert_m(nativeElement->getViewModuleProperty != nullptr,
-             "Failed to execute getViewModuleProperty(): dart method is nullptr.");
-    return JSValueMakeNumber(_hostClass->ctx, nativeElement->getViewModuleProperty(
-                                                nativeElement, static_cast<int64_t>(ViewModuleProperty::offsetTop)));
+    return JSValueMakeNumber(_hostClass->ctx, getViewModuleProperty(ViewModuleProperty::offsetTop));
   }
   case JSElement::ElementProperty::offsetWidth: {
-    getDartMethod()->flushUICommand();
-    assert_m(nativeElement->getViewModuleProperty != nullptr,
-             "Failed to execute getViewModuleProperty(): dart method is nullptr.");
-    return JSValueMakeNumber(_hostClass->ctx, nativeElement->getViewModuleProperty(
-                                                nativeElement, static_cast<int64_t>(ViewModuleProperty::offsetWidth)));
+    return JSValueMakeNumber(_hostClass->ctx, getViewModuleProperty(ViewModuleProperty::offsetWidth));
   }
   case JSElement::ElementProperty::offsetHeight: {
-    getDartMethod()->flushUICommand();
-    assert_m(nativeElement->getViewModuleProperty != nullptr,
-             "Failed to execute getViewModuleProperty(): dart method is nullptr.");
-    return JSValueMakeNumber(_hostClass->ctx, nativeElement->getViewModuleProperty(
-                                                nativeElement, static_cast<int64_t>(ViewModuleProperty::offsetHeight)));
+    return JSValueMakeNumber(_hostClass->ctx, getViewModuleProperty(ViewModuleProperty::offsetHeight));
   }
   case JSElement::ElementProperty::clientWidth: {
-    getDartMethod()->flushUICommand();
-    assert_m(nativeElement->getViewModuleProperty != nullptr,
-             "Failed to execute getViewModuleProperty(): dart method is nullptr.");
-    return JSValueMakeNumber(_hostClass->ctx, nativeElement->getViewModuleProperty(
-                                                nativeElement, static_cast<int64_t>(ViewModuleProperty::clientWidth)));
+    return JSValueMakeNumber(_hostClass->ctx, getViewModuleProperty(ViewModuleProperty::clientWidth));
   }
   case JSElement::ElementProperty::clientHeight: {
-    getDartMethod()->flushUICommand();
-    assert_m(nativeElement->getViewModuleProperty != nullptr,
-             "Failed to execute getViewModuleProperty(): dart method is nullptr.");
-    return JSValueMakeNumber(_hostClass->ctx, nativeElement->getViewModuleProperty(
-                                                nativeElement, static_cast<int64_t>(ViewModuleProperty::clientHeight)));
+    return JSValueMakeNumber(_hostClass->ctx, getViewModuleProperty(ViewModuleProperty::clientHeight));
   }
   case JSElement::ElementProperty::clientTop: {
-    getDartMethod()->flushUICommand();
-    assert_m(nativeElement->getViewModuleProperty != nullptr,
-             "Failed to execute getViewModuleProperty(): dart method is nullptr.");
-    return JSValueMakeNumber(_hostClass->ctx, nativeElement->getViewModuleProperty(
-                                                nativeElement, static_cast<int64_t>(ViewModuleProperty::clientTop)));
+    return JSValueMakeNumber(_hostClass->ctx, getViewModuleProperty(ViewModuleProperty::clientTop));
   }
   case JSElement::ElementProperty::clientLeft: {
-    getDartMethod()->flushUICommand();
-    assert_m(nativeElement->getViewModuleProperty != nullptr,
-             "Failed to execute getViewModuleProperty(): dart method is nullptr.");
-    return JSValueMakeNumber(_hostClass->ctx, nativeElement->getViewModuleProperty(
-                                                nativeElement, static_cast<int64_t>(ViewModuleProperty::clientLeft)));
+    return JSValueMakeNumber(_hostClass->ctx, getViewModuleProperty(ViewModuleProperty::clientLeft));
   }
   case JSElement::ElementProperty::scrollTop: {
-    getDartMethod()->flushUICommand();
-    assert_m(nativeElement->getViewModuleProperty != nullptr,
-             "Failed to execute getViewModuleProperty(): dart method is nullptr.");
-    return JSValueMakeNumber(_hostClass->ctx, nativeElement->getViewModuleProperty(
-                                                nativeElement, static_cast<int64_t>(ViewModuleProperty::scrollTop)));
+    return JSValueMakeNumber(_hostClass->ctx, getViewModuleProperty(ViewModuleProperty::scrollTop));
   }
   case JSElement::ElementProperty::scrollLeft: {
-    getDartMethod()->flushUICommand();
-    assert_m(nativeElement->getViewModuleProperty != nullptr,
-             "Failed to execute getViewModuleProperty(): dart method is nullptr.");
-    return JSValueMakeNumber(_hostClass->ctx, nativeElement->getViewModuleProperty(
-                                                nativeElement, static_cast<int64_t>(ViewModuleProperty::scrollLeft)));
+    return JSValueMakeNumber(_hostClass->ctx, getViewModuleProperty(ViewModuleProperty::scrollLeft));
   }
   case JSElement::ElementProperty::scrollHeight: {
-    getDartMethod()->flushUICommand();
-    assert_m(nativeElement->getViewModuleProperty != nullptr,
-             "Failed to execute getViewModuleProperty(): dart method is nullptr.");
-    return JSValueMakeNumber(_hostClass->ctx, nativeElement->getViewModuleProperty(
-                                                nativeElement, static_cast<int64_t>(ViewModuleProperty::scrollHeight)));
+    return JSValueMakeNumber(_hostClass->ctx, getViewModuleProperty(ViewModuleProperty::scrollHeight));
   }
   case JSElement::ElementProperty::scrollWidth: {
-    getDartMethod()->flushUICommand();
-    assert_m(nativeElement->getViewModuleProperty != nullptr,
-             "Failed to execute getViewModuleProperty(): dart method is nullptr.");
-    return JSValueMakeNumber(_hostClass->ctx, nativeElement->getViewModuleProperty(
-                                                nativeElement, static_cast<int64_t>(ViewModuleProperty::scrollWidth)));
+    return JSValueMakeNumber(_hostClass->ctx, getViewModuleProperty(ViewModuleProperty::scrollWidth));
   }
   case JSElement::ElementProperty::children: {
     std::vector<JSValueRef> arguments;
-    for (auto &childNode : childNodes) {
+    for (NodeInstance *childNode = firstChild(); childNode != nullptr; childNode = childNode->nextSibling()) {
       if (childNode->nodeType == NodeType::ELEMENT_NODE) {
         arguments.emplace_back(childNode->object);
       }
@@ -326,19 +373,21 @@ bool ElementInstance::setProperty(std::string &name, JSValueRef value, JSValueRe
     case JSElement::ElementProperty::attributes:
       return false;
     case JSElement::ElementProperty::scrollTop: {
-      getDartMethod()->flushUICommand();
+      context->commandBuffer()->flushForLayout();
       assert_m(nativeElement->setViewModuleProperty != nullptr,
                "Failed to execute setScrollTop(): dart method is nullptr.");
       nativeElement->setViewModuleProperty(nativeElement, static_cast<int64_t>(ViewModuleProperty::scrollTop),
                                            JSValueToNumber(_hostClass->ctx, value, exception));
+      ::foundation::UIGeometrySnapshot::instance(_hostClass->contextId)->invalidate();
       break;
     }
     case JSElement::ElementProperty::scrollLeft: {
-      getDartMethod()->flushUICommand();
+      context->commandBuffer()->flushForLayout();
       assert_m(nativeElement->setViewModuleProperty != nullptr,
                "Failed to execute setScrollLeft(): dart method is nullptr.");
       nativeElement->setViewModuleProperty(nativeElement, static_cast<int64_t>(ViewModuleProperty::scrollLeft),
                                            JSValueToNumber(_hostClass->ctx, value, exception));
+      ::foundation::UIGeometrySnapshot::instance(_hostClass->contextId)->invalidate();
       break;
     }
     default:
@@ -365,7 +414,7 @@ void ElementInstance::getPropertyNames(JSPropertyNameAccumulatorRef accumulator)
 std::string ElementInstance::internalGetTextContent() {
   std::string buffer;
 
-  for (auto &node : childNodes) {
+  for (NodeInstance *node = firstChild(); node != nullptr; node = node->nextSibling()) {
     std::string nodeText = node->internalGetTextContent();
     buffer += nodeText;
   }
@@ -410,9 +459,9 @@ JSValueRef JSElement::setAttribute(JSContextRef ctx, JSObjectRef function, JSObj
   JSStringRef valueStringRef = JSValueToStringCopy(ctx, attributeValueRef, exception);
   NativeString args_01{};
   NativeString args_02{};
-  buildUICommandArgs(name, valueStringRef, args_01, args_02);
+  buildUICommandArgs(elementInstance->context, name, valueStringRef, args_01, args_02);
 
-  ::foundation::UICommandBuffer::instance(elementInstance->_hostClass->contextId)
+  elementInstance->context->commandBuffer()
     ->addCommand(elementInstance->eventTargetId, UICommand::setProperty, args_01, args_02, nullptr);
 
   return nullptr;
@@ -437,12 +486,7 @@ JSValueRef JSElement::getAttribute(JSContextRef ctx, JSObjectRef function, JSObj
   std::string name = JSStringToStdString(JSValueToStringCopy(ctx, nameValueRef, exception));
 
   auto attributes = *elementInstance->m_attributes;
-
-  if (attributes->hasAttribute(name)) {
-    return attributes->getAttribute(name);
-  }
-
-  return nullptr;
+  return attributes->getAttribute(name);
 }
 
 JSValueRef JSElement::hasAttribute(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argumentCount,
@@ -492,8 +536,8 @@ JSValueRef JSElement::removeAttribute(JSContextRef ctx, JSObjectRef function, JS
     element->_didModifyAttribute(name, idRef, nullptr);
 
     NativeString args_01{};
-    buildUICommandArgs(name, args_01);
-    ::foundation::UICommandBuffer::instance(element->_hostClass->contextId)
+    buildUICommandArgs(element->context, name, args_01);
+    element->context->commandBuffer()
       ->addCommand(element->eventTargetId, UICommand::removeProperty, args_01, nullptr);
   }
 
@@ -527,6 +571,8 @@ JSValueRef JSElement::toBlob(JSContextRef ctx, JSObjectRef function, JSObjectRef
   auto elementInstance = reinterpret_cast<ElementInstance *>(JSObjectGetPrivate(thisObject));
   auto context = elementInstance->context;
   getDartMethod()->flushUICommand();
+  // Pixels of canvas are read back, apply recorded draw operations first.
+  CanvasRenderingContext2D::flushDisplayLists(context);
 
   double devicePixelRatio = JSValueToNumber(ctx, devicePixelRatioValueRef, exception);
   auto bridge = static_cast<JSBridge *>(context->getOwner());
@@ -614,6 +660,7 @@ JSValueRef JSElement::scroll(JSContextRef ctx, JSObjectRef function, JSObjectRef
   getDartMethod()->flushUICommand();
   assert_m(elementInstance->nativeElement->scroll != nullptr, "Failed to execute scroll(): dart method is nullptr.");
   elementInstance->nativeElement->scroll(elementInstance->nativeElement, x, y);
+  ::foundation::UIGeometrySnapshot::instance(elementInstance->_hostClass->contextId)->invalidate();
 
   return nullptr;
 }
@@ -639,6 +686,7 @@ JSValueRef JSElement::scrollBy(JSContextRef ctx, JSObjectRef function, JSObjectR
   assert_m(elementInstance->nativeElement->scrollBy != nullptr,
            "Failed to execute scrollBy(): dart method is nullptr.");
   elementInstance->nativeElement->scrollBy(elementInstance->nativeElement, x, y);
+  ::foundation::UIGeometrySnapshot::instance(elementInstance->_hostClass->contextId)->invalidate();
 
   return nullptr;
 }
@@ -731,11 +779,11 @@ void ElementInstance::_beforeUpdateId(JSValueRef oldId, JSValueRef newId) {
 }
 
 std::string ElementInstance::getRegisteredTagName() {
-  return m_tagName.string();
+  return JSStringToStdString(m_tagName);
 }
 
 std::string ElementInstance::tagName() {
-  std::string tagName = m_tagName.string();
+  std::string tagName = JSStringToStdString(m_tagName);
   std::transform(tagName.begin(), tagName.end(), tagName.begin(), ::toupper);
   return tagName;
 }
@@ -772,7 +820,7 @@ BoundingClientRect::BoundingClientRect(JSContext *context, NativeBoundingClientR
   : HostObject(context, "BoundingClientRect"), nativeBoundingClientRect(boundingClientRect) {}
 
 JSValueRef ElementInstance::getStringValueProperty(std::string &name) {
-  getDartMethod()->flushUICommand();
+  context->commandBuffer()->flushForLayout();
   JSStringRef stringRef = JSStringCreateWithUTF8CString(name.c_str());
   NativeString *nativeString = stringRefToNativeString(stringRef);
   NativeString *returnedString = nativeElement->getStringValueProperty(nativeElement, nativeString);
@@ -845,10 +893,8 @@ void traverseNode(NodeInstance *node, TraverseHandler handler) {
   bool shouldExit = handler(node);
   if (shouldExit) return;
 
-  if (!node->childNodes.empty()) {
-    for (auto &n : node->childNodes) {
-      traverseNode(n, handler);
-    }
+  for (NodeInstance *n = node->firstChild(); n != nullptr; n = n->nextSibling()) {
+    traverseNode(n, handler);
   }
 }
 
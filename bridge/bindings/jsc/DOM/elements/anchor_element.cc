@@ -9,10 +9,9 @@ namespace kraken::binding::jsc {
 
 JSAnchorElement::JSAnchorElement(JSContext *context) : JSElement(context) {}
 
-std::unordered_map<JSContext *, JSAnchorElement *> JSAnchorElement::instanceMap {};
 
 JSAnchorElement::~JSAnchorElement() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSAnchorElement, this);
 }
 
 JSObjectRef JSAnchorElement::instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -25,8 +24,8 @@ JSAnchorElement::AnchorElementInstance::AnchorElementInstance(JSAnchorElement *j
   : ElementInstance(jsAnchorElement, "a", false), nativeAnchorElement(new NativeAnchorElement(nativeElement)) {
   std::string tagName = "a";
   NativeString args_01{};
-  buildUICommandArgs(tagName, args_01);
-  foundation::UICommandBuffer::instance(context->getContextId())
+  buildUICommandAtomArgs(context, tagName, args_01);
+  context->commandBuffer()
     ->addCommand(eventTargetId, UICommand::createElement, args_01, nativeAnchorElement);
 }
 
@@ -59,8 +58,8 @@ bool JSAnchorElement::AnchorElementInstance::setProperty(std::string &name, JSVa
 
     NativeString args_01{};
     NativeString args_02{};
-    buildUICommandArgs(name, hrefString, args_01, args_02);
-    foundation::UICommandBuffer::instance(_hostClass->contextId)
+    buildUICommandArgs(context, name, hrefString, args_01, args_02);
+    context->commandBuffer()
       ->addCommand(eventTargetId, UICommand::setProperty, args_01, args_02, nullptr);
     return true;
   } else if (property == AnchorElementProperty::target) {
@@ -69,8 +68,8 @@ bool JSAnchorElement::AnchorElementInstance::setProperty(std::string &name, JSVa
 
     NativeString args_01{};
     NativeString args_02{};
-    buildUICommandArgs(name, _target, args_01, args_02);
-    foundation::UICommandBuffer::instance(_hostClass->contextId)
+    buildUICommandArgs(context, name, _target, args_01, args_02);
+    context->commandBuffer()
       ->addCommand(eventTargetId, UICommand::setProperty, args_01, args_02, nullptr);
     return true;
   }
@@ -87,7 +86,7 @@ void JSAnchorElement::AnchorElementInstance::getPropertyNames(JSPropertyNameAccu
 }
 
 JSAnchorElement::AnchorElementInstance::~AnchorElementInstance() {
-  ::foundation::UICommandCallbackQueue::instance()->registerCallback([](void *ptr) {
+  context->commandBuffer()->registerCallback([](void *ptr) {
     delete reinterpret_cast<NativeAnchorElement *>(ptr);
   }, nativeAnchorElement);
   if (_target != nullptr) JSStringRelease(_target);
@@ -38,7 +38,6 @@ public:
 protected:
   JSAnchorElement() = delete;
   ~JSAnchorElement();
-  static std::unordered_map<JSContext *, JSAnchorElement *> instanceMap;
   explicit JSAnchorElement(JSContext *context);
 };
 
@@ -4,14 +4,17 @@
  */
 
 #include "canvas_element.h"
-#include "image_element.h"
+#include "bridge_jsc.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 
 namespace kraken::binding::jsc {
 
-std::unordered_map<JSContext *, JSCanvasElement *> JSCanvasElement::instanceMap{};
 
 JSCanvasElement::~JSCanvasElement() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSCanvasElement, this);
 }
 
 JSCanvasElement::JSCanvasElement(JSContext *context) : JSElement(context) {}
@@ -27,24 +30,24 @@ JSCanvasElement::CanvasElementInstance::CanvasElementInstance(JSCanvasElement *j
 
   std::string tagName = "canvas";
   NativeString args_01{};
-  buildUICommandArgs(tagName, args_01);
+  buildUICommandAtomArgs(context, tagName, args_01);
 
-  foundation::UICommandBuffer::instance(context->getContextId())
+  context->commandBuffer()
     ->addCommand(eventTargetId, UICommand::createElement, args_01, nativeCanvasElement);
+  commandBatch = context->commandBuffer()->batchSequence();
 }
 
 JSCanvasElement::CanvasElementInstance::~CanvasElementInstance() {
-  ::foundation::UICommandCallbackQueue::instance()->registerCallback(
+  context->commandBuffer()->registerCallback(
     [](void *ptr) { delete reinterpret_cast<NativeCanvasElement *>(ptr); }, nativeCanvasElement);
 }
 
 JSValueRef JSCanvasElement::CanvasElementInstance::getProperty(std::string &name, JSValueRef *exception) {
   auto &propertyMap = getCanvasElementPropertyMap();
   auto &prototypePropertyMap = getCanvasElementPrototypePropertyMap();
-  JSStringHolder nameStringHolder = JSStringHolder(context, name);
 
   if (prototypePropertyMap.count(name) > 0) {
-    return JSObjectGetProperty(ctx, prototype<JSCanvasElement>()->prototypeObject, nameStringHolder.getString(), exception);
+    return JSObjectGetProperty(ctx, prototype<JSCanvasElement>()->prototypeObject, context->atom(name), exception);
   };
 
   if (propertyMap.count(name) > 0) {
@@ -74,29 +77,34 @@ bool JSCanvasElement::CanvasElementInstance::setProperty(std::string &name, JSVa
     switch (property) {
     case CanvasElementProperty::width: {
       _width = JSValueToNumber(_hostClass->ctx, value, exception);
+      // Resizing clears the canvas, draw operations before it must be applied first.
+      CanvasRenderingContext2D::flushDisplayLists(context);
 
       std::string widthString = std::to_string(_width);
 
       NativeString args_01{};
       NativeString args_02{};
 
-      buildUICommandArgs(name, widthString, args_01, args_02);
+      buildUICommandArgs(context, name, widthString, args_01, args_02);
 
-      foundation::UICommandBuffer::instance(_hostClass->contextId)
+      context->commandBuffer()
         ->addCommand(eventTargetId, UICommand::setProperty, args_01, args_02, nullptr);
+      commandBatch = context->commandBuffer()->batchSequence();
       break;
     }
     case CanvasElementProperty::height: {
       _height = JSValueToNumber(_hostClass->ctx, value, exception);
+      CanvasRenderingContext2D::flushDisplayLists(context);
 
       std::string heightString = std::to_string(_height);
 
       NativeString args_01{};
       NativeString args_02{};
 
-      buildUICommandArgs(name, heightString, args_01, args_02);
-      foundation::UICommandBuffer::instance(_hostClass->contextId)
+      buildUICommandArgs(context, name, heightString, args_01, args_02);
+      context->commandBuffer()
         ->addCommand(eventTargetId, UICommand::setProperty, args_01, args_02, nullptr);
+      commandBatch = context->commandBuffer()->batchSequence();
       break;
     }
     default:
@@ -146,32 +154,227 @@ JSValueRef JSCanvasElement::getContext(JSContextRef ctx, JSObjectRef function,
     elementInstance->nativeCanvasElement->getContext(elementInstance->nativeCanvasElement, &contextId);
   auto canvasRenderContext2d = CanvasRenderingContext2D::instance(elementInstance->context);
   auto canvasRenderContext2dInstance = new CanvasRenderingContext2D::CanvasRenderingContext2DInstance(
-    canvasRenderContext2d, nativeCanvasRenderingContext2D);
+    canvasRenderContext2d, elementInstance, nativeCanvasRenderingContext2D);
   return canvasRenderContext2dInstance->object;
 }
 
-std::unordered_map<JSContext *, CanvasRenderingContext2D *> CanvasRenderingContext2D::instanceMap{};
+namespace {
+
+// Rect of getImageData is rounded to int on dart side, and its pixels are allocated at once.
+constexpr double MAX_IMAGE_DATA_COORDINATE = 2147483647.0;
+constexpr double MAX_IMAGE_DATA_PIXELS = 8192.0 * 8192.0;
+
+// Argument count of each CanvasDisplayListOp.
+constexpr int32_t canvasDisplayListArgumentCount[] = {
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // setDirection ... setTextBaseline
+  6,                                // arc
+  5,                                // arcTo
+  0,                                // beginPath
+  6,                                // bezierCurveTo
+  4,                                // clearRect
+  1,                                // clip
+  0,                                // closePath
+  10,                               // drawImage
+  8,                                // ellipse
+  1,                                // fill
+  4,                                // fillRect
+  4,                                // fillText
+  2,                                // lineTo
+  2,                                // moveTo
+  4,                                // quadraticCurveTo
+  4,                                // rect
+  0,                                // restore
+  1,                                // rotate
+  0,                                // resetTransform
+  0,                                // save
+  2,                                // scale
+  0,                                // stroke
+  4,                                // strokeRect
+  4,                                // strokeText
+  6,                                // setTransform
+  6,                                // transform
+  2,                                // translate
+  2,                                // pathSegments
+};
+
+static_assert(sizeof(canvasDisplayListArgumentCount) / sizeof(int32_t) ==
+                static_cast<size_t>(CanvasDisplayListOp::pathSegments) + 1,
+              "Argument count of canvas display list op is missing.");
+
+// Point count of each CanvasPathVerb.
+constexpr int32_t canvasPathVerbPointCount[] = {
+  2, // moveTo
+  2, // lineTo
+  4, // quadraticCurveTo
+  6, // bezierCurveTo
+  0, // closePath
+};
+
+// Display list of a context which had been finalized by GC, submitted before the native context is released.
+struct PendingCanvasDisplayList {
+  NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D;
+  std::unique_ptr<CanvasDisplayList> displayList;
+};
+
+} // namespace
+
+void CanvasDisplayList::record(CanvasDisplayListOp op, std::initializer_list<double> arguments) {
+  assert_m(arguments.size() == static_cast<size_t>(canvasDisplayListArgumentCount[static_cast<int32_t>(op)]),
+           "Failed to record canvas operation: argument count mismatch.");
+  m_ops.emplace_back(static_cast<double>(op));
+  m_ops.insert(m_ops.end(), arguments);
+}
+
+double CanvasDisplayList::recordString(const NativeString &string) {
+  m_strings.emplace_back(NativeString{m_stringArena.copy(string.string, string.length), string.length});
+  return static_cast<double>(m_strings.size() - 1);
+}
+
+double CanvasDisplayList::recordPointer(void *ptr) {
+  auto bits = static_cast<int64_t>(reinterpret_cast<intptr_t>(ptr));
+  double value;
+  memcpy(&value, &bits, sizeof(double));
+  return value;
+}
+
+double CanvasDisplayList::recordFloats(const float *floats, size_t length) {
+  size_t offset = m_floats.size();
+  m_floats.insert(m_floats.end(), floats, floats + length);
+  return static_cast<double>(offset);
+}
+
+NativeCanvasDisplayList *CanvasDisplayList::nativeDisplayList() {
+  m_nativeDisplayList.ops = m_ops.data();
+  m_nativeDisplayList.length = m_ops.size();
+  m_nativeDisplayList.strings = m_strings.data();
+  m_nativeDisplayList.stringsLength = m_strings.size();
+  m_nativeDisplayList.floats = m_floats.data();
+  m_nativeDisplayList.floatsLength = m_floats.size();
+  return &m_nativeDisplayList;
+}
+
+void CanvasDisplayList::reset() {
+  m_ops.clear();
+  m_strings.clear();
+  m_floats.clear();
+  m_stringArena.reset();
+}
+
+bool CanvasRenderingContext2D::recordingEnabled{true};
 
 CanvasRenderingContext2D::CanvasRenderingContext2D(JSContext *context)
   : HostClass(context, "CanvasRenderingContext2D") {}
 
+CanvasRenderingContext2D::~CanvasRenderingContext2D() {
+  context->bindingState().removeHostClass(BindingSlot::CanvasRenderingContext2D, this);
+}
+
+void CanvasRenderingContext2D::flushDisplayLists(JSContext *context) {
+  auto canvasRenderingContext2D =
+    context->bindingState().hostClass<CanvasRenderingContext2D>(BindingSlot::CanvasRenderingContext2D);
+  if (canvasRenderingContext2D == nullptr) return;
+
+  std::unordered_set<CanvasRenderingContext2DInstance *> instances;
+  instances.swap(canvasRenderingContext2D->m_recordingInstances);
+  for (auto &instance : instances) {
+    instance->submit();
+  }
+}
+
 CanvasRenderingContext2D::CanvasRenderingContext2DInstance::CanvasRenderingContext2DInstance(
-  CanvasRenderingContext2D *canvasRenderContext2D, NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D)
-  : Instance(canvasRenderContext2D), nativeCanvasRenderingContext2D(nativeCanvasRenderingContext2D) {}
+  CanvasRenderingContext2D *canvasRenderContext2D, JSCanvasElement::CanvasElementInstance *canvasElementInstance,
+  NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D)
+  : Instance(canvasRenderContext2D), nativeCanvasRenderingContext2D(nativeCanvasRenderingContext2D),
+    m_canvasElementInstance(canvasElementInstance), m_canvasElement(context, canvasElementInstance->object) {}
 
 CanvasRenderingContext2D::CanvasRenderingContext2DInstance::~CanvasRenderingContext2DInstance() {
-  ::foundation::UICommandCallbackQueue::instance()->registerCallback(
-    [](void *ptr) { delete reinterpret_cast<NativeCanvasRenderingContext2D *>(ptr); }, nativeCanvasRenderingContext2D);
+  if (context->bindingState().hostClass<CanvasRenderingContext2D>(BindingSlot::CanvasRenderingContext2D) != nullptr) {
+    prototype<CanvasRenderingContext2D>()->m_recordingInstances.erase(this);
+  }
+  // Images finalized after this are released after the pending display list below has been submitted.
+  releaseImages();
+
+  if (displayList->empty()) {
+    context->commandBuffer()->registerCallback(
+      [](void *ptr) { delete reinterpret_cast<NativeCanvasRenderingContext2D *>(ptr); }, nativeCanvasRenderingContext2D);
+    return;
+  }
+
+  // Calling dart side is not allowed during GC, draw operations of this frame are submitted with the release.
+  auto pendingDisplayList = new PendingCanvasDisplayList{nativeCanvasRenderingContext2D, std::move(displayList)};
+  context->commandBuffer()->registerCallback(
+    [](void *ptr) {
+      auto pendingDisplayList = reinterpret_cast<PendingCanvasDisplayList *>(ptr);
+      auto nativeCanvasRenderingContext2D = pendingDisplayList->nativeCanvasRenderingContext2D;
+      if (nativeCanvasRenderingContext2D->submitDisplayList != nullptr) {
+        nativeCanvasRenderingContext2D->submitDisplayList(nativeCanvasRenderingContext2D,
+                                                          pendingDisplayList->displayList->nativeDisplayList());
+      }
+      delete nativeCanvasRenderingContext2D;
+      delete pendingDisplayList;
+    },
+    pendingDisplayList);
+}
+
+void CanvasRenderingContext2D::CanvasRenderingContext2DInstance::record(CanvasDisplayListOp op,
+                                                                        std::initializer_list<double> arguments) {
+  bool scheduled = !displayList->empty();
+  displayList->record(op, arguments);
+
+  if (!CanvasRenderingContext2D::recordingEnabled) {
+    submit();
+    return;
+  }
+
+  if (scheduled) return;
+  prototype<CanvasRenderingContext2D>()->m_recordingInstances.emplace(this);
+  // Make sure there is a frame to submit the display list.
+  if (getDartMethod()->requestBatchUpdate != nullptr) {
+    getDartMethod()->requestBatchUpdate(contextId);
+  }
+}
+
+void CanvasRenderingContext2D::CanvasRenderingContext2DInstance::recordImage(
+  JSImageElement::ImageElementInstance *imageElementInstance) {
+  JSValueProtect(ctx, imageElementInstance->object);
+  m_images.emplace_back(imageElementInstance->object);
+  m_dependentBatch = std::max(m_dependentBatch, imageElementInstance->commandBatch);
+}
+
+void CanvasRenderingContext2D::CanvasRenderingContext2DInstance::releaseImages() {
+  if (context->isValid()) {
+    for (auto &image : m_images) {
+      JSValueUnprotect(ctx, image);
+    }
+  }
+  m_images.clear();
+}
+
+void CanvasRenderingContext2D::CanvasRenderingContext2DInstance::submit() {
+  if (displayList->empty()) return;
+
+  // Draw operations can not be applied before the canvas and images they use are created or resized by dart side,
+  // other pending ui commands are left to the next frame.
+  int64_t dependentBatch = std::max(m_dependentBatch, m_canvasElementInstance->commandBatch);
+  if (!context->commandBuffer()->isBatchApplied(dependentBatch)) {
+    getDartMethod()->flushContextUICommand(contextId);
+  }
+
+  assert_m(nativeCanvasRenderingContext2D->submitDisplayList != nullptr,
+           "Failed to submit canvas display list: dart method is nullptr.");
+  nativeCanvasRenderingContext2D->submitDisplayList(nativeCanvasRenderingContext2D, displayList->nativeDisplayList());
+  displayList->reset();
+  releaseImages();
+  m_dependentBatch = 0;
 }
 
 JSValueRef CanvasRenderingContext2D::CanvasRenderingContext2DInstance::getProperty(std::string &name,
                                                                                    JSValueRef *exception) {
   auto &propertyMap = getCanvasRenderingContext2DPropertyMap();
   auto &prototypePropertyMap = getCanvasRenderingContext2DPrototypePropertyMap();
-  JSStringHolder nameStringHolder = JSStringHolder(context, name);
 
   if (prototypePropertyMap.count(name) > 0) {
-    return JSObjectGetProperty(ctx, prototype<CanvasRenderingContext2D>()->prototypeObject, nameStringHolder.getString(), exception);
+    return JSObjectGetProperty(ctx, prototype<CanvasRenderingContext2D>()->prototypeObject, context->atom(name), exception);
   }
 
   if (propertyMap.count(name) > 0) {
@@ -218,19 +421,16 @@ JSValueRef CanvasRenderingContext2D::CanvasRenderingContext2DInstance::getProper
 
 bool CanvasRenderingContext2D::CanvasRenderingContext2DInstance::setProperty(std::string &name, JSValueRef value,
                                                                              JSValueRef *exception) {
-  auto propertyMap = getCanvasRenderingContext2DPropertyMap();
-  auto prototypePropertyMap = getCanvasRenderingContext2DPrototypePropertyMap();
-  JSStringHolder nameStringHolder = JSStringHolder(context, name);
+  auto &propertyMap = getCanvasRenderingContext2DPropertyMap();
+  auto &prototypePropertyMap = getCanvasRenderingContext2DPrototypePropertyMap();
 
   if (prototypePropertyMap.count(name) > 0) {
-    return JSObjectGetProperty(ctx, prototype<CanvasRenderingContext2D>()->prototypeObject, nameStringHolder.getString(), exception);
+    return JSObjectGetProperty(ctx, prototype<CanvasRenderingContext2D>()->prototypeObject, context->atom(name), exception);
   }
 
   if (propertyMap.count(name) > 0) {
     auto property = propertyMap[name];
 
-    getDartMethod()->flushUICommand();
-
     switch (property) {
     case CanvasRenderingContext2DProperty::direction: {
       JSStringRef direction = JSValueToStringCopy(_hostClass->ctx, value, exception);
@@ -239,9 +439,7 @@ bool CanvasRenderingContext2D::CanvasRenderingContext2DInstance::setProperty(std
       NativeString nativeDirection{};
       nativeDirection.string = m_direction.ptr();
       nativeDirection.length = m_direction.size();
-      assert_m(nativeCanvasRenderingContext2D->setDirection != nullptr,
-               "Failed to execute setDirection(): dart method is nullptr.");
-      nativeCanvasRenderingContext2D->setDirection(nativeCanvasRenderingContext2D, &nativeDirection);
+      record(CanvasDisplayListOp::setDirection, {displayList->recordString(nativeDirection)});
       break;
     }
     case CanvasRenderingContext2DProperty::font: {
@@ -251,9 +449,7 @@ bool CanvasRenderingContext2D::CanvasRenderingContext2DInstance::setProperty(std
       NativeString nativeFont{};
       nativeFont.string = m_font.ptr();
       nativeFont.length = m_font.size();
-      assert_m(nativeCanvasRenderingContext2D->setFont != nullptr,
-               "Failed to execute setFont(): dart method is nullptr.");
-      nativeCanvasRenderingContext2D->setFont(nativeCanvasRenderingContext2D, &nativeFont);
+      record(CanvasDisplayListOp::setFont, {displayList->recordString(nativeFont)});
       break;
     }
     case CanvasRenderingContext2DProperty::fillStyle: {
@@ -263,9 +459,7 @@ bool CanvasRenderingContext2D::CanvasRenderingContext2DInstance::setProperty(std
       NativeString nativeFillStyle{};
       nativeFillStyle.string = m_fillStyle.ptr();
       nativeFillStyle.length = m_fillStyle.size();
-      assert_m(nativeCanvasRenderingContext2D->setFillStyle != nullptr,
-               "Failed to execute setFillStyle(): dart method is nullptr.");
-      nativeCanvasRenderingContext2D->setFillStyle(nativeCanvasRenderingContext2D, &nativeFillStyle);
+      record(CanvasDisplayListOp::setFillStyle, {displayList->recordString(nativeFillStyle)});
       break;
     }
     case CanvasRenderingContext2DProperty::strokeStyle: {
@@ -275,9 +469,7 @@ bool CanvasRenderingContext2D::CanvasRenderingContext2DInstance::setProperty(std
       NativeString nativeStrokeStyle{};
       nativeStrokeStyle.string = m_strokeStyle.ptr();
       nativeStrokeStyle.length = m_strokeStyle.size();
-      assert_m(nativeCanvasRenderingContext2D->setStrokeStyle != nullptr,
-               "Failed to execute setStrokeStyle(): dart method is nullptr.");
-      nativeCanvasRenderingContext2D->setStrokeStyle(nativeCanvasRenderingContext2D, &nativeStrokeStyle);
+      record(CanvasDisplayListOp::setStrokeStyle, {displayList->recordString(nativeStrokeStyle)});
       break;
     }
     case CanvasRenderingContext2DProperty::lineCap: {
@@ -287,9 +479,7 @@ bool CanvasRenderingContext2D::CanvasRenderingContext2DInstance::setProperty(std
       NativeString nativeLineCap{};
       nativeLineCap.string = m_lineCap.ptr();
       nativeLineCap.length = m_lineCap.size();
-      assert_m(nativeCanvasRenderingContext2D->setLineCap != nullptr,
-               "Failed to execute setLineCap(): dart method is nullptr.");
-      nativeCanvasRenderingContext2D->setLineCap(nativeCanvasRenderingContext2D, &nativeLineCap);
+      record(CanvasDisplayListOp::setLineCap, {displayList->recordString(nativeLineCap)});
       break;
     }
     case CanvasRenderingContext2DProperty::lineDashOffset: {
@@ -299,9 +489,7 @@ bool CanvasRenderingContext2D::CanvasRenderingContext2DInstance::setProperty(std
       NativeString nativeLineDashOffset{};
       nativeLineDashOffset.string = m_lineDashOffset.ptr();
       nativeLineDashOffset.length = m_lineDashOffset.size();
-      assert_m(nativeCanvasRenderingContext2D->setLineDashOffset != nullptr,
-               "Failed to execute setLineDashOffset(): dart method is nullptr.");
-      nativeCanvasRenderingContext2D->setLineDashOffset(nativeCanvasRenderingContext2D, &nativeLineDashOffset);
+      record(CanvasDisplayListOp::setLineDashOffset, {displayList->recordString(nativeLineDashOffset)});
       break;
     }
     case CanvasRenderingContext2DProperty::lineJoin: {
@@ -311,9 +499,7 @@ bool CanvasRenderingContext2D::CanvasRenderingContext2DInstance::setProperty(std
       NativeString nativeLineJoin{};
       nativeLineJoin.string = m_lineJoin.ptr();
       nativeLineJoin.length = m_lineJoin.size();
-      assert_m(nativeCanvasRenderingContext2D->setLineJoin != nullptr,
-               "Failed to execute setLineJoin(): dart method is nullptr.");
-      nativeCanvasRenderingContext2D->setLineJoin(nativeCanvasRenderingContext2D, &nativeLineJoin);
+      record(CanvasDisplayListOp::setLineJoin, {displayList->recordString(nativeLineJoin)});
       break;
     }
     case CanvasRenderingContext2DProperty::lineWidth: {
@@ -323,9 +509,7 @@ bool CanvasRenderingContext2D::CanvasRenderingContext2DInstance::setProperty(std
       NativeString nativeLineWidth{};
       nativeLineWidth.string = m_lineWidth.ptr();
       nativeLineWidth.length = m_lineWidth.size();
-      assert_m(nativeCanvasRenderingContext2D->setLineWidth != nullptr,
-               "Failed to execute setLineWidth(): dart method is nullptr.");
-      nativeCanvasRenderingContext2D->setLineWidth(nativeCanvasRenderingContext2D, &nativeLineWidth);
+      record(CanvasDisplayListOp::setLineWidth, {displayList->recordString(nativeLineWidth)});
       break;
     }
     case CanvasRenderingContext2DProperty::miterLimit: {
@@ -335,9 +519,7 @@ bool CanvasRenderingContext2D::CanvasRenderingContext2DInstance::setProperty(std
       NativeString nativeMiterLimit{};
       nativeMiterLimit.string = m_miterLimit.ptr();
       nativeMiterLimit.length = m_miterLimit.size();
-      assert_m(nativeCanvasRenderingContext2D->setMiterLimit != nullptr,
-               "Failed to execute setMiterLimit(): dart method is nullptr.");
-      nativeCanvasRenderingContext2D->setMiterLimit(nativeCanvasRenderingContext2D, &nativeMiterLimit);
+      record(CanvasDisplayListOp::setMiterLimit, {displayList->recordString(nativeMiterLimit)});
       break;
     }
     case CanvasRenderingContext2DProperty::textAlign: {
@@ -347,9 +529,7 @@ bool CanvasRenderingContext2D::CanvasRenderingContext2DInstance::setProperty(std
       NativeString nativeTextAlign{};
       nativeTextAlign.string = m_textAlign.ptr();
       nativeTextAlign.length = m_textAlign.size();
-      assert_m(nativeCanvasRenderingContext2D->setTextAlign != nullptr,
-               "Failed to execute setTextAlign(): dart method is nullptr.");
-      nativeCanvasRenderingContext2D->setTextAlign(nativeCanvasRenderingContext2D, &nativeTextAlign);
+      record(CanvasDisplayListOp::setTextAlign, {displayList->recordString(nativeTextAlign)});
       break;
     }
     case CanvasRenderingContext2DProperty::textBaseline: {
@@ -359,9 +539,7 @@ bool CanvasRenderingContext2D::CanvasRenderingContext2DInstance::setProperty(std
       NativeString nativeTextBaseline{};
       nativeTextBaseline.string = m_textBaseline.ptr();
       nativeTextBaseline.length = m_textBaseline.size();
-      assert_m(nativeCanvasRenderingContext2D->setTextBaseline != nullptr,
-               "Failed to execute setTextBaseline(): dart method is nullptr.");
-      nativeCanvasRenderingContext2D->setTextBaseline(nativeCanvasRenderingContext2D, &nativeTextBaseline);
+      record(CanvasDisplayListOp::setTextBaseline, {displayList->recordString(nativeTextBaseline)});
       break;
     }
     default:
@@ -402,10 +580,7 @@ JSValueRef CanvasRenderingContext2D::arc(JSContextRef ctx, JSObjectRef function,
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->arc != nullptr,
-           "Failed to execute arc(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->arc(instance->nativeCanvasRenderingContext2D, x, y, radius, startAngle, endAngle, counterclockwise ? 1 : 0);
+  instance->record(CanvasDisplayListOp::arc, {x, y, radius, startAngle, endAngle, counterclockwise ? 1.0 : 0.0});
   return nullptr;
 }
 
@@ -432,10 +607,7 @@ JSValueRef CanvasRenderingContext2D::arcTo(JSContextRef ctx, JSObjectRef functio
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->arcTo != nullptr,
-           "Failed to execute arcTo(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->arcTo(instance->nativeCanvasRenderingContext2D, x1, y1, x2, y2, radius);
+  instance->record(CanvasDisplayListOp::arcTo, {x1, y1, x2, y2, radius});
   return nullptr;
 }
 
@@ -447,10 +619,7 @@ JSValueRef CanvasRenderingContext2D::beginPath(JSContextRef ctx, JSObjectRef fun
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->beginPath != nullptr,
-           "Failed to execute beginPath(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->beginPath(instance->nativeCanvasRenderingContext2D);
+  instance->record(CanvasDisplayListOp::beginPath, {});
   return nullptr;
 }
 
@@ -477,10 +646,7 @@ JSValueRef CanvasRenderingContext2D::bezierCurveTo(JSContextRef ctx, JSObjectRef
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->bezierCurveTo != nullptr,
-           "Failed to execute bezierCurveTo(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->bezierCurveTo(instance->nativeCanvasRenderingContext2D, cp1x, cp1y, cp2x, cp2y, x, y);
+  instance->record(CanvasDisplayListOp::bezierCurveTo, {cp1x, cp1y, cp2x, cp2y, x, y});
   return nullptr;
 }
 
@@ -492,10 +658,7 @@ JSValueRef CanvasRenderingContext2D::closePath(JSContextRef ctx, JSObjectRef fun
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->closePath != nullptr,
-           "Failed to execute closePath(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->closePath(instance->nativeCanvasRenderingContext2D);
+  instance->record(CanvasDisplayListOp::closePath, {});
   return nullptr;
 }
 
@@ -522,10 +685,7 @@ JSValueRef CanvasRenderingContext2D::clip(JSContextRef ctx, JSObjectRef function
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->clip != nullptr,
-           "Failed to execute clip(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->clip(instance->nativeCanvasRenderingContext2D, &fillRuleNativeString);
+  instance->record(CanvasDisplayListOp::clip, {instance->displayList->recordString(fillRuleNativeString)});
   return nullptr;
 }
 
@@ -567,13 +727,10 @@ JSValueRef CanvasRenderingContext2D::drawImage(JSContextRef ctx, JSObjectRef fun
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->drawImage != nullptr,
-           "Failed to execute drawImage(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->drawImage(instance->nativeCanvasRenderingContext2D,
-                                                      argumentCount,
-                                                      imageInstance->nativeImageElement,
-                                                      sx, sy, sWidth, sHeight, dx, dy, dWidth, dHeight);
+  double image = instance->displayList->recordPointer(imageInstance->nativeImageElement);
+  instance->recordImage(imageInstance);
+  instance->record(CanvasDisplayListOp::drawImage,
+                   {static_cast<double>(argumentCount), image, sx, sy, sWidth, sHeight, dx, dy, dWidth, dHeight});
   return nullptr;
 }
 
@@ -608,10 +765,8 @@ JSValueRef CanvasRenderingContext2D::ellipse(JSContextRef ctx, JSObjectRef funct
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->ellipse != nullptr,
-           "Failed to execute ellipse(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->ellipse(instance->nativeCanvasRenderingContext2D, x, y, radiusX, radiusY, rotation, startAngle, endAngle, counterclockwise ? 1 : 0);
+  instance->record(CanvasDisplayListOp::ellipse,
+                   {x, y, radiusX, radiusY, rotation, startAngle, endAngle, counterclockwise ? 1.0 : 0.0});
   return nullptr;
 }
 
@@ -639,10 +794,7 @@ JSValueRef CanvasRenderingContext2D::fill(JSContextRef ctx, JSObjectRef function
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->fill != nullptr,
-           "Failed to execute fill(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->fill(instance->nativeCanvasRenderingContext2D, &fillRuleNativeString);
+  instance->record(CanvasDisplayListOp::fill, {instance->displayList->recordString(fillRuleNativeString)});
   return nullptr;
 }
 
@@ -665,10 +817,7 @@ JSValueRef CanvasRenderingContext2D::translate(JSContextRef ctx, JSObjectRef fun
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->translate != nullptr,
-           "Failed to execute translate(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->translate(instance->nativeCanvasRenderingContext2D, x, y);
+  instance->record(CanvasDisplayListOp::translate, {x, y});
   return nullptr;
 }
 
@@ -693,10 +842,7 @@ JSValueRef CanvasRenderingContext2D::fillRect(JSContextRef ctx, JSObjectRef func
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->fillRect != nullptr,
-           "Failed to execute fillRect(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->fillRect(instance->nativeCanvasRenderingContext2D, x, y, width, height);
+  instance->record(CanvasDisplayListOp::fillRect, {x, y, width, height});
   return nullptr;
 }
 
@@ -722,10 +868,7 @@ JSValueRef CanvasRenderingContext2D::rect(JSContextRef ctx, JSObjectRef function
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->rect != nullptr,
-           "Failed to execute rect(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->rect(instance->nativeCanvasRenderingContext2D, x, y, width, height);
+  instance->record(CanvasDisplayListOp::rect, {x, y, width, height});
   return nullptr;
 }
 
@@ -748,10 +891,7 @@ JSValueRef CanvasRenderingContext2D::rotate(JSContextRef ctx, JSObjectRef functi
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->rotate != nullptr,
-           "Failed to execute rotate(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->rotate(instance->nativeCanvasRenderingContext2D, angle);
+  instance->record(CanvasDisplayListOp::rotate, {angle});
   return nullptr;
 }
 
@@ -777,10 +917,7 @@ JSValueRef CanvasRenderingContext2D::clearRect(JSContextRef ctx, JSObjectRef fun
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->clearRect != nullptr,
-           "Failed to execute clearRect(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->clearRect(instance->nativeCanvasRenderingContext2D, x, y, width, height);
+  instance->record(CanvasDisplayListOp::clearRect, {x, y, width, height});
 
   return nullptr;
 }
@@ -804,10 +941,7 @@ JSValueRef CanvasRenderingContext2D::strokeRect(
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->strokeRect != nullptr,
-           "Failed to execute strokeRect(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->strokeRect(instance->nativeCanvasRenderingContext2D, x, y, width, height);
+  instance->record(CanvasDisplayListOp::strokeRect, {x, y, width, height});
 
   return nullptr;
 }
@@ -842,10 +976,7 @@ JSValueRef CanvasRenderingContext2D::fillText(JSContextRef ctx, JSObjectRef func
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->fillText != nullptr,
-           "Failed to execute fillText(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->fillText(instance->nativeCanvasRenderingContext2D, &text, x, y, maxWidth);
+  instance->record(CanvasDisplayListOp::fillText, {instance->displayList->recordString(text), x, y, maxWidth});
   return nullptr;
 }
 
@@ -868,10 +999,7 @@ JSValueRef CanvasRenderingContext2D::lineTo(JSContextRef ctx, JSObjectRef functi
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->lineTo != nullptr,
-           "Failed to execute lineTo(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->lineTo(instance->nativeCanvasRenderingContext2D, x, y);
+  instance->record(CanvasDisplayListOp::lineTo, {x, y});
   return nullptr;
 }
 
@@ -894,10 +1022,7 @@ JSValueRef CanvasRenderingContext2D::moveTo(JSContextRef ctx, JSObjectRef functi
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->moveTo != nullptr,
-           "Failed to execute moveTo(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->moveTo(instance->nativeCanvasRenderingContext2D, x, y);
+  instance->record(CanvasDisplayListOp::moveTo, {x, y});
   return nullptr;
 }
 
@@ -920,10 +1045,7 @@ JSValueRef CanvasRenderingContext2D::quadraticCurveTo(
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->quadraticCurveTo != nullptr,
-           "Failed to execute quadraticCurveTo(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->quadraticCurveTo(instance->nativeCanvasRenderingContext2D, cpx, cpy, x, y);
+  instance->record(CanvasDisplayListOp::quadraticCurveTo, {cpx, cpy, x, y});
 
   return nullptr;
 }
@@ -956,10 +1078,7 @@ JSValueRef CanvasRenderingContext2D::strokeText(
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->strokeText != nullptr,
-           "Failed to execute strokeText(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->strokeText(instance->nativeCanvasRenderingContext2D, &text, x, y, maxWidth);
+  instance->record(CanvasDisplayListOp::strokeText, {instance->displayList->recordString(text), x, y, maxWidth});
   return nullptr;
 }
 
@@ -970,10 +1089,7 @@ JSValueRef CanvasRenderingContext2D::save(JSContextRef ctx, JSObjectRef function
                                           JSValueRef *exception) {
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->save != nullptr,
-           "Failed to execute save(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->save(instance->nativeCanvasRenderingContext2D);
+  instance->record(CanvasDisplayListOp::save, {});
   return nullptr;
 }
 
@@ -985,10 +1101,7 @@ JSValueRef CanvasRenderingContext2D::stroke(JSContextRef ctx, JSObjectRef functi
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->stroke != nullptr,
-           "Failed to execute stroke(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->stroke(instance->nativeCanvasRenderingContext2D);
+  instance->record(CanvasDisplayListOp::stroke, {});
   return nullptr;
 }
 
@@ -1012,10 +1125,7 @@ JSValueRef CanvasRenderingContext2D::scale(JSContextRef ctx, JSObjectRef functio
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->scale != nullptr,
-           "Failed to execute scale(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->scale(instance->nativeCanvasRenderingContext2D, x, y);
+  instance->record(CanvasDisplayListOp::scale, {x, y});
   return nullptr;
 }
 
@@ -1027,10 +1137,7 @@ JSValueRef CanvasRenderingContext2D::restore(JSContextRef ctx, JSObjectRef funct
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->restore != nullptr,
-           "Failed to execute restore(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->restore(instance->nativeCanvasRenderingContext2D);
+  instance->record(CanvasDisplayListOp::restore, {});
   return nullptr;
 }
 
@@ -1042,10 +1149,7 @@ JSValueRef CanvasRenderingContext2D::resetTransform(JSContextRef ctx, JSObjectRe
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->resetTransform != nullptr,
-           "Failed to execute resetTransform(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->resetTransform(instance->nativeCanvasRenderingContext2D);
+  instance->record(CanvasDisplayListOp::resetTransform, {});
   return nullptr;
 }
 
@@ -1072,10 +1176,7 @@ JSValueRef CanvasRenderingContext2D::setTransform(JSContextRef ctx, JSObjectRef
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->setTransform != nullptr,
-           "Failed to execute setTransform(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->setTransform(instance->nativeCanvasRenderingContext2D, a, b, c, d, e, f);
+  instance->record(CanvasDisplayListOp::setTransform, {a, b, c, d, e, f});
   return nullptr;
 }
 
@@ -1102,10 +1203,257 @@ JSValueRef CanvasRenderingContext2D::transform(JSContextRef ctx, JSObjectRef fun
   auto instance =
     reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
 
-  getDartMethod()->flushUICommand();
-  assert_m(instance->nativeCanvasRenderingContext2D->transform != nullptr,
-           "Failed to execute transform(): dart method is nullptr.");
-  instance->nativeCanvasRenderingContext2D->transform(instance->nativeCanvasRenderingContext2D, a, b, c, d, e, f);
+  instance->record(CanvasDisplayListOp::transform, {a, b, c, d, e, f});
+  return nullptr;
+}
+
+struct ImageDataPromiseContext {
+  ImageDataPromiseContext() = delete;
+  ImageDataPromiseContext(JSBridge *bridge, JSContext *context,
+                          NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double sx, double sy,
+                          double sw, double sh)
+    : bridge(bridge), context(context), nativeCanvasRenderingContext2D(nativeCanvasRenderingContext2D), sx(sx), sy(sy),
+      sw(sw), sh(sh){};
+  JSBridge *bridge;
+  JSContext *context;
+  NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D;
+  double sx;
+  double sy;
+  double sw;
+  double sh;
+};
+
+// https://developer.mozilla.org/en-US/docs/Web/API/CanvasRenderingContext2D/getImageData
+// dart:ui reads pixels back only asynchronously, so getImageData returns a Promise of the ImageData instead of
+// returning pixels which miss the operations not yet rasterized. The ImageData covers every operation submitted
+// before the call.
+JSValueRef CanvasRenderingContext2D::getImageData(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+                                                  size_t argumentCount, const JSValueRef *arguments,
+                                                  JSValueRef *exception) {
+  if (argumentCount != 4) {
+    throwJSError(ctx,
+                 ("Failed to execute 'getImageData' on 'CanvasRenderingContext2D': 4 arguments required, but " +
+                  std::to_string(argumentCount) + " present.").c_str(),
+                 exception);
+    return nullptr;
+  }
+
+  double sx = JSValueToNumber(ctx, arguments[0], exception);
+  double sy = JSValueToNumber(ctx, arguments[1], exception);
+  double sw = JSValueToNumber(ctx, arguments[2], exception);
+  double sh = JSValueToNumber(ctx, arguments[3], exception);
+
+  if (!std::isfinite(sx) || !std::isfinite(sy) || !std::isfinite(sw) || !std::isfinite(sh)) {
+    throwJSError(ctx, "Failed to execute 'getImageData' on 'CanvasRenderingContext2D': The source rect is not finite.",
+                 exception);
+    return nullptr;
+  }
+
+  if (sw == 0 || sh == 0) {
+    throwJSError(ctx, "Failed to execute 'getImageData' on 'CanvasRenderingContext2D': The source width or height is 0.",
+                 exception);
+    return nullptr;
+  }
+
+  // Negative size selects the rectangle on the other side of the origin.
+  if (sw < 0) {
+    sx += sw;
+    sw = -sw;
+  }
+  if (sh < 0) {
+    sy += sh;
+    sh = -sh;
+  }
+
+  // Dart side rounds the rect to integers and allocates the pixels, both fail on values out of these bounds.
+  if (std::abs(sx) > MAX_IMAGE_DATA_COORDINATE || std::abs(sy) > MAX_IMAGE_DATA_COORDINATE ||
+      std::ceil(sw) * std::ceil(sh) > MAX_IMAGE_DATA_PIXELS) {
+    throwJSError(ctx, "Failed to execute 'getImageData' on 'CanvasRenderingContext2D': The source rect is too large.",
+                 exception);
+    return nullptr;
+  }
+
+  auto instance =
+    reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
+  auto context = instance->context;
+
+  // Pixels are read back, apply recorded draw operations first.
+  CanvasRenderingContext2D::flushDisplayLists(context);
+  assert_m(instance->nativeCanvasRenderingContext2D->getImageData != nullptr,
+           "Failed to execute getImageData(): dart method is nullptr.");
+
+  auto bridge = static_cast<JSBridge *>(context->getOwner());
+  auto imageDataPromiseContext =
+    new ImageDataPromiseContext(bridge, context, instance->nativeCanvasRenderingContext2D, sx, sy, sw, sh);
+
+  auto promiseCallback = [](JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argumentCount,
+                            const JSValueRef arguments[], JSValueRef *exception) -> JSValueRef {
+    auto imageDataPromiseContext = reinterpret_cast<ImageDataPromiseContext *>(JSObjectGetPrivate(function));
+    auto callbackContext = std::make_unique<foundation::BridgeCallback::Context>(
+      *imageDataPromiseContext->context, arguments[0], arguments[1], exception);
+
+    auto handleImageDataCallback = [](void *ptr, int32_t contextId, const char *errmsg,
+                                      NativeImageData *nativeImageData) {
+      auto callbackContext = static_cast<foundation::BridgeCallback::Context *>(ptr);
+      JSContext *context = &callbackContext->_context;
+      JSContextRef ctx = context->context();
+
+      if (!checkContext(contextId, context)) {
+        if (nativeImageData != nullptr) {
+          free(nativeImageData->data);
+          free(nativeImageData);
+        }
+        return;
+      }
+
+      if (errmsg != nullptr) {
+        JSStringRef errorStringRef = JSStringCreateWithUTF8CString(errmsg);
+        const JSValueRef arguments[] = {JSValueMakeString(ctx, errorStringRef)};
+        JSStringRelease(errorStringRef);
+        JSObjectRef rejectObjectRef = JSValueToObject(ctx, callbackContext->_secondaryCallback, nullptr);
+        JSObjectCallAsFunction(ctx, rejectObjectRef, context->global(), 1, arguments, nullptr);
+      } else {
+        // Expose pixels allocated by dart side without copying, they are freed with the Uint8ClampedArray.
+        JSObjectRef data = JSObjectMakeTypedArrayWithBytesNoCopy(
+          ctx, kJSTypedArrayTypeUint8ClampedArray, nativeImageData->data, nativeImageData->length,
+          [](void *bytes, void *) { free(bytes); }, nullptr, nullptr);
+
+        JSObjectRef imageData = JSObjectMake(ctx, nullptr, nullptr);
+        JSC_SET_STRING_PROPERTY(context, imageData, "width",
+                                JSValueMakeNumber(ctx, static_cast<double>(nativeImageData->width)));
+        JSC_SET_STRING_PROPERTY(context, imageData, "height",
+                                JSValueMakeNumber(ctx, static_cast<double>(nativeImageData->height)));
+        JSC_SET_STRING_PROPERTY(context, imageData, "data", data);
+        free(nativeImageData);
+
+        const JSValueRef arguments[] = {imageData};
+        JSObjectRef resolveObjectRef = JSValueToObject(ctx, callbackContext->_callback, nullptr);
+        JSObjectCallAsFunction(ctx, resolveObjectRef, context->global(), 1, arguments, nullptr);
+      }
+
+      auto bridge = static_cast<JSBridge *>(context->getOwner());
+      bridge->bridgeCallback->freeBridgeCallbackContext(callbackContext);
+    };
+
+    imageDataPromiseContext->bridge->bridgeCallback->registerCallback<void>(
+      std::move(callbackContext),
+      [imageDataPromiseContext, handleImageDataCallback](foundation::BridgeCallback::Context *callbackContext,
+                                                         int32_t contextId) {
+        auto native = imageDataPromiseContext->nativeCanvasRenderingContext2D;
+        native->getImageData(native, callbackContext, contextId, handleImageDataCallback, imageDataPromiseContext->sx,
+                             imageDataPromiseContext->sy, imageDataPromiseContext->sw, imageDataPromiseContext->sh);
+      });
+
+    delete imageDataPromiseContext;
+
+    return nullptr;
+  };
+
+  return JSObjectMakePromise(context, imageDataPromiseContext, promiseCallback, exception);
+}
+
+// https://developer.mozilla.org/en-US/docs/Web/API/CanvasRenderingContext2D/putImageData
+JSValueRef CanvasRenderingContext2D::putImageData(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+                                                  size_t argumentCount, const JSValueRef *arguments,
+                                                  JSValueRef *exception) {
+  if (argumentCount != 3) {
+    throwJSError(ctx,
+                 ("Failed to execute 'putImageData' on 'CanvasRenderingContext2D': 3 arguments required, but " +
+                  std::to_string(argumentCount) + " present.").c_str(),
+                 exception);
+    return nullptr;
+  }
+
+  if (!JSValueIsObject(ctx, arguments[0])) {
+    throwJSError(ctx, "Failed to execute 'putImageData' on 'CanvasRenderingContext2D': parameter 1 is not of type 'ImageData'.",
+                 exception);
+    return nullptr;
+  }
+
+  auto instance =
+    reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
+
+  JSObjectRef imageData = JSValueToObject(ctx, arguments[0], exception);
+  JSStringHolder widthStringHolder = JSStringHolder(instance->context, "width");
+  JSStringHolder heightStringHolder = JSStringHolder(instance->context, "height");
+  JSStringHolder dataStringHolder = JSStringHolder(instance->context, "data");
+  double width = JSValueToNumber(ctx, JSObjectGetProperty(ctx, imageData, widthStringHolder.getString(), exception),
+                                 exception);
+  double height = JSValueToNumber(ctx, JSObjectGetProperty(ctx, imageData, heightStringHolder.getString(), exception),
+                                  exception);
+  JSValueRef dataValueRef = JSObjectGetProperty(ctx, imageData, dataStringHolder.getString(), exception);
+
+  if (JSValueGetTypedArrayType(ctx, dataValueRef, exception) != kJSTypedArrayTypeUint8ClampedArray) {
+    throwJSError(ctx, "Failed to execute 'putImageData' on 'CanvasRenderingContext2D': data is not a Uint8ClampedArray.",
+                 exception);
+    return nullptr;
+  }
+
+  JSObjectRef data = JSValueToObject(ctx, dataValueRef, exception);
+  size_t length = JSObjectGetTypedArrayByteLength(ctx, data, exception);
+  if (width <= 0 || height <= 0 || length != static_cast<size_t>(width) * static_cast<size_t>(height) * 4) {
+    throwJSError(ctx, "Failed to execute 'putImageData' on 'CanvasRenderingContext2D': data length does not match "
+                      "width and height.",
+                 exception);
+    return nullptr;
+  }
+
+  double dx = JSValueToNumber(ctx, arguments[1], exception);
+  double dy = JSValueToNumber(ctx, arguments[2], exception);
+
+  // Bytes pointer is the start of the backing ArrayBuffer, the array may be a view at an offset of it.
+  auto pixels = static_cast<uint8_t *>(JSObjectGetTypedArrayBytesPtr(ctx, data, exception)) +
+                JSObjectGetTypedArrayByteOffset(ctx, data, exception);
+
+  // Dart side copies the pixels before return, so pixels of js side are passed without copying.
+  CanvasRenderingContext2D::flushDisplayLists(instance->context);
+  assert_m(instance->nativeCanvasRenderingContext2D->putImageData != nullptr,
+           "Failed to execute putImageData(): dart method is nullptr.");
+  instance->nativeCanvasRenderingContext2D->putImageData(instance->nativeCanvasRenderingContext2D, pixels,
+                                                         static_cast<int64_t>(width), static_cast<int64_t>(height),
+                                                         dx, dy);
+  return nullptr;
+}
+
+JSValueRef CanvasRenderingContext2D::appendPathSegments(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+                                                        size_t argumentCount, const JSValueRef *arguments,
+                                                        JSValueRef *exception) {
+  if (argumentCount != 1 || JSValueGetTypedArrayType(ctx, arguments[0], exception) != kJSTypedArrayTypeFloat32Array) {
+    throwJSError(ctx, "Failed to execute 'appendPathSegments' on 'CanvasRenderingContext2D': parameter 1 is not of type "
+                      "'Float32Array'.",
+                 exception);
+    return nullptr;
+  }
+
+  JSObjectRef segmentsObject = JSValueToObject(ctx, arguments[0], exception);
+  auto segments = reinterpret_cast<const float *>(
+    static_cast<const uint8_t *>(JSObjectGetTypedArrayBytesPtr(ctx, segmentsObject, exception)) +
+    JSObjectGetTypedArrayByteOffset(ctx, segmentsObject, exception));
+  size_t length = JSObjectGetTypedArrayLength(ctx, segmentsObject, exception);
+
+  // Validate the whole path before recording, a malformed path draws nothing.
+  size_t index = 0;
+  while (index < length) {
+    float value = segments[index];
+    // Also rejects NaN.
+    bool isVerb = value >= 0 && value <= static_cast<float>(CanvasPathVerb::closePath) &&
+                  value == static_cast<float>(static_cast<int32_t>(value));
+    auto verb = isVerb ? static_cast<int32_t>(value) : 0;
+    if (!isVerb || index + 1 + canvasPathVerbPointCount[verb] > length) {
+      throwJSError(ctx, ("Failed to execute 'appendPathSegments' on 'CanvasRenderingContext2D': invalid segment at " +
+                         std::to_string(index) + ".").c_str(),
+                   exception);
+      return nullptr;
+    }
+    index += 1 + canvasPathVerbPointCount[verb];
+  }
+
+  if (length == 0) return nullptr;
+
+  auto instance =
+    reinterpret_cast<CanvasRenderingContext2D::CanvasRenderingContext2DInstance *>(JSObjectGetPrivate(thisObject));
+  double offset = instance->displayList->recordFloats(segments, length);
+  instance->record(CanvasDisplayListOp::pathSegments, {offset, static_cast<double>(length)});
   return nullptr;
 }
 
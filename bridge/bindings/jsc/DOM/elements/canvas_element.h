@@ -7,7 +7,12 @@
 #define KRAKENBRIDGE_CANVAS_ELEMENT_H
 
 #include "bindings/jsc/DOM/element.h"
+#include "bindings/jsc/DOM/elements/image_element.h"
 #include "bindings/jsc/js_context_internal.h"
+#include "include/kraken_foundation.h"
+#include <initializer_list>
+#include <unordered_set>
+#include <vector>
 
 namespace kraken::binding::jsc {
 
@@ -28,7 +33,6 @@ struct NativeCanvasElement {
 
 class JSCanvasElement : public JSElement {
 public:
-  static std::unordered_map<JSContext *, JSCanvasElement *> instanceMap;
   OBJECT_INSTANCE(JSCanvasElement)
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -48,6 +52,8 @@ public:
     void getPropertyNames(JSPropertyNameAccumulatorRef accumulator) override;
 
     NativeCanvasElement *nativeCanvasElement;
+    // Batch of the last ui command which creates or resizes the canvas, draw operations must be submitted after it.
+    int64_t commandBatch;
 
   private:
     double _width{300};
@@ -65,93 +71,129 @@ private:
 };
 
 
-using SetProperty = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, NativeString *value);
-using Arc = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double x, double y,
-                    double radius, double startAngle, double endAngle, double counterclockwise);
-using ArcTo = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double x1, double y1,
-                      double x2, double y2, double radius);
-using BeginPath = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D);
-using BezierCurveTo = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double x1, double y1,
-                              double x2, double y2, double x, double y);
-using ClearRect = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double x, double y,
-                           double width, double height);
-using Clip = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, NativeString *fillRule);
-using ClosePath = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D);
-using DrawImage = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, int argumentCount, NativeImageElement *nativeImage,
-                           double sx, double sy, double sWidth, double sHeight, double dx, double dy, double dWidth, double dHeight);
-using Ellipse = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double x, double y,
-                        double radiusX, double radiusY, double rotation, double startAngle, double endAngle, double counterclockwise);
-using Fill = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, NativeString *fillRule);
-using FillRect = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double x, double y,
-                          double width, double height);
-using FillText = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, NativeString *text, double x,
-                          double y, double maxWidth);
-using LineTo = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double x, double y);
-using MoveTo = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double x, double y);
-using QuadraticCurveTo = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double cpx, double cpy,
-                           double x, double y);
-using Rect = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double x, double y,
-                           double width, double height);
-using Rotate = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double angle);
-using Restore = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D);
-using ResetTransform = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderinContext2D);
-using Save = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D);
-using Scale = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double x, double y);
-using Stroke = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D);
-using StrokeRect = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double x, double y,
-                            double width, double height);
-using StrokeText = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, NativeString *text,
-                            double x, double y, double maxWidth);
-using SetTransform = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double a, double b, double c, double d, double e, double f);
-using Transform = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double a, double b, double c, double d, double e, double f);
-using Translate = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, double x, double y);
+
+// Draw operations of CanvasRenderingContext2D, each one followed by a fixed count of arguments in display list.
+// The order must be as same as the CanvasDisplayListOp of dart side.
+enum class CanvasDisplayListOp : int32_t {
+  setDirection,
+  setFont,
+  setFillStyle,
+  setStrokeStyle,
+  setLineCap,
+  setLineDashOffset,
+  setLineJoin,
+  setLineWidth,
+  setMiterLimit,
+  setTextAlign,
+  setTextBaseline,
+  arc,
+  arcTo,
+  beginPath,
+  bezierCurveTo,
+  clearRect,
+  clip,
+  closePath,
+  drawImage,
+  ellipse,
+  fill,
+  fillRect,
+  fillText,
+  lineTo,
+  moveTo,
+  quadraticCurveTo,
+  rect,
+  restore,
+  rotate,
+  resetTransform,
+  save,
+  scale,
+  stroke,
+  strokeRect,
+  strokeText,
+  setTransform,
+  transform,
+  translate,
+  pathSegments
+};
+
+// Verbs of the segments passed to appendPathSegments, each followed by its points.
+// The order must be as same as the CanvasPathVerb of dart side.
+enum class CanvasPathVerb : int32_t { moveTo, lineTo, quadraticCurveTo, bezierCurveTo, closePath };
+
+// Draw operations recorded between two submits, in the form of [op, arguments..., op, arguments...].
+// String arguments are stored as indexes of strings, and the image of drawImage as the raw bits of its pointer.
+// Path segments are stored as offset and length of floats.
+struct NativeCanvasDisplayList {
+  double *ops{nullptr};
+  int64_t length{0};
+  NativeString *strings{nullptr};
+  int64_t stringsLength{0};
+  float *floats{nullptr};
+  int64_t floatsLength{0};
+};
+
+class CanvasDisplayList {
+public:
+  void record(CanvasDisplayListOp op, std::initializer_list<double> arguments);
+  // Copy the string into display list and return the index to be recorded as argument.
+  double recordString(const NativeString &string);
+  double recordPointer(void *ptr);
+  // Copy the floats into display list and return the offset to be recorded as argument.
+  double recordFloats(const float *floats, size_t length);
+
+  bool empty() const {
+    return m_ops.empty();
+  }
+
+  NativeCanvasDisplayList *nativeDisplayList();
+  void reset();
+
+private:
+  std::vector<double> m_ops;
+  std::vector<NativeString> m_strings;
+  std::vector<float> m_floats;
+  ::foundation::UICommandStringArena m_stringArena;
+  NativeCanvasDisplayList m_nativeDisplayList;
+};
+
+// Pixels in RGBA order without premultiplied alpha. Allocated by dart side with malloc, and released when the
+// ImageData of js side is collected.
+struct NativeImageData {
+  uint8_t *data{nullptr};
+  int64_t length{0};
+  int64_t width{0};
+  int64_t height{0};
+};
+
+using SubmitDisplayList = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D,
+                                   NativeCanvasDisplayList *displayList);
+// Called once the pixels of every operation submitted before getImageData are read back, with either an error
+// message or the image data.
+using GetImageDataCallback = void (*)(void *callbackContext, int32_t contextId, const char *errmsg,
+                                      NativeImageData *imageData);
+using GetImageData = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, void *callbackContext,
+                              int32_t contextId, GetImageDataCallback callback, double sx, double sy, double sw,
+                              double sh);
+using PutImageData = void (*)(NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D, uint8_t *data,
+                              int64_t width, int64_t height, double dx, double dy);
 
 // Function pointer's order must be as same as the NativeCanvasRenderingContext2D class of dart side.
 struct NativeCanvasRenderingContext2D {
-  SetProperty setDirection{nullptr};
-  SetProperty setFont{nullptr};
-  SetProperty setFillStyle{nullptr};
-  SetProperty setStrokeStyle{nullptr};
-  SetProperty setLineCap{nullptr};
-  SetProperty setLineDashOffset{nullptr};
-  SetProperty setLineJoin{nullptr};
-  SetProperty setLineWidth{nullptr};
-  SetProperty setMiterLimit{nullptr};
-  SetProperty setTextAlign{nullptr};
-  SetProperty setTextBaseline{nullptr};
-  Arc arc{nullptr};
-  ArcTo arcTo{nullptr};
-  BeginPath beginPath{nullptr};
-  BezierCurveTo bezierCurveTo{nullptr};
-  ClearRect clearRect{nullptr};
-  Clip clip{nullptr};
-  ClosePath closePath{nullptr};
-  DrawImage drawImage{nullptr};
-  Ellipse ellipse{nullptr};
-  Fill fill{nullptr};
-  FillRect fillRect{nullptr};
-  FillText fillText{nullptr};
-  LineTo lineTo{nullptr};
-  MoveTo moveTo{nullptr};
-  QuadraticCurveTo quadraticCurveTo{nullptr};
-  Rect rect{nullptr};
-  Restore restore{nullptr};
-  Rotate rotate{nullptr};
-  ResetTransform resetTransform{nullptr};
-  Save save{nullptr};
-  Scale scale{nullptr};
-  Stroke stroke{nullptr};
-  StrokeRect strokeRect{nullptr};
-  StrokeText strokeText{nullptr};
-  SetTransform setTransform{nullptr};
-  Transform transform{nullptr};
-  Translate translate{nullptr};
+  SubmitDisplayList submitDisplayList{nullptr};
+  GetImageData getImageData{nullptr};
+  PutImageData putImageData{nullptr};
 };
 
 class CanvasRenderingContext2D : public HostClass {
 public:
-  static std::unordered_map<JSContext *, CanvasRenderingContext2D *> instanceMap;
   OBJECT_INSTANCE(CanvasRenderingContext2D)
+
+  // Draw operations are recorded and submitted to dart side once per frame. When disabled, every operation is
+  // submitted at once, which is the same as calling dart side for each operation.
+  static bool recordingEnabled;
+  // Submit all recorded draw operations of this context. Should be called before reading back pixels of canvas
+  // or resizing canvas.
+  static void flushDisplayLists(JSContext *context);
   // 2D
   static JSValueRef arc(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argumentCount,
                              const JSValueRef arguments[], JSValueRef *exception);
@@ -207,6 +249,14 @@ public:
                              const JSValueRef arguments[], JSValueRef *exception);
   static JSValueRef translate(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argumentCount,
                              const JSValueRef arguments[], JSValueRef *exception);
+  static JSValueRef getImageData(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argumentCount,
+                                 const JSValueRef arguments[], JSValueRef *exception);
+  static JSValueRef putImageData(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argumentCount,
+                                 const JSValueRef arguments[], JSValueRef *exception);
+  // Append path segments from a Float32Array in the form of [verb, points..., verb, points...], so a large path
+  // costs one call instead of one call per point.
+  static JSValueRef appendPathSegments(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+                                       size_t argumentCount, const JSValueRef arguments[], JSValueRef *exception);
 
   class CanvasRenderingContext2DInstance : public Instance {
   public:
@@ -214,25 +264,40 @@ public:
                           direction, font, fillStyle, strokeStyle, lineCap,
                           lineDashOffset, lineJoin, lineWidth, miterLimit, textAlign,
                           textBaseline);
-    DEFINE_PROTOTYPE_OBJECT_PROPERTY(CanvasRenderingContext2D, 27,
+    DEFINE_PROTOTYPE_OBJECT_PROPERTY(CanvasRenderingContext2D, 30,
                                     arc, arcTo, beginPath, bezierCurveTo, clearRect,
                                     closePath, clip, drawImage, ellipse, fill, fillRect,
                                     fillText, lineTo, moveTo, rect, restore,
                                     resetTransform, rotate, quadraticCurveTo, stroke, strokeRect,
                                     save, scale, strokeText, setTransform, transform,
-                                    translate);
+                                    translate, getImageData, putImageData, appendPathSegments);
 
     CanvasRenderingContext2DInstance() = delete;
     explicit CanvasRenderingContext2DInstance(CanvasRenderingContext2D *canvasRenderContext2D,
+                                              JSCanvasElement::CanvasElementInstance *canvasElementInstance,
                                               NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D);
     ~CanvasRenderingContext2DInstance() override;
     JSValueRef getProperty(std::string &name, JSValueRef *exception) override;
     bool setProperty(std::string &name, JSValueRef value, JSValueRef *exception) override;
     void getPropertyNames(JSPropertyNameAccumulatorRef accumulator) override;
 
+    // Append a draw operation to display list, and schedule a submit on the next frame.
+    void record(CanvasDisplayListOp op, std::initializer_list<double> arguments);
+    // Keep the image alive until the display list referencing it is submitted.
+    void recordImage(JSImageElement::ImageElementInstance *imageElementInstance);
+    void submit();
+
     NativeCanvasRenderingContext2D *nativeCanvasRenderingContext2D;
+    std::unique_ptr<CanvasDisplayList> displayList{std::make_unique<CanvasDisplayList>()};
 
   private:
+    void releaseImages();
+
+    JSCanvasElement::CanvasElementInstance *m_canvasElementInstance;
+    JSValueHolder m_canvasElement;
+    std::vector<JSObjectRef> m_images;
+    // The latest batch of ui commands which the recorded draw operations depend on.
+    int64_t m_dependentBatch{0};
     JSStringHolder m_direction{context, ""};
     JSStringHolder m_font{context, ""};
     JSStringHolder m_fillStyle{context, ""};
@@ -249,6 +314,10 @@ public:
 protected:
   CanvasRenderingContext2D() = delete;
   explicit CanvasRenderingContext2D(JSContext *context);
+  ~CanvasRenderingContext2D();
+
+  // Instances which have draw operations waiting for submit.
+  std::unordered_set<CanvasRenderingContext2DInstance *> m_recordingInstances;
 
   JSFunctionHolder m_arc{context, prototypeObject, this, "arc", arc};
   JSFunctionHolder m_arcTo{context, prototypeObject, this, "arcTo", arcTo};
@@ -277,6 +346,9 @@ protected:
   JSFunctionHolder m_setTransform{context, prototypeObject, this, "setTransform", setTransform};
   JSFunctionHolder m_transform{context, prototypeObject, this, "transform", transform};
   JSFunctionHolder m_translate{context, prototypeObject, this, "translate", translate};
+  JSFunctionHolder m_getImageData{context, prototypeObject, this, "getImageData", getImageData};
+  JSFunctionHolder m_putImageData{context, prototypeObject, this, "putImageData", putImageData};
+  JSFunctionHolder m_appendPathSegments{context, prototypeObject, this, "appendPathSegments", appendPathSegments};
 };
 
 } // namespace kraken::binding::jsc
@@ -13,10 +13,9 @@ void bindImageElement(std::unique_ptr<JSContext> &context) {
   JSC_GLOBAL_SET_PROPERTY(context, "HTMLImageElement", ImageElement->classObject);
 }
 
-std::unordered_map<JSContext *, JSImageElement *> JSImageElement::instanceMap {};
 
 JSImageElement::~JSImageElement() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSImageElement, this);
 }
 
 JSImageElement::JSImageElement(JSContext *context) : JSElement(context) {}
@@ -30,10 +29,11 @@ JSImageElement::ImageElementInstance::ImageElementInstance(JSImageElement *jsAnc
   : ElementInstance(jsAnchorElement, "img", false), nativeImageElement(new NativeImageElement(nativeElement)) {
   std::string tagName = "img";
   NativeString args_01{};
-  buildUICommandArgs(tagName, args_01);
+  buildUICommandAtomArgs(context, tagName, args_01);
 
-  foundation::UICommandBuffer::instance(context->getContextId())
+  context->commandBuffer()
     ->addCommand(eventTargetId, UICommand::createElement, args_01, nativeImageElement);
+  commandBatch = context->commandBuffer()->batchSequence();
 }
 
 JSValueRef JSImageElement::ImageElementInstance::getProperty(std::string &name, JSValueRef *exception) {
@@ -42,19 +42,19 @@ JSValueRef JSImageElement::ImageElementInstance::getProperty(std::string &name,
     auto &&property = propertyMap[name];
     switch (property) {
     case ImageElementProperty::width: {
-      getDartMethod()->flushUICommand();
+      context->commandBuffer()->flushForLayout();
       return JSValueMakeNumber(_hostClass->ctx, nativeImageElement->getImageWidth(nativeImageElement));
     }
     case ImageElementProperty::height: {
-      getDartMethod()->flushUICommand();
+      context->commandBuffer()->flushForLayout();
       return JSValueMakeNumber(_hostClass->ctx, nativeImageElement->getImageHeight(nativeImageElement));
     }
     case ImageElementProperty::naturalWidth: {
-      getDartMethod()->flushUICommand();
+      context->commandBuffer()->flushForLayout();
       return JSValueMakeNumber(_hostClass->ctx, nativeImageElement->getImageNaturalWidth(nativeImageElement));
     }
     case ImageElementProperty::naturalHeight: {
-      getDartMethod()->flushUICommand();
+      context->commandBuffer()->flushForLayout();
       return JSValueMakeNumber(_hostClass->ctx, nativeImageElement->getImageNaturalHeight(nativeImageElement));
     }
     case ImageElementProperty::src: {
@@ -70,7 +70,7 @@ JSValueRef JSImageElement::ImageElementInstance::getProperty(std::string &name,
 }
 
 bool JSImageElement::ImageElementInstance::setProperty(std::string &name, JSValueRef value, JSValueRef *exception) {
-  auto propertyMap = getImageElementPropertyMap();
+  auto &propertyMap = getImageElementPropertyMap();
 
   if (propertyMap.count(name) > 0) {
     auto property = propertyMap[name];
@@ -81,8 +81,8 @@ bool JSImageElement::ImageElementInstance::setProperty(std::string &name, JSValu
       std::string string = JSStringToStdString(stringRef);
       NativeString args_01{};
       NativeString args_02{};
-      buildUICommandArgs(name, string, args_01, args_02);
-      foundation::UICommandBuffer::instance(_hostClass->contextId)
+      buildUICommandArgs(context, name, string, args_01, args_02);
+      context->commandBuffer()
         ->addCommand(eventTargetId, UICommand::setProperty, args_01, args_02, nullptr);
       break;
     }
@@ -92,8 +92,8 @@ bool JSImageElement::ImageElementInstance::setProperty(std::string &name, JSValu
 
       NativeString args_01{};
       NativeString args_02{};
-      buildUICommandArgs(name, src, args_01, args_02);
-      foundation::UICommandBuffer::instance(_hostClass->contextId)
+      buildUICommandArgs(context, name, src, args_01, args_02);
+      context->commandBuffer()
         ->addCommand(eventTargetId, UICommand::setProperty, args_01, args_02, nullptr);
       break;
     }
@@ -103,8 +103,8 @@ bool JSImageElement::ImageElementInstance::setProperty(std::string &name, JSValu
 
       NativeString args_01{};
       NativeString args_02{};
-      buildUICommandArgs(name, loading, args_01, args_02);
-      foundation::UICommandBuffer::instance(_hostClass->contextId)
+      buildUICommandArgs(context, name, loading, args_01, args_02);
+      context->commandBuffer()
         ->addCommand(eventTargetId, UICommand::setProperty, args_01, args_02, nullptr);
       break;
     }
@@ -126,7 +126,7 @@ void JSImageElement::ImageElementInstance::getPropertyNames(JSPropertyNameAccumu
 }
 
 JSImageElement::ImageElementInstance::~ImageElementInstance() {
-  ::foundation::UICommandCallbackQueue::instance()->registerCallback([](void *ptr) {
+  context->commandBuffer()->registerCallback([](void *ptr) {
     delete reinterpret_cast<NativeImageElement *>(ptr);
   }, nativeImageElement);
 }
@@ -17,7 +17,6 @@ void bindImageElement(std::unique_ptr<JSContext> &context);
 
 class JSImageElement : public JSElement {
 public:
-  static std::unordered_map<JSContext *, JSImageElement *> instanceMap;
   OBJECT_INSTANCE(JSImageElement)
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
                                   const JSValueRef *arguments, JSValueRef *exception) override;
@@ -34,6 +33,8 @@ public:
     void getPropertyNames(JSPropertyNameAccumulatorRef accumulator) override;
 
     NativeImageElement *nativeImageElement;
+    // Batch of the ui command which creates the image, canvas draws the image after it.
+    int64_t commandBatch;
 
   private:
     JSStringHolder m_src{context, ""};
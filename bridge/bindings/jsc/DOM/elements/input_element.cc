@@ -12,16 +12,18 @@ void bindInputElement(std::unique_ptr<JSContext> &context) {
   JSC_GLOBAL_SET_PROPERTY(context, "HTMLInputElement", InputElement->classObject);
 }
 
-std::unordered_map<JSContext *, JSInputElement *> JSInputElement::instanceMap {};
 
 JSInputElement *JSInputElement::instance(JSContext *context) {
-  if (instanceMap.count(context) == 0) {
-    instanceMap[context] = new JSInputElement(context);
+  auto &bindingState = context->bindingState();
+  auto hostClass = bindingState.hostClass<JSInputElement>(BindingSlot::JSInputElement);
+  if (hostClass == nullptr) {
+    hostClass = new JSInputElement(context);
+    bindingState.setHostClass(BindingSlot::JSInputElement, hostClass);
   }
-  return instanceMap[context];
+  return hostClass;
 }
 JSInputElement::~JSInputElement() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSInputElement, this);
 }
 
 JSInputElement::JSInputElement(JSContext *context) : JSElement(context) {}
@@ -59,30 +61,29 @@ JSInputElement::InputElementInstance::InputElementInstance(JSInputElement *jsAnc
   : ElementInstance(jsAnchorElement, "input", false), nativeInputElement(new NativeInputElement(nativeElement)) {
   std::string tagName = "input";
   NativeString args_01{};
-  buildUICommandArgs(tagName, args_01);
+  buildUICommandAtomArgs(context, tagName, args_01);
 
-  foundation::UICommandBuffer::instance(context->getContextId())
+  context->commandBuffer()
     ->addCommand(eventTargetId, UICommand::createElement, args_01, nativeInputElement);
 }
 
 JSValueRef JSInputElement::InputElementInstance::getProperty(std::string &name, JSValueRef *exception) {
   auto &propertyMap = getInputElementPropertyMap();
   auto &propertyPropertyMap = getInputElementPrototypePropertyMap();
-  JSStringHolder nameStringHolder = JSStringHolder(context, name);
 
   if (propertyPropertyMap.count(name) > 0) {
-    return JSObjectGetProperty(ctx, prototype<JSInputElement>()->prototypeObject, nameStringHolder.getString(), exception);
+    return JSObjectGetProperty(ctx, prototype<JSInputElement>()->prototypeObject, context->atom(name), exception);
   };
 
   if (propertyMap.count(name) > 0) {
     auto &&property = propertyMap[name];
     switch (property) {
     case InputElementProperty::width: {
-      getDartMethod()->flushUICommand();
+      context->commandBuffer()->flushForLayout();
       return JSValueMakeNumber(_hostClass->ctx, nativeInputElement->getInputWidth(nativeInputElement));
     }
     case InputElementProperty::height: {
-      getDartMethod()->flushUICommand();
+      context->commandBuffer()->flushForLayout();
       return JSValueMakeNumber(_hostClass->ctx, nativeInputElement->getInputHeight(nativeInputElement));
     }
     default: {
@@ -113,8 +114,8 @@ bool JSInputElement::InputElementInstance::setProperty(std::string &name, JSValu
     std::string string = JSStringToStdString(valueString);
     NativeString args_01{};
     NativeString args_02{};
-    buildUICommandArgs(name, string, args_01, args_02);
-    foundation::UICommandBuffer::instance(_hostClass->contextId)
+    buildUICommandArgs(context, name, string, args_01, args_02);
+    context->commandBuffer()
       ->addCommand(eventTargetId, UICommand::setProperty, args_01, args_02, nullptr);
     return true;
   } else {
@@ -17,7 +17,6 @@ void bindInputElement(std::unique_ptr<JSContext> &context);
 
 class JSInputElement : public JSElement {
 public:
-  static std::unordered_map<JSContext *, JSInputElement *> instanceMap;
   static JSInputElement *instance(JSContext *context);
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
                                   const JSValueRef *arguments, JSValueRef *exception) override;
@@ -7,10 +7,9 @@
 
 namespace kraken::binding::jsc {
 
-std::unordered_map<JSContext *, JSObjectElement *> JSObjectElement::instanceMap{};
 
 JSObjectElement::~JSObjectElement() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSObjectElement, this);
 }
 
 JSObjectElement::JSObjectElement(JSContext *context) : JSElement(context) {}
@@ -24,9 +23,9 @@ JSObjectElement::ObjectElementInstance::ObjectElementInstance(JSObjectElement *j
   : ElementInstance(jsAnchorElement, "object", false), nativeObjectElement(new NativeObjectElement(nativeElement)) {
   std::string tagName = "object";
   NativeString args_01{};
-  buildUICommandArgs(tagName, args_01);
+  buildUICommandAtomArgs(context, tagName, args_01);
 
-  foundation::UICommandBuffer::instance(context->getContextId())
+  context->commandBuffer()
       ->addCommand(eventTargetId, UICommand::createElement, args_01, nativeObjectElement);
 }
 
@@ -63,8 +62,8 @@ bool JSObjectElement::ObjectElementInstance::setProperty(std::string &name, JSVa
       NativeString args_01{};
       NativeString args_02{};
 
-      buildUICommandArgs(name, dataStringRef, args_01, args_02);
-      foundation::UICommandBuffer::instance(_hostClass->contextId)
+      buildUICommandArgs(context, name, dataStringRef, args_01, args_02);
+      context->commandBuffer()
         ->addCommand(eventTargetId,UICommand::setProperty, args_01, args_02, nullptr);
       break;
     }
@@ -75,8 +74,8 @@ bool JSObjectElement::ObjectElementInstance::setProperty(std::string &name, JSVa
       NativeString args_01{};
       NativeString args_02{};
 
-      buildUICommandArgs(name, typeStringRef, args_01, args_02);
-      foundation::UICommandBuffer::instance(_hostClass->contextId)
+      buildUICommandArgs(context, name, typeStringRef, args_01, args_02);
+      context->commandBuffer()
         ->addCommand(eventTargetId,UICommand::setProperty, args_01, args_02, nullptr);
       break;
     }
@@ -98,7 +97,7 @@ void JSObjectElement::ObjectElementInstance::getPropertyNames(JSPropertyNameAccu
 }
 
 JSObjectElement::ObjectElementInstance::~ObjectElementInstance() {
-  ::foundation::UICommandCallbackQueue::instance()->registerCallback([](void *ptr) {
+  context->commandBuffer()->registerCallback([](void *ptr) {
     delete reinterpret_cast<NativeObjectElement *>(ptr);
   }, nativeObjectElement);
 }
@@ -15,7 +15,6 @@ struct NativeObjectElement;
 
 class JSObjectElement : public JSElement {
 public:
-  static std::unordered_map<JSContext *, JSObjectElement *> instanceMap;
   OBJECT_INSTANCE(JSObjectElement)
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
                                   const JSValueRef *arguments, JSValueRef *exception) override;
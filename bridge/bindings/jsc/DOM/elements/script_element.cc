@@ -9,10 +9,9 @@ namespace kraken::binding::jsc {
 
 JSScriptElement::JSScriptElement(JSContext *context) : JSElement(context) {}
 
-std::unordered_map<JSContext *, JSScriptElement *> JSScriptElement::instanceMap {};
 
 JSScriptElement::~JSScriptElement() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSScriptElement, this);
 }
 
 JSObjectRef JSScriptElement::instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -25,9 +24,9 @@ JSScriptElement::ScriptElementInstance::ScriptElementInstance(JSScriptElement *j
   : ElementInstance(jsElement, "script", false) {
   std::string tagName = "script";
   NativeString args_01{};
-  buildUICommandArgs(tagName, args_01);
+  buildUICommandAtomArgs(context, tagName, args_01);
 
-  foundation::UICommandBuffer::instance(context->getContextId())
+  context->commandBuffer()
       ->addCommand(eventTargetId, UICommand::createElement, args_01, nativeElement);
 }
 
@@ -58,8 +57,8 @@ bool JSScriptElement::ScriptElementInstance::setProperty(std::string &name, JSVa
 
     NativeString args_01{};
     NativeString args_02{};
-    buildUICommandArgs(name, srcString, args_01, args_02);
-    foundation::UICommandBuffer::instance(_hostClass->contextId)
+    buildUICommandArgs(context, name, srcString, args_01, args_02);
+    context->commandBuffer()
       ->addCommand(eventTargetId, UICommand::setProperty, args_01, args_02, nullptr);
     return true;
   }
@@ -35,7 +35,6 @@ public:
 protected:
   JSScriptElement() = delete;
   ~JSScriptElement();
-  static std::unordered_map<JSContext *, JSScriptElement *> instanceMap;
   explicit JSScriptElement(JSContext *context);
 };
 
@@ -14,10 +14,9 @@ void bindSVGElement(std::unique_ptr<JSContext> &context) {
 }
 
 
-std::unordered_map<JSContext *, JSSVGElement *> JSSVGElement::instanceMap{};
 
 JSSVGElement::~JSSVGElement() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSSVGElement, this);
 }
 
 JSSVGElement::JSSVGElement(JSContext *context) : JSElement(context) {}
@@ -31,14 +30,14 @@ JSSVGElement::SVGElementInstance::SVGElementInstance(JSSVGElement *jsSVGElement)
   : ElementInstance(jsSVGElement, "svg", false), nativeSVGElement(new NativeSVGElement(nativeElement)) {
   std::string tagName = "svg";
   NativeString args_01{};
-  buildUICommandArgs(tagName, args_01);
+  buildUICommandAtomArgs(context, tagName, args_01);
 
-  foundation::UICommandBuffer::instance(context->getContextId())
+  context->commandBuffer()
     ->addCommand(eventTargetId, UICommand::createElement, args_01, nativeSVGElement);
 }
 
 JSSVGElement::SVGElementInstance::~SVGElementInstance() {
-  ::foundation::UICommandCallbackQueue::instance()->registerCallback([](void *ptr) {
+  context->commandBuffer()->registerCallback([](void *ptr) {
     delete reinterpret_cast<NativeSVGElement *>(ptr);
   }, nativeSVGElement);
 }
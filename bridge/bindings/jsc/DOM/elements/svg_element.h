@@ -17,7 +17,6 @@ struct NativeSVGElement;
 
 class JSSVGElement : public JSElement {
 public:
-  static std::unordered_map<JSContext *, JSSVGElement *> instanceMap;
   OBJECT_INSTANCE(JSSVGElement)
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
                                   const JSValueRef *arguments, JSValueRef *exception) override;
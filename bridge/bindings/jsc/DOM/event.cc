@@ -4,6 +4,7 @@
  */
 
 #include "event.h"
+#include "event_binding.h"
 #include "event_target.h"
 #include "bindings/jsc/DOM/custom_event.h"
 #include "bindings/jsc/DOM/events/gesture_event.h"
@@ -22,15 +23,23 @@ void bindEvent(std::unique_ptr<JSContext> &context) {
   JSC_GLOBAL_SET_PROPERTY(context, "Event", event->classObject);
 };
 
-std::unordered_map<JSContext *, JSEvent *> JSEvent::instanceMap{};
 std::unordered_map<std::string, EventCreator> JSEvent::eventCreatorMap{};
 
 JSEvent::~JSEvent() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSEvent, this);
+  if (context->isValid()) {
+    for (auto object : m_pooledObjects) {
+      JSValueUnprotect(ctx, object);
+    }
+  }
 }
 
-JSEvent::JSEvent(JSContext *context) : HostClass(context, "Event") {}
-JSEvent::JSEvent(JSContext *context, const char *name) : HostClass(context, name) {}
+JSEvent::JSEvent(JSContext *context) : HostClass(context, "Event") {
+  defineInstanceStaticValues(getEventStaticValues());
+}
+JSEvent::JSEvent(JSContext *context, const char *name) : HostClass(context, name) {
+  defineInstanceStaticValues(getEventStaticValues());
+}
 
 JSObjectRef JSEvent::instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
                                          const JSValueRef *arguments, JSValueRef *exception) {
@@ -77,9 +86,10 @@ JSValueRef JSEvent::getProperty(std::string &name, JSValueRef *exception) {
 }
 
 EventInstance::EventInstance(JSEvent *jsEvent, NativeEvent *nativeEvent)
-  : Instance(jsEvent), nativeEvent(nativeEvent) {}
+  : Instance(jsEvent, jsEvent->takePooledObject()), nativeEvent(nativeEvent) {}
 
-EventInstance::EventInstance(JSEvent *jsEvent, std::string eventType, JSValueRef eventInitValueRef, JSValueRef *exception) : Instance(jsEvent) {
+EventInstance::EventInstance(JSEvent *jsEvent, std::string eventType, JSValueRef eventInitValueRef, JSValueRef *exception)
+  : Instance(jsEvent, jsEvent->takePooledObject()) {
   nativeEvent = new NativeEvent(stringToNativeString(eventType));
   auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
   nativeEvent->timeStamp = ms.count();
@@ -97,51 +107,71 @@ EventInstance::EventInstance(JSEvent *jsEvent, std::string eventType, JSValueRef
 }
 
 JSValueRef EventInstance::getProperty(std::string &name, JSValueRef *exception) {
-  auto &propertyMap = JSEvent::getEventPropertyMap();
   auto &prototypeProperty = JSEvent::getEventPrototypePropertyMap();
-  JSStringHolder nameStringHolder = JSStringHolder(context, name);
 
   if (prototypeProperty.count(name) > 0) {
-    return JSObjectGetProperty(ctx, prototype<JSEvent>()->prototypeObject, nameStringHolder.getString(), exception);
+    return JSObjectGetProperty(ctx, prototype<JSEvent>()->prototypeObject, context->atom(name), exception);
   }
 
-  if (propertyMap.count(name) == 0) return Instance::getProperty(name, exception);
+  return Instance::getProperty(name, exception);
+}
 
-  auto &property = propertyMap[name];
-  switch (property) {
-  case JSEvent::EventProperty::type: {
-    JSStringRef eventStringRef = JSStringCreateWithCharacters(nativeEvent->type->string, nativeEvent->type->length);
-    return JSValueMakeString(_hostClass->ctx, eventStringRef);
-  }
-  case JSEvent::EventProperty::bubbles: {
-    return JSValueMakeBoolean(_hostClass->ctx, nativeEvent->bubbles);
+JSValueRef EventInstance::type() {
+  return context->atomValue(context->atom(nativeEvent->type->string, nativeEvent->type->length));
+}
+
+bool EventInstance::bubbles() {
+  return nativeEvent->bubbles;
+}
+
+bool EventInstance::cancelable() {
+  return nativeEvent->cancelable;
+}
+
+double EventInstance::timestamp() {
+  return nativeEvent->timeStamp;
+}
+
+bool EventInstance::defaultPrevented() {
+  return _cancelled;
+}
+
+JSValueRef EventInstance::target() {
+  if (nativeEvent->target != nullptr) {
+    auto instance = reinterpret_cast<EventTargetInstance *>(nativeEvent->target);
+    return instance->object;
   }
-  case JSEvent::EventProperty::cancelable: {
-    return JSValueMakeBoolean(_hostClass->ctx, nativeEvent->cancelable);
+  return JSValueMakeNull(ctx);
+}
+
+JSValueRef EventInstance::srcElement() {
+  return target();
+}
+
+JSValueRef EventInstance::currentTarget() {
+  if (nativeEvent->currentTarget != nullptr) {
+    auto instance = reinterpret_cast<EventTargetInstance *>(nativeEvent->currentTarget);
+    return instance->object;
   }
-  case JSEvent::EventProperty::timestamp:
-    return JSValueMakeNumber(_hostClass->ctx, nativeEvent->timeStamp);
-  case JSEvent::EventProperty::defaultPrevented:
-    return JSValueMakeBoolean(_hostClass->ctx, _cancelled);
-  case JSEvent::EventProperty::target:
-  case JSEvent::EventProperty::srcElement:
-    if (nativeEvent->target != nullptr) {
-      auto instance = reinterpret_cast<EventTargetInstance *>(nativeEvent->target);
-      return instance->object;
-    }
-    return JSValueMakeNull(_hostClass->ctx);
-  case JSEvent::EventProperty::currentTarget:
-    if (nativeEvent->currentTarget != nullptr) {
-      auto instance = reinterpret_cast<EventTargetInstance *>(nativeEvent->currentTarget);
-      return instance->object;
-    }
-    return JSValueMakeNull(_hostClass->ctx);
-  case JSEvent::EventProperty::returnValue:
-    return JSValueMakeBoolean(_hostClass->ctx, !_cancelled);
-  case JSEvent::EventProperty::cancelBubble:
-    return JSValueMakeBoolean(_hostClass->ctx, _cancelled);
+  return JSValueMakeNull(ctx);
+}
+
+double EventInstance::eventPhase() {
+  return _eventPhase;
+}
+
+bool EventInstance::returnValue() {
+  return !_cancelled;
+}
+
+bool EventInstance::cancelBubble() {
+  return _cancelled;
+}
+
+void EventInstance::setCancelBubble(bool value) {
+  if (value) {
+    _cancelled = true;
   }
-  return nullptr;
 }
 
 JSValueRef JSEvent::initEvent(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
@@ -193,42 +223,46 @@ JSValueRef JSEvent::preventDefault(JSContextRef ctx, JSObjectRef function, JSObj
                                                   size_t argumentCount, const JSValueRef *arguments,
                                                   JSValueRef *exception) {
   auto eventInstance = static_cast<EventInstance *>(JSObjectGetPrivate(thisObject));
-  if (eventInstance->nativeEvent->cancelable) {
+  if (eventInstance->nativeEvent->cancelable && !eventInstance->_inPassiveListener) {
     eventInstance->_cancelled = true;
   }
   return nullptr;
 }
 
+// Returns the events folded into this one followed by the event itself, for listeners which need every sample of a
+// touchmove or scroll stream.
+JSValueRef JSEvent::getCoalescedEvents(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+                                       size_t argumentCount, const JSValueRef *arguments, JSValueRef *exception) {
+  auto eventInstance = static_cast<EventInstance *>(JSObjectGetPrivate(thisObject));
+  std::vector<JSValueRef> events;
+  events.reserve(eventInstance->_coalescedEvents.size() + 1);
+  for (auto event : eventInstance->_coalescedEvents) {
+    event->_exposed = true;
+    events.emplace_back(event->object);
+  }
+  events.emplace_back(thisObject);
+  return JSObjectMakeArray(ctx, events.size(), events.data(), exception);
+}
+
 bool EventInstance::setProperty(std::string &name, JSValueRef value, JSValueRef *exception) {
-  auto &propertyMap = JSEvent::getEventPropertyMap();
   auto &prototypePropertyMap = JSEvent::getEventPrototypePropertyMap();
 
   if (prototypePropertyMap.count(name) > 0) return false;
 
-  if (propertyMap.count(name) > 0) {
-    auto &property = propertyMap[name];
-
-    if (property == JSEvent::EventProperty::cancelBubble) {
-      bool v = JSValueToBoolean(_hostClass->ctx, value);
-      if (v) {
-        _cancelled = true;
-      }
-    }
-    return true;
-  } else {
-    return Instance::setProperty(name, value, exception);
-  }
+  return Instance::setProperty(name, value, exception);
 }
 
 EventInstance::~EventInstance() {
+  if (context->isValid()) {
+    for (auto event : _coalescedEvents) {
+      JSValueUnprotect(ctx, event->object);
+    }
+  }
   nativeEvent->type->free();
   delete nativeEvent;
 }
 void EventInstance::getPropertyNames(JSPropertyNameAccumulatorRef accumulator) {
-  for (auto &property : JSEvent::getEventPropertyNames()) {
-    JSPropertyNameAccumulatorAddName(accumulator, property);
-  }
-
+  // Attributes in event.idl are static values, which are enumerated by JSC.
   for (auto &property : JSEvent::getEventPrototypePropertyNames()) {
     JSPropertyNameAccumulatorAddName(accumulator, property);
   }
@@ -238,8 +272,8 @@ EventInstance *JSEvent::buildEventInstance(std::string &eventType, JSContext *co
   EventInstance *eventInstance;
   if (isCustomEvent) {
     eventInstance = new CustomEventInstance(JSCustomEvent::instance(context), reinterpret_cast<NativeCustomEvent*>(nativeEvent));
-  } else if (eventCreatorMap.count(eventType) > 0) {
-    eventInstance = eventCreatorMap[eventType](context, nativeEvent);
+  } else if (auto creator = eventCreatorMap.find(eventType); creator != eventCreatorMap.end()) {
+    eventInstance = creator->second(context, nativeEvent);
   } else {
     eventInstance = new EventInstance(JSEvent::instance(context), reinterpret_cast<NativeEvent*>(nativeEvent));
   }
@@ -247,4 +281,49 @@ EventInstance *JSEvent::buildEventInstance(std::string &eventType, JSContext *co
   return eventInstance;
 }
 
+EventInstance *JSEvent::buildEventInstance(JSStringRef eventType, JSContext *context, void *nativeEvent,
+                                           bool isCustomEvent) {
+  if (isCustomEvent) {
+    return new CustomEventInstance(JSCustomEvent::instance(context), reinterpret_cast<NativeCustomEvent *>(nativeEvent));
+  }
+
+  auto &eventCreators = JSEvent::instance(context)->m_eventCreators;
+  auto it = eventCreators.find(eventType);
+  if (it == eventCreators.end()) {
+    // Types without a creator are cached too, as nullptr.
+    auto creator = eventCreatorMap.find(JSStringToStdString(eventType));
+    it = eventCreators.emplace(eventType, creator != eventCreatorMap.end() ? creator->second : nullptr).first;
+  }
+
+  if (it->second != nullptr) return it->second(context, nativeEvent);
+  return new EventInstance(JSEvent::instance(context), reinterpret_cast<NativeEvent *>(nativeEvent));
+}
+
+JSObjectRef JSEvent::takePooledObject() {
+  if (m_pooledObjects.empty()) return nullptr;
+  JSObjectRef object = m_pooledObjects.back();
+  m_pooledObjects.pop_back();
+  // The new instance is referenced from the native stack until it is handed to js.
+  JSValueUnprotect(ctx, object);
+  return object;
+}
+
+void JSEvent::recycleEventInstance(EventInstance *event) {
+  assert_m(!event->_exposed && event->_hostClass == this, "Only unexposed events of this class can be recycled.");
+  // Folded events can only be reached through the event.
+  for (auto coalesced : event->_coalescedEvents) {
+    JSValueUnprotect(ctx, coalesced->object);
+    recycleEventInstance(coalesced);
+  }
+  event->_coalescedEvents.clear();
+
+  JSObjectRef object = event->object;
+  JSObjectSetPrivate(object, nullptr);
+  delete event;
+  if (m_pooledObjects.size() < MAX_POOLED_OBJECTS) {
+    JSValueProtect(ctx, object);
+    m_pooledObjects.emplace_back(object);
+  }
+}
+
 } // namespace kraken::binding::jsc
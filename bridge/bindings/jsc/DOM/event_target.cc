@@ -12,22 +12,74 @@ namespace kraken::binding::jsc {
 
 static std::atomic<int64_t> globalEventTargetId{0};
 
+namespace {
+
+JSStringRef eventTypeAtom(JSContext *context, JSValueRef value, JSValueRef *exception) {
+  JSStringRef string = JSValueToStringCopy(context->context(), value, exception);
+  if (string == nullptr) return nullptr;
+  JSStringRef atom = context->atom(string);
+  JSStringRelease(string);
+  return atom;
+}
+
+struct ListenerOptions {
+  bool capture{false};
+  bool passive{false};
+};
+
+// The third argument of addEventListener and removeEventListener is either useCapture or an options object.
+ListenerOptions listenerOptions(JSContextRef ctx, JSValueRef options, JSValueRef *exception) {
+  ListenerOptions result;
+  if (options == nullptr || !JSValueIsObject(ctx, options)) {
+    result.capture = options != nullptr && JSValueToBoolean(ctx, options);
+    return result;
+  }
+  JSObjectRef optionsObject = JSValueToObject(ctx, options, exception);
+  result.capture = JSValueToBoolean(ctx, getObjectPropertyValue(ctx, "capture", optionsObject, exception));
+  result.passive = JSValueToBoolean(ctx, getObjectPropertyValue(ctx, "passive", optionsObject, exception));
+  return result;
+}
+
+// Event types of NativeEventTarget::subtreeListenerMask in bit order.
+constexpr const char *subtreeListenerEventTypes[]{EVENT_CLICK,       EVENT_TOUCH_START, EVENT_TOUCH_MOVE, EVENT_TOUCH_END,
+                                                  EVENT_TOUCH_CANCEL, EVENT_SCROLL,      EVENT_SWIPE,      EVENT_PAN,
+                                                  EVENT_LONG_PRESS,   EVENT_SCALE};
+static_assert(sizeof(subtreeListenerEventTypes) / sizeof(subtreeListenerEventTypes[0]) ==
+              EventTargetInstance::SUBTREE_LISTENER_EVENT_COUNT);
+
+int32_t subtreeListenerEventIndex(JSContext *context, JSStringRef eventType) {
+  for (uint32_t i = 0; i < EventTargetInstance::SUBTREE_LISTENER_EVENT_COUNT; i++) {
+    if (eventType == context->atom(subtreeListenerEventTypes[i])) return i;
+  }
+  return -1;
+}
+
+} // namespace
+
 void bindEventTarget(std::unique_ptr<JSContext> &context) {
   auto eventTarget = JSEventTarget::instance(context.get());
   JSC_GLOBAL_SET_PROPERTY(context, "EventTarget", eventTarget->classObject);
 }
 
-std::unordered_map<JSContext *, JSEventTarget *> JSEventTarget::instanceMap{};
 
 JSEventTarget *JSEventTarget::instance(JSContext *context) {
-  if (instanceMap.count(context) == 0) {
-    instanceMap[context] = new JSEventTarget(context, nullptr, nullptr);
+  auto &bindingState = context->bindingState();
+  auto hostClass = bindingState.hostClass<JSEventTarget>(BindingSlot::JSEventTarget);
+  if (hostClass == nullptr) {
+    hostClass = new JSEventTarget(context, nullptr, nullptr);
+    bindingState.setHostClass(BindingSlot::JSEventTarget, hostClass);
   }
-  return instanceMap[context];
+  return hostClass;
 }
 
 JSEventTarget::~JSEventTarget() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSEventTarget, this);
+  if (context->isValid()) {
+    for (auto &queued : m_queuedEvents) {
+      JSValueUnprotect(ctx, queued.event->object);
+      JSValueUnprotect(ctx, queued.target->object);
+    }
+  }
 }
 
 JSEventTarget::JSEventTarget(JSContext *context, const char *name) : HostClass(context, name) {}
@@ -75,21 +127,20 @@ EventTargetInstance::EventTargetInstance(JSEventTarget *eventTarget, int64_t id)
 
 EventTargetInstance::~EventTargetInstance() {
   // Recycle eventTarget object could be triggered by hosting JSContext been released or reference count set to 0.
-  foundation::UICommandBuffer::instance(_hostClass->contextId)
+  context->commandBuffer()
       ->addCommand(eventTargetId, UICommand::disposeEventTarget, nullptr, false);
 
   // Release handler callbacks.
   if (context->isValid()) {
-    for (auto &it : _eventHandlers) {
-      for (auto &handler : it.second) {
-        JSValueUnprotect(_hostClass->ctx, handler);
-      }
+    for (auto &listener : m_eventListeners) {
+      if (listener.callback != nullptr) JSValueUnprotect(_hostClass->ctx, listener.callback);
     }
   }
 
-  foundation::UICommandCallbackQueue::instance()->registerCallback([](void *ptr) {
+  context->commandBuffer()->registerCallback([](void *ptr) {
     delete reinterpret_cast<NativeEventTarget *>(ptr);
   }, nativeEventTarget);
+  delete[] m_subtreeListenerCounts;
 }
 
 // target.addEventListener(type, listener [, options]);
@@ -128,35 +179,22 @@ JSValueRef JSEventTarget::addEventListener(JSContextRef ctx, JSObjectRef functio
     return nullptr;
   }
 
-  std::string eventType = JSStringToStdString(JSValueToStringCopy(ctx, eventNameValueRef, exception));
+  JSStringRef eventType = eventTypeAtom(eventTargetInstance->context, eventNameValueRef, exception);
+  if (eventType == nullptr) return nullptr;
+  ListenerOptions options = listenerOptions(ctx, argumentCount > 2 ? arguments[2] : nullptr, exception);
 
-  // Init list.
-  if (eventTargetInstance->_eventHandlers.count(eventType) == 0) {
-    eventTargetInstance->_eventHandlers[eventType] = std::forward_list<JSObjectRef>();
-  }
-
-  JSObjectRef &propertyHandlers = eventTargetInstance->_propertyEventHandler[eventType];
-
-  // Dart needs to be notified for the first registration event.
-  if (eventTargetInstance->_eventHandlers[eventType].empty() || JSObjectIsFunction(ctx, propertyHandlers)) {
-    int32_t contextId = eventTargetInstance->_hostClass->contextId;
-
-    NativeString args_01{};
-    buildUICommandArgs(eventType, args_01);
-
-    auto EventTarget = reinterpret_cast<JSEventTarget *>(eventTargetInstance->_hostClass);
-    auto isJsOnlyEvent =
-      std::find(EventTarget->m_jsOnlyEvents.begin(), EventTarget->m_jsOnlyEvents.end(), eventType) != EventTarget->m_jsOnlyEvents.end();
-
-    if (!isJsOnlyEvent) {
-      foundation::UICommandBuffer::instance(contextId)->addCommand(
-        eventTargetInstance->eventTargetId, UICommand::addEvent, args_01, nullptr);
-    };
+  for (auto &listener : eventTargetInstance->m_eventListeners) {
+    if (listener.type == eventType && listener.callback == callbackObjectRef && listener.capture == options.capture &&
+        !listener.isPropertyHandler) {
+      return nullptr;
+    }
   }
-
-  std::forward_list<JSObjectRef> &handlers = eventTargetInstance->_eventHandlers[eventType];
+  auto before = eventTargetInstance->dartListenerState(eventType);
   JSValueProtect(ctx, callbackObjectRef);
-  handlers.emplace_after(handlers.cbefore_begin(), callbackObjectRef);
+  eventTargetInstance->m_eventListeners.push_back(
+    {eventType, callbackObjectRef, options.capture, options.passive, false});
+  // Dart needs to be notified for the first listener, and when the first active listener is added.
+  eventTargetInstance->updateDartEventListener(eventType, before);
 
   return nullptr;
 }
@@ -212,39 +250,23 @@ JSValueRef JSEventTarget::removeEventListener(JSContextRef ctx, JSObjectRef func
     return nullptr;
   }
 
-  std::string eventType = JSStringToStdString(JSValueToStringCopy(ctx, eventNameValueRef, exception));
-
-  if (eventTargetInstance->_eventHandlers.count(eventType) == 0) {
-    return nullptr;
-  }
-
-  std::forward_list<JSObjectRef> &handlers = eventTargetInstance->_eventHandlers[eventType];
+  JSStringRef eventType = eventTypeAtom(eventTargetInstance->context, eventNameValueRef, exception);
+  if (eventType == nullptr) return nullptr;
+  bool capture = listenerOptions(ctx, argumentCount > 2 ? arguments[2] : nullptr, exception).capture;
 
-  handlers.remove_if([&callbackObjectRef, &ctx](JSObjectRef function) {
-    if (function == callbackObjectRef) {
-      JSValueUnprotect(ctx, callbackObjectRef);
-      return true;
+  auto &listeners = eventTargetInstance->m_eventListeners;
+  for (uint32_t i = 0; i < listeners.size(); i++) {
+    auto &listener = listeners[i];
+    if (listener.type != eventType || listener.callback != callbackObjectRef || listener.capture != capture ||
+        listener.isPropertyHandler) {
+      continue;
     }
-    return false;
-  });
-
-  JSObjectRef &propertyHandlers = eventTargetInstance->_propertyEventHandler[eventType];
-
-  if (handlers.empty() && JSObjectIsFunction(ctx, propertyHandlers)) {
-    // Dart needs to be notified for handles is empty.
-    int32_t contextId = eventTargetInstance->_hostClass->contextId;
 
-    NativeString args_01{};
-    buildUICommandArgs(eventType, args_01);
-
-    auto EventTarget = reinterpret_cast<JSEventTarget *>(eventTargetInstance->_hostClass);
-    auto isJsOnlyEvent =
-      std::find(EventTarget->m_jsOnlyEvents.begin(), EventTarget->m_jsOnlyEvents.end(), eventType) != EventTarget->m_jsOnlyEvents.end();
-
-    if (!isJsOnlyEvent) {
-      foundation::UICommandBuffer::instance(contextId)->addCommand(
-        eventTargetInstance->eventTargetId, UICommand::removeEvent, args_01, nullptr);
-    };
+    auto before = eventTargetInstance->dartListenerState(eventType);
+    eventTargetInstance->removeEventListenerAt(i);
+    // Dart needs to be notified when handlers are empty, or only passive ones are left.
+    eventTargetInstance->updateDartEventListener(eventType, before);
+    break;
   }
 
   return nullptr;
@@ -272,25 +294,39 @@ JSValueRef JSEventTarget::dispatchEvent(JSContextRef ctx, JSObjectRef function,
 }
 
 bool EventTargetInstance::dispatchEvent(EventInstance *event) {
-  std::u16string u16EventType = std::u16string(reinterpret_cast<const char16_t *>(event->nativeEvent->type->string),
-                                            event->nativeEvent->type->length);
-  std::string eventType = toUTF8(u16EventType);
+  NativeString *type = event->nativeEvent->type;
+  JSStringRef eventType = context->atom(reinterpret_cast<const JSChar *>(type->string), type->length);
 
-  // Modify the currentTarget to this.
-  event->nativeEvent->currentTarget = this;
+  // The path is fixed before any listener runs, moving nodes in listeners does not change it. Targets are
+  // protected until the dispatch ends, listeners may drop the last reference of a detached node.
+  ::foundation::SmallVector<EventTargetInstance *, 32> path;
+  for (EventTargetInstance *target = this; target != nullptr; target = target->parentEventTarget()) {
+    JSValueProtect(ctx, target->object);
+    path.push_back(target);
+  }
 
-  internalDispatchEvent(event);
+  for (uint32_t i = path.size() - 1; i > 0 && !event->_propagationStopped; i--) {
+    event->_eventPhase = EventInstance::CAPTURING_PHASE;
+    path[i]->invokeEventListeners(eventType, event);
+  }
 
-  // Bubble event to root event target.
-  if (event->nativeEvent->bubbles == 1 && !event->_propagationStopped) {
-    auto node = reinterpret_cast<NodeInstance *>(event->nativeEvent->currentTarget);
-    NodeInstance* parent = node->parentNode;
+  if (!event->_propagationStopped) {
+    event->_eventPhase = EventInstance::AT_TARGET;
+    invokeEventListeners(eventType, event);
+  }
 
-    if (parent != nullptr) {
-      parent->dispatchEvent(event);
+  if (event->nativeEvent->bubbles == 1) {
+    for (uint32_t i = 1; i < path.size() && !event->_propagationStopped; i++) {
+      event->_eventPhase = EventInstance::BUBBLING_PHASE;
+      path[i]->invokeEventListeners(eventType, event);
     }
   }
 
+  event->_eventPhase = EventInstance::NONE;
+  for (auto target : path) {
+    JSValueUnprotect(ctx, target->object);
+  }
+
   return event->_cancelled;
 }
 
@@ -299,13 +335,14 @@ JSValueRef JSEventTarget::clearListeners(JSContextRef ctx, JSObjectRef function,
   auto eventTargetInstance = static_cast<EventTargetInstance *>(JSObjectGetPrivate(thisObject));
   assert_m(eventTargetInstance != nullptr, "this object is not a instance of eventTarget.");
 
-  for (auto &it : eventTargetInstance->_eventHandlers) {
-    for (auto &handler : it.second) {
-      JSValueUnprotect(eventTargetInstance->_hostClass->ctx, handler);
-    }
+  auto &listeners = eventTargetInstance->m_eventListeners;
+  for (uint32_t i = listeners.size(); i > 0; i--) {
+    if (listeners[i - 1].isPropertyHandler || listeners[i - 1].callback == nullptr) continue;
+    JSStringRef eventType = listeners[i - 1].type;
+    auto before = eventTargetInstance->dartListenerState(eventType);
+    eventTargetInstance->removeEventListenerAt(i - 1);
+    eventTargetInstance->updateDartEventListener(eventType, before);
   }
-
-  eventTargetInstance->_eventHandlers.clear();
   return nullptr;
 }
 
@@ -314,8 +351,7 @@ JSValueRef EventTargetInstance::getProperty(std::string &name, JSValueRef *excep
   auto &prototypePropertyMap = JSEventTarget::getEventTargetPrototypePropertyMap();
 
   if (prototypePropertyMap.count(name) > 0) {
-    JSStringHolder nameStringHolder = JSStringHolder(context, name);
-    return JSObjectGetProperty(ctx, prototype<JSEventTarget>()->prototypeObject, nameStringHolder.getString(), exception);
+    return JSObjectGetProperty(ctx, prototype<JSEventTarget>()->prototypeObject, context->atom(name), exception);
   }
 
   if (propertyMap.count(name) > 0) {
@@ -347,46 +383,33 @@ bool EventTargetInstance::setProperty(std::string &name, JSValueRef value, JSVal
 }
 
 JSValueRef EventTargetInstance::getPropertyHandler(std::string &name, JSValueRef *exception) {
-  std::string eventType = name.substr(2);
-
-  if (_propertyEventHandler.count(eventType) == 0) {
+  int32_t index = indexOfPropertyHandler(context->atom(name.substr(2)));
+  if (index < 0) {
     return JSValueMakeNull(ctx);
   }
-  return _propertyEventHandler[eventType];
+  return m_eventListeners[index].callback;
 }
 
-void EventTargetInstance::setPropertyHandler(std::string &name, JSValueRef value,
-                                                            JSValueRef *exception) {
-  std::string eventType = name.substr(2);
+void EventTargetInstance::setPropertyHandler(std::string &name, JSValueRef value, JSValueRef *exception) {
+  JSStringRef eventType = context->atom(name.substr(2));
+  auto before = dartListenerState(eventType);
 
   // We need to remove previous eventHandler when setting new eventHandler with same eventType.
-  if (_propertyEventHandler.count(eventType) > 0) {
-    JSValueUnprotect(ctx, _propertyEventHandler[eventType]);
-    _propertyEventHandler.erase(eventType);
+  int32_t index = indexOfPropertyHandler(eventType);
+  if (index >= 0) {
+    removeEventListenerAt(index);
   }
 
   // When evaluate scripts like 'element.onclick = null', we needs to remove the event handlers callbacks
-  if (JSValueIsNull(ctx, value)) {
-    return;
+  if (!JSValueIsNull(ctx, value)) {
+    JSObjectRef handlerObjectRef = JSValueToObject(_hostClass->ctx, value, exception);
+    if (handlerObjectRef != nullptr) {
+      JSValueProtect(_hostClass->ctx, handlerObjectRef);
+      m_eventListeners.push_back({eventType, handlerObjectRef, false, false, true});
+    }
   }
 
-  JSObjectRef handlerObjectRef = JSValueToObject(_hostClass->ctx, value, exception);
-  JSValueProtect(_hostClass->ctx, handlerObjectRef);
-  _propertyEventHandler[eventType] = handlerObjectRef;
-
-  auto Event = reinterpret_cast<JSEventTarget *>(_hostClass);
-  auto isJsOnlyEvent = std::find(Event->m_jsOnlyEvents.begin(), Event->m_jsOnlyEvents.end(), name.substr(2)) !=
-                       Event->m_jsOnlyEvents.end();
-
-  if (isJsOnlyEvent) return;
-
-  if (_eventHandlers.empty()) {
-    int32_t contextId = _hostClass->contextId;
-    NativeString args_01{};
-    buildUICommandArgs(eventType, args_01);
-    int32_t type = JSObjectIsFunction(ctx, handlerObjectRef) ? UICommand::addEvent : UICommand::removeEvent;
-    foundation::UICommandBuffer::instance(contextId)->addCommand(eventTargetId, type, args_01, nullptr);
-  }
+  updateDartEventListener(eventType, before);
 }
 
 void EventTargetInstance::getPropertyNames(JSPropertyNameAccumulatorRef accumulator) {
@@ -399,57 +422,208 @@ void EventTargetInstance::getPropertyNames(JSPropertyNameAccumulatorRef accumula
   }
 }
 
-bool EventTargetInstance::internalDispatchEvent(EventInstance *eventInstance) {
-  std::u16string u16EventType = std::u16string(reinterpret_cast<const char16_t *>(eventInstance->nativeEvent->type->string),
-                                               eventInstance->nativeEvent->type->length);
-  std::string eventType = toUTF8(u16EventType);
-  auto stack = _eventHandlers[eventType];
+EventTargetInstance::DartListenerState EventTargetInstance::dartListenerState(JSStringRef eventType) {
+  auto state = DartListenerState::NONE;
+  for (auto &listener : m_eventListeners) {
+    if (listener.type != eventType || listener.callback == nullptr) continue;
+    if (!listener.passive) return DartListenerState::ACTIVE;
+    state = DartListenerState::PASSIVE;
+  }
+  return state;
+}
 
-  // Dispatch event listeners writen by addEventListener
-  auto _dispatchEvent = [&eventInstance, this](JSObjectRef& handler) {
-    if (eventInstance->_propagationImmediatelyStopped) return;
+int32_t EventTargetInstance::indexOfPropertyHandler(JSStringRef eventType) {
+  for (uint32_t i = 0; i < m_eventListeners.size(); i++) {
+    const EventListener &listener = m_eventListeners[i];
+    if (listener.type == eventType && listener.callback != nullptr && listener.isPropertyHandler) return i;
+  }
+  return -1;
+}
+
+void EventTargetInstance::removeEventListenerAt(uint32_t index) {
+  EventListener &listener = m_eventListeners[index];
+  JSValueUnprotect(ctx, listener.callback);
+  if (m_dispatchDepth > 0) {
+    listener.callback = nullptr;
+    m_hasRemovedListeners = true;
+  } else {
+    m_eventListeners.erase(index);
+  }
+}
+
+void EventTargetInstance::updateDartEventListener(JSStringRef eventType, DartListenerState before) {
+  DartListenerState state = dartListenerState(eventType);
+  if (state == before) return;
+
+  if ((before == DartListenerState::NONE) != (state == DartListenerState::NONE)) {
+    int32_t index = subtreeListenerEventIndex(context, eventType);
+    if (index >= 0) updateSubtreeListenerCount(index, state != DartListenerState::NONE);
+  }
+
+  std::string type = JSStringToStdString(eventType);
+  auto EventTarget = reinterpret_cast<JSEventTarget *>(_hostClass);
+  auto isJsOnlyEvent = std::find(EventTarget->m_jsOnlyEvents.begin(), EventTarget->m_jsOnlyEvents.end(), type) !=
+                       EventTarget->m_jsOnlyEvents.end();
+  if (isJsOnlyEvent) return;
+
+  NativeString args_01{};
+  if (state == DartListenerState::NONE) {
+    buildUICommandAtomArgs(context, type, args_01);
+    context->commandBuffer()->addCommand(eventTargetId, UICommand::removeEvent, args_01, nullptr);
+  } else if (state == DartListenerState::ACTIVE) {
+    buildUICommandAtomArgs(context, type, args_01);
+    context->commandBuffer()->addCommand(eventTargetId, UICommand::addEvent, args_01, nullptr);
+  } else {
+    std::string passive = "passive";
+    NativeString args_02{};
+    buildUICommandAtomArgs(context, type, passive, args_01, args_02);
+    context->commandBuffer()->addCommand(eventTargetId, UICommand::addEvent, args_01, args_02, nullptr);
+  }
+}
+
+void EventTargetInstance::updateSubtreeListenerCount(uint32_t index, bool increase) {
+  // Only the first listener of a subtree changes the count of the parent, adding more stops at the first ancestor
+  // which already has listeners.
+  for (EventTargetInstance *target = this; target != nullptr; target = target->parentEventTarget()) {
+    if (target->m_subtreeListenerCounts == nullptr) {
+      target->m_subtreeListenerCounts = new uint32_t[SUBTREE_LISTENER_EVENT_COUNT]();
+    }
+    uint32_t &count = target->m_subtreeListenerCounts[index];
+    if (increase) {
+      if (count++ > 0) return;
+      target->nativeEventTarget->subtreeListenerMask |= 1u << index;
+    } else {
+      assert_m(count > 0, "Subtree listener count underflow.");
+      if (--count > 0) return;
+      target->nativeEventTarget->subtreeListenerMask &= ~(1u << index);
+    }
+  }
+}
+
+void EventTargetInstance::updateParentSubtreeListeners(EventTargetInstance *parent, bool attached) {
+  uint32_t mask = nativeEventTarget->subtreeListenerMask;
+  for (uint32_t index = 0; mask != 0; index++, mask >>= 1) {
+    if (mask & 1u) parent->updateSubtreeListenerCount(index, attached);
+  }
+}
+
+void EventTargetInstance::invokeEventListeners(JSStringRef eventType, EventInstance *eventInstance) {
+  eventInstance->nativeEvent->currentTarget = this;
+  EventInstance::EventPhase phase = eventInstance->_eventPhase;
 
+  auto _dispatchEvent = [&eventInstance, this](JSObjectRef handler) {
     JSValueRef exception = nullptr;
+    eventInstance->_exposed = true;
     const JSValueRef arguments[] = {eventInstance->object};
     // The third params `thisObject` to null equals global object.
     JSObjectCallAsFunction(_hostClass->ctx, handler, nullptr, 1, arguments, &exception);
     context->handleException(exception);
   };
 
-  for (auto &handler : stack) {
-    _dispatchEvent(handler);
-  }
-
-  // Dispatch event listener white by 'on' prefix property.
-  if (_propertyEventHandler.count(eventType) > 0) {
-    if (eventType == "error") {
-      auto _dispatchErrorEvent = [&eventInstance, this, eventType](JSObjectRef &handler) {
-        JSValueRef exception = nullptr;
-        JSValueRef errorObjectValue = getObjectPropertyValue(ctx, eventType, eventInstance->object, &exception);
-        JSObjectRef errorObject = JSValueToObject(ctx, errorObjectValue, &exception);
-        JSValueRef messageValue = getObjectPropertyValue(ctx, "message", errorObject, &exception);
-        JSValueRef sourceURLValue = getObjectPropertyValue(ctx, "sourceURL", errorObject, &exception);
-        JSValueRef lineValue = getObjectPropertyValue(ctx, "line", errorObject, &exception);
-        JSValueRef columnValue = getObjectPropertyValue(ctx, "column", errorObject, &exception);
-        const JSValueRef arguments[] = {
-          messageValue,
-          sourceURLValue,
-          lineValue,
-          columnValue,
-          errorObjectValue
-        };
-        JSObjectCallAsFunction(_hostClass->ctx, handler, nullptr, 5, arguments, &exception);
-        context->handleException(exception);
+  // Listeners are read by index: the list may be reallocated by listeners added meanwhile, but is never shorter
+  // than the snapshot size while m_dispatchDepth is set.
+  uint32_t size = m_eventListeners.size();
+  m_dispatchDepth++;
+
+  // Dispatch event listeners writen by addEventListener
+  for (uint32_t i = 0; i < size && !eventInstance->_propagationImmediatelyStopped; i++) {
+    EventListener listener = m_eventListeners[i];
+    if (listener.type != eventType || listener.callback == nullptr || listener.isPropertyHandler) continue;
+    if ((phase == EventInstance::CAPTURING_PHASE && !listener.capture) ||
+        (phase == EventInstance::BUBBLING_PHASE && listener.capture)) {
+      continue;
+    }
+    eventInstance->_inPassiveListener = listener.passive;
+    _dispatchEvent(listener.callback);
+    eventInstance->_inPassiveListener = false;
+  }
+
+  // Dispatch event listener white by 'on' prefix property, which are bubbling listeners.
+  int32_t propertyHandler = -1;
+  if (phase != EventInstance::CAPTURING_PHASE && !eventInstance->_propagationImmediatelyStopped) {
+    propertyHandler = indexOfPropertyHandler(eventType);
+  }
+  if (propertyHandler >= 0 && static_cast<uint32_t>(propertyHandler) < size) {
+    JSObjectRef handler = m_eventListeners[propertyHandler].callback;
+    if (eventType == context->atom("error")) {
+      JSValueRef exception = nullptr;
+      JSValueRef errorObjectValue = getObjectPropertyValue(ctx, "error", eventInstance->object, &exception);
+      JSObjectRef errorObject = JSValueToObject(ctx, errorObjectValue, &exception);
+      JSValueRef messageValue = getObjectPropertyValue(ctx, "message", errorObject, &exception);
+      JSValueRef sourceURLValue = getObjectPropertyValue(ctx, "sourceURL", errorObject, &exception);
+      JSValueRef lineValue = getObjectPropertyValue(ctx, "line", errorObject, &exception);
+      JSValueRef columnValue = getObjectPropertyValue(ctx, "column", errorObject, &exception);
+      const JSValueRef arguments[] = {
+        messageValue,
+        sourceURLValue,
+        lineValue,
+        columnValue,
+        errorObjectValue
       };
-      _dispatchErrorEvent(_propertyEventHandler[eventType]);
+      JSObjectCallAsFunction(_hostClass->ctx, handler, nullptr, 5, arguments, &exception);
+      context->handleException(exception);
     } else {
-      _dispatchEvent(_propertyEventHandler[eventType]);
+      _dispatchEvent(handler);
     }
   }
 
-  // do not dispatch event when event has been canceled
-  // true is prevented.
-  return eventInstance->_cancelled;
+  if (--m_dispatchDepth == 0 && m_hasRemovedListeners) compactEventListeners();
+}
+
+void EventTargetInstance::compactEventListeners() {
+  uint32_t size = 0;
+  for (uint32_t i = 0; i < m_eventListeners.size(); i++) {
+    if (m_eventListeners[i].callback != nullptr) m_eventListeners[size++] = m_eventListeners[i];
+  }
+  m_eventListeners.shrink(size);
+  m_hasRemovedListeners = false;
+}
+
+bool JSEventTarget::isContinuousEvent(JSStringRef eventType) {
+  return eventType == context->atom(EVENT_TOUCH_MOVE) || eventType == context->atom(EVENT_SCROLL);
+}
+
+void JSEventTarget::queueContinuousEvent(EventTargetInstance *target, JSStringRef eventType, EventInstance *event) {
+  JSValueProtect(ctx, event->object);
+  for (auto &queued : m_queuedEvents) {
+    if (queued.target != target || queued.type != eventType) continue;
+    // The folded events stay protected, they are owned by the new event now.
+    event->_coalescedEvents.swap(queued.event->_coalescedEvents);
+    event->_coalescedEvents.emplace_back(queued.event);
+    queued.event = event;
+    return;
+  }
+
+  JSValueProtect(ctx, target->object);
+  m_queuedEvents.push_back({target, eventType, event});
+  if (m_frameRequested) return;
+
+  m_frameRequested = true;
+  int32_t requestId = getDartMethod()->requestAnimationFrame(
+    context, contextId, [](void *ptr, int32_t contextId, double highResTimeStamp, const char *errmsg) {
+      auto context = static_cast<JSContext *>(ptr);
+      if (!checkContext(contextId, context) || !context->isValid()) return;
+      JSEventTarget::instance(context)->flushContinuousEvents();
+    });
+  // `-1` represents some error occurred, events can not wait for a frame which never comes.
+  if (requestId == -1) flushContinuousEvents();
+}
+
+void JSEventTarget::flushContinuousEvents() {
+  m_frameRequested = false;
+  if (m_queuedEvents.empty()) return;
+
+  std::vector<QueuedEvent> queuedEvents;
+  queuedEvents.swap(m_queuedEvents);
+  for (auto &queued : queuedEvents) {
+    JSObjectRef eventObject = queued.event->object;
+    queued.target->dispatchEvent(queued.event);
+    if (!queued.event->_exposed) {
+      queued.event->prototype<JSEvent>()->recycleEventInstance(queued.event);
+    }
+    JSValueUnprotect(ctx, eventObject);
+    JSValueUnprotect(ctx, queued.target->object);
+  }
 }
 
 // This function will be called back by dart side when trigger events.
@@ -458,12 +632,33 @@ void NativeEventTarget::dispatchEventImpl(NativeEventTarget *nativeEventTarget,
   assert_m(nativeEventTarget->instance != nullptr, "NativeEventTarget should have owner");
   EventTargetInstance *eventTargetInstance = nativeEventTarget->instance;
   JSContext *context = eventTargetInstance->context;
-  std::u16string u16EventType = std::u16string(reinterpret_cast<const char16_t *>(nativeEventType->string),
-                                               nativeEventType->length);
-  std::string eventType = toUTF8(u16EventType);
+#if defined(IS_TEST)
+  JSEventTarget::instance(context)->dispatchedEventCount++;
+#endif
+  JSStringRef eventType =
+    context->atom(reinterpret_cast<const JSChar *>(nativeEventType->string), nativeEventType->length);
+  // Scrolling and resizing change geometry without any layout command from js side.
+  if (eventType == context->atom("scroll") || eventType == context->atom("resize")) {
+    foundation::UIGeometrySnapshot::instance(context->getContextId())->invalidate();
+  }
   EventInstance *eventInstance = JSEvent::buildEventInstance(eventType, context, nativeEvent, isCustomEvent == 1);
   eventInstance->nativeEvent->target = eventTargetInstance;
+
+  // Coalescing needs frame callbacks from dart side.
+  auto EventTarget = JSEventTarget::instance(context);
+  if (isCustomEvent != 1 && getDartMethod()->requestAnimationFrame != nullptr &&
+      EventTarget->isContinuousEvent(eventType)) {
+    EventTarget->queueContinuousEvent(eventTargetInstance, eventType, eventInstance);
+    return;
+  }
+  // Other events must not overtake the queued ones, a touchend comes after the last touchmove.
+  EventTarget->flushContinuousEvents();
+
   eventTargetInstance->dispatchEvent(eventInstance);
+  // Events no listener has seen are freed now, such as touchmove streams after the listeners are removed.
+  if (!eventInstance->_exposed) {
+    eventInstance->prototype<JSEvent>()->recycleEventInstance(eventInstance);
+  }
 }
 
 } // namespace kraken::binding::jsc
@@ -4,6 +4,7 @@
  */
 
 #include "close_event.h"
+#include "close_event_binding.h"
 
 namespace kraken::binding::jsc {
 
@@ -12,13 +13,14 @@ void bindCloseEvent(std::unique_ptr<JSContext> &context) {
   JSC_GLOBAL_SET_PROPERTY(context, "CloseEvent", event->classObject);
 };
 
-std::unordered_map<JSContext *, JSCloseEvent *> JSCloseEvent::instanceMap{};
 
 JSCloseEvent::~JSCloseEvent() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSCloseEvent, this);
 }
 
-JSCloseEvent::JSCloseEvent(JSContext *context) : JSEvent(context, "CloseEvent") {}
+JSCloseEvent::JSCloseEvent(JSContext *context) : JSEvent(context, "CloseEvent") {
+  defineInstanceStaticValues(getCloseEventStaticValues());
+}
 
 JSObjectRef JSCloseEvent::instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
                                               const JSValueRef *arguments, JSValueRef *exception) {
@@ -44,9 +46,9 @@ JSValueRef JSCloseEvent::getProperty(std::string &name, JSValueRef *exception) {
 
 CloseEventInstance::CloseEventInstance(JSCloseEvent *jsCloseEvent, NativeCloseEvent *nativeCloseEvent)
   : EventInstance(jsCloseEvent, nativeCloseEvent->nativeEvent), nativeCloseEvent(nativeCloseEvent) {
-  code = nativeCloseEvent->code;
+  m_code = nativeCloseEvent->code;
   m_reason.setString(nativeCloseEvent->reason);
-  wasClean = nativeCloseEvent->wasClean == 1;
+  m_wasClean = nativeCloseEvent->wasClean == 1;
 }
 
 CloseEventInstance::CloseEventInstance(JSCloseEvent *jsCloseEvent, JSStringRef data, JSValueRef closeEventInit, JSValueRef *exception)
@@ -67,49 +69,28 @@ CloseEventInstance::CloseEventInstance(JSCloseEvent *jsCloseEvent, JSStringRef d
   }
 }
 
-JSValueRef CloseEventInstance::getProperty(std::string &name, JSValueRef *exception) {
-  auto &propertyMap = JSCloseEvent::getCloseEventPropertyMap();
-
-  if (propertyMap.count(name) == 0) return EventInstance::getProperty(name, exception);
+double CloseEventInstance::code() {
+  return m_code;
+}
 
-  auto &property = propertyMap[name];
-  switch(property) {
-  case JSCloseEvent::CloseEventProperty::code:
-    return JSValueMakeNumber(ctx, code);
-  case JSCloseEvent::CloseEventProperty::reason:
-    return m_reason.makeString();
-  case JSCloseEvent::CloseEventProperty::wasClean:
-    return JSValueMakeBoolean(ctx, wasClean);
-  }
+void CloseEventInstance::setCode(double value) {
+  m_code = value;
+}
 
-  return nullptr;
+JSValueRef CloseEventInstance::reason() {
+  return m_reason.makeString();
 }
 
-bool CloseEventInstance::setProperty(std::string &name, JSValueRef value, JSValueRef *exception) {
-  auto &propertyMap = JSCloseEvent::getCloseEventPropertyMap();
-  if (propertyMap.count(name) > 0) {
-    auto &property = propertyMap[name];
+void CloseEventInstance::setReason(JSStringRef value) {
+  m_reason.setString(value);
+}
 
-    switch (property) {
+bool CloseEventInstance::wasClean() {
+  return m_wasClean;
+}
 
-    case JSCloseEvent::CloseEventProperty::code: {
-      code = JSValueToNumber(ctx, value, exception);
-      break;
-    }
-    case JSCloseEvent::CloseEventProperty::reason: {
-      JSStringRef str = JSValueToStringCopy(ctx, value, exception);
-      m_reason.setString(str);
-      break;
-    }
-    case JSCloseEvent::CloseEventProperty::wasClean: {
-      wasClean = JSValueToBoolean(ctx, value);
-      break;
-    }
-    }
-    return true;
-  } else {
-    return EventInstance::setProperty(name, value, exception);
-  }
+void CloseEventInstance::setWasClean(bool value) {
+  m_wasClean = value;
 }
 
 CloseEventInstance::~CloseEventInstance() {
@@ -117,12 +98,4 @@ CloseEventInstance::~CloseEventInstance() {
   delete nativeCloseEvent;
 }
 
-void CloseEventInstance::getPropertyNames(JSPropertyNameAccumulatorRef accumulator) {
-  EventInstance::getPropertyNames(accumulator);
-
-  for (auto &property : JSCloseEvent::getCloseEventPropertyNames()) {
-    JSPropertyNameAccumulatorAddName(accumulator, property);
-  }
-}
-
 } // namespace kraken::binding::jsc
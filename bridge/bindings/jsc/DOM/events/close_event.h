@@ -20,9 +20,6 @@ struct NativeCloseEvent;
 
 class JSCloseEvent : public JSEvent {
 public:
-  DEFINE_OBJECT_PROPERTY(CloseEvent, 3, code, reason, wasClean)
-
-  static std::unordered_map<JSContext *, JSCloseEvent *> instanceMap;
   OBJECT_INSTANCE(JSCloseEvent)
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -41,16 +38,21 @@ public:
   CloseEventInstance() = delete;
   explicit CloseEventInstance(JSCloseEvent *jsCloseEvent, NativeCloseEvent *nativeCloseEvent);
   explicit CloseEventInstance(JSCloseEvent *jsCloseEvent, JSStringRef data, JSValueRef closeEventInit, JSValueRef *exception);
-  JSValueRef getProperty(std::string &name, JSValueRef *exception) override;
-  bool setProperty(std::string &name, JSValueRef value, JSValueRef *exception) override;
-  void getPropertyNames(JSPropertyNameAccumulatorRef accumulator) override;
   ~CloseEventInstance() override;
 
+  // Accessors of close_event.idl attributes.
+  double code();
+  void setCode(double value);
+  JSValueRef reason();
+  void setReason(JSStringRef value);
+  bool wasClean();
+  void setWasClean(bool value);
+
   NativeCloseEvent *nativeCloseEvent;
 
 private:
-  double code;
-  bool wasClean;
+  double m_code{0};
+  bool m_wasClean{false};
   JSStringHolder m_reason{context, ""};
 };
 
@@ -4,6 +4,7 @@
  */
 
 #include "gesture_event.h"
+#include "gesture_event_binding.h"
 
 #include <utility>
 
@@ -14,13 +15,14 @@ void bindGestureEvent(std::unique_ptr<JSContext> &context) {
   JSC_GLOBAL_SET_PROPERTY(context, "GestureEvent", GestureEvent->classObject);
 };
 
-std::unordered_map<JSContext *, JSGestureEvent *> JSGestureEvent::instanceMap{};
 
 JSGestureEvent::~JSGestureEvent() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSGestureEvent, this);
 }
 
-JSGestureEvent::JSGestureEvent(JSContext *context) : JSEvent(context, "GestureEvent") {}
+JSGestureEvent::JSGestureEvent(JSContext *context) : JSEvent(context, "GestureEvent") {
+  defineInstanceStaticValues(getGestureEventStaticValues());
+}
 
 JSObjectRef JSGestureEvent::instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
                                                 const JSValueRef *arguments, JSValueRef *exception) {
@@ -97,72 +99,77 @@ GestureEventInstance::GestureEventInstance(JSGestureEvent *jsGestureEvent, Nativ
 }
 
 JSValueRef GestureEventInstance::getProperty(std::string &name, JSValueRef *exception) {
-  auto &propertyMap = JSGestureEvent::getGestureEventPropertyMap();
   auto &prototypePropertyMap = JSGestureEvent::getGestureEventPrototypePropertyMap();
 
   if (prototypePropertyMap.count(name) > 0) {
-    return JSObjectGetProperty(ctx, prototype<JSEventTarget>()->prototypeObject,
-                               JSStringCreateWithUTF8CString(name.c_str()), exception);
+    return JSObjectGetProperty(ctx, prototype<JSEventTarget>()->prototypeObject, context->atom(name), exception);
   }
 
-  if (propertyMap.count(name) == 0) return EventInstance::getProperty(name, exception);
-  auto &property = propertyMap[name];
-
-  switch (property) {
-  case JSGestureEvent::GestureEventProperty::state:
-    return m_state.value();
-  case JSGestureEvent::GestureEventProperty::direction:
-    return m_direction.value();
-  case JSGestureEvent::GestureEventProperty::deltaX:
-    return m_deltaX.value();
-  case JSGestureEvent::GestureEventProperty::deltaY:
-    return m_deltaY.value();
-  case JSGestureEvent::GestureEventProperty::velocityX:
-    return m_velocityX.value();
-  case JSGestureEvent::GestureEventProperty::velocityY:
-    return m_velocityY.value();
-  case JSGestureEvent::GestureEventProperty::scale:
-    return m_scale.value();
-  case JSGestureEvent::GestureEventProperty::rotation:
-    return m_rotation.value();
-  }
+  return EventInstance::getProperty(name, exception);
+}
 
-  return nullptr;
+JSValueRef GestureEventInstance::state() {
+  return m_state.value();
 }
 
-bool GestureEventInstance::setProperty(std::string &name, JSValueRef value, JSValueRef *exception) {
-  auto &propertyMap = JSGestureEvent::getGestureEventPropertyMap();
-  if (propertyMap.count(name) > 0) {
-    auto property = propertyMap[name];
+void GestureEventInstance::setState(JSValueRef value) {
+  m_state.setValue(value);
+}
 
-    if (property == JSGestureEvent::GestureEventProperty::state) {
-      m_state.setValue(value);
-    }
-    if (property == JSGestureEvent::GestureEventProperty::direction) {
-      m_direction.setValue(value);
-    }
-    if (property == JSGestureEvent::GestureEventProperty::deltaX) {
-      m_deltaX.setValue(value);
-    }
-    if (property == JSGestureEvent::GestureEventProperty::deltaY) {
-      m_deltaY.setValue(value);
-    }
-    if (property == JSGestureEvent::GestureEventProperty::velocityX) {
-      m_velocityX.setValue(value);
-    }
-    if (property == JSGestureEvent::GestureEventProperty::velocityY) {
-      m_velocityY.setValue(value);
-    }
-    if (property == JSGestureEvent::GestureEventProperty::scale) {
-      m_scale.setValue(value);
-    }
-    if (property == JSGestureEvent::GestureEventProperty::rotation) {
-      m_rotation.setValue(value);
-    }
-    return true;
-  } else {
-    return EventInstance::setProperty(name, value, exception);
-  }
+JSValueRef GestureEventInstance::direction() {
+  return m_direction.value();
+}
+
+void GestureEventInstance::setDirection(JSValueRef value) {
+  m_direction.setValue(value);
+}
+
+JSValueRef GestureEventInstance::deltaX() {
+  return m_deltaX.value();
+}
+
+void GestureEventInstance::setDeltaX(JSValueRef value) {
+  m_deltaX.setValue(value);
+}
+
+JSValueRef GestureEventInstance::deltaY() {
+  return m_deltaY.value();
+}
+
+void GestureEventInstance::setDeltaY(JSValueRef value) {
+  m_deltaY.setValue(value);
+}
+
+JSValueRef GestureEventInstance::velocityX() {
+  return m_velocityX.value();
+}
+
+void GestureEventInstance::setVelocityX(JSValueRef value) {
+  m_velocityX.setValue(value);
+}
+
+JSValueRef GestureEventInstance::velocityY() {
+  return m_velocityY.value();
+}
+
+void GestureEventInstance::setVelocityY(JSValueRef value) {
+  m_velocityY.setValue(value);
+}
+
+JSValueRef GestureEventInstance::scale() {
+  return m_scale.value();
+}
+
+void GestureEventInstance::setScale(JSValueRef value) {
+  m_scale.setValue(value);
+}
+
+JSValueRef GestureEventInstance::rotation() {
+  return m_rotation.value();
+}
+
+void GestureEventInstance::setRotation(JSValueRef value) {
+  m_rotation.setValue(value);
 }
 
 JSValueRef JSGestureEvent::initGestureEvent(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
@@ -224,12 +231,4 @@ JSValueRef JSGestureEvent::initGestureEvent(JSContextRef ctx, JSObjectRef functi
 
 GestureEventInstance::~GestureEventInstance() {}
 
-void GestureEventInstance::getPropertyNames(JSPropertyNameAccumulatorRef accumulator) {
-  EventInstance::getPropertyNames(accumulator);
-
-  for (auto &property : JSGestureEvent::getGestureEventPropertyNames()) {
-    JSPropertyNameAccumulatorAddName(accumulator, property);
-  }
-}
-
 } // namespace kraken::binding::jsc
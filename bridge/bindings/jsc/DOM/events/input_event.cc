@@ -4,6 +4,7 @@
  */
 
 #include "input_event.h"
+#include "input_event_binding.h"
 
 namespace kraken::binding::jsc {
 
@@ -12,13 +13,14 @@ void bindInputEvent(std::unique_ptr<JSContext> &context) {
   JSC_GLOBAL_SET_PROPERTY(context, "InputEvent", event->classObject);
 };
 
-std::unordered_map<JSContext *, JSInputEvent *> JSInputEvent::instanceMap{};
 
 JSInputEvent::~JSInputEvent() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSInputEvent, this);
 }
 
-JSInputEvent::JSInputEvent(JSContext *context) : JSEvent(context, "InputEvent") {}
+JSInputEvent::JSInputEvent(JSContext *context) : JSEvent(context, "InputEvent") {
+  defineInstanceStaticValues(getInputEventStaticValues());
+}
 
 JSObjectRef JSInputEvent::instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
                                               const JSValueRef *arguments, JSValueRef *exception) {
@@ -65,42 +67,20 @@ InputEventInstance::InputEventInstance(JSInputEvent *jsInputEvent, JSStringRef d
   }
 }
 
-JSValueRef InputEventInstance::getProperty(std::string &name, JSValueRef *exception) {
-  auto &propertyMap = JSInputEvent::getInputEventPropertyMap();
-
-  if (propertyMap.count(name) == 0) return EventInstance::getProperty(name, exception);
-
-  auto &property = propertyMap[name];
-  if (property == JSInputEvent::InputEventProperty::inputType) {
-    return m_inputType.makeString();
-  } else if (property == JSInputEvent::InputEventProperty::data) {
-    return m_data.makeString();
-  }
+JSValueRef InputEventInstance::inputType() {
+  return m_inputType.makeString();
+}
 
-  return nullptr;
+void InputEventInstance::setInputType(JSStringRef value) {
+  m_inputType.setString(value);
 }
 
-bool InputEventInstance::setProperty(std::string &name, JSValueRef value, JSValueRef *exception) {
-  auto &propertyMap = JSInputEvent::getInputEventPropertyMap();
-  if (propertyMap.count(name) > 0) {
-    auto &property = propertyMap[name];
+JSValueRef InputEventInstance::data() {
+  return m_data.makeString();
+}
 
-    switch (property) {
-    case JSInputEvent::InputEventProperty::inputType: {
-      JSStringRef str = JSValueToStringCopy(ctx, value, exception);
-      m_inputType.setString(str);
-      break;
-    }
-    case JSInputEvent::InputEventProperty::data: {
-      JSStringRef str = JSValueToStringCopy(ctx, value, exception);
-      m_data.setString(str);
-      break;
-    }
-    }
-    return true;
-  } else {
-    return EventInstance::setProperty(name, value, exception);
-  }
+void InputEventInstance::setData(JSStringRef value) {
+  m_data.setString(value);
 }
 
 InputEventInstance::~InputEventInstance() {
@@ -109,12 +89,4 @@ InputEventInstance::~InputEventInstance() {
   delete nativeInputEvent;
 }
 
-void InputEventInstance::getPropertyNames(JSPropertyNameAccumulatorRef accumulator) {
-  EventInstance::getPropertyNames(accumulator);
-
-  for (auto &property : JSInputEvent::getInputEventPropertyNames()) {
-    JSPropertyNameAccumulatorAddName(accumulator, property);
-  }
-}
-
 } // namespace kraken::binding::jsc
@@ -20,9 +20,6 @@ struct NativeInputEvent;
 
 class JSInputEvent : public JSEvent {
 public:
-  DEFINE_OBJECT_PROPERTY(InputEvent, 2, inputType, data)
-
-  static std::unordered_map<JSContext *, JSInputEvent *> instanceMap;
   OBJECT_INSTANCE(JSInputEvent)
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -41,11 +38,14 @@ public:
   InputEventInstance() = delete;
   explicit InputEventInstance(JSInputEvent *jsInputEvent, NativeInputEvent *nativeInputEvent);
   explicit InputEventInstance(JSInputEvent *jsInputEvent, JSStringRef data, JSValueRef inputEventInit, JSValueRef *exception);
-  JSValueRef getProperty(std::string &name, JSValueRef *exception) override;
-  bool setProperty(std::string &name, JSValueRef value, JSValueRef *exception) override;
-  void getPropertyNames(JSPropertyNameAccumulatorRef accumulator) override;
   ~InputEventInstance() override;
 
+  // Accessors of input_event.idl attributes.
+  JSValueRef inputType();
+  void setInputType(JSStringRef value);
+  JSValueRef data();
+  void setData(JSStringRef value);
+
   NativeInputEvent *nativeInputEvent;
 private:
   JSStringHolder m_data{context, ""};
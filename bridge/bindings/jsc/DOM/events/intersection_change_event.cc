@@ -4,6 +4,7 @@
  */
 
 #include "intersection_change_event.h"
+#include "intersection_change_event_binding.h"
 
 namespace kraken::binding::jsc {
 
@@ -12,14 +13,15 @@ void bindIntersectionChangeEvent(std::unique_ptr<JSContext> &context) {
   JSC_GLOBAL_SET_PROPERTY(context, "IntersectionChangeEvent", event->classObject);
 };
 
-std::unordered_map<JSContext *, JSIntersectionChangeEvent *> JSIntersectionChangeEvent::instanceMap{};
 
 JSIntersectionChangeEvent::~JSIntersectionChangeEvent() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSIntersectionChangeEvent, this);
 }
 
 JSIntersectionChangeEvent::JSIntersectionChangeEvent(JSContext *context)
-  : JSEvent(context, "IntersectionChangeEvent") {}
+  : JSEvent(context, "IntersectionChangeEvent") {
+  defineInstanceStaticValues(getIntersectionChangeEventStaticValues());
+}
 
 JSObjectRef JSIntersectionChangeEvent::instanceConstructor(JSContextRef ctx, JSObjectRef constructor,
                                                            size_t argumentCount, const JSValueRef *arguments,
@@ -43,7 +45,7 @@ IntersectionChangeEventInstance::IntersectionChangeEventInstance(
   JSIntersectionChangeEvent *jsIntersectionChangeEvent, NativeIntersectionChangeEvent *nativeIntersectionChangeEvent)
   : EventInstance(jsIntersectionChangeEvent, nativeIntersectionChangeEvent->nativeEvent),
     nativeIntersectionChangeEvent(nativeIntersectionChangeEvent) {
-  intersectionRatio = nativeIntersectionChangeEvent->intersectionRatio;
+  m_intersectionRatio = nativeIntersectionChangeEvent->intersectionRatio;
 }
 
 IntersectionChangeEventInstance::IntersectionChangeEventInstance(JSIntersectionChangeEvent *jsIntersectionChangeEvent,
@@ -52,43 +54,16 @@ IntersectionChangeEventInstance::IntersectionChangeEventInstance(JSIntersectionC
   nativeIntersectionChangeEvent = new NativeIntersectionChangeEvent(nativeEvent);
 }
 
-JSValueRef IntersectionChangeEventInstance::getProperty(std::string &name, JSValueRef *exception) {
-  auto &propertyMap = JSIntersectionChangeEvent::getIntersectionChangePropertyMap();
-
-  if (propertyMap.count(name) == 0) return EventInstance::getProperty(name, exception);
-
-  auto &&property = propertyMap[name];
-  if (property == JSIntersectionChangeEvent::IntersectionChangeProperty::intersectionRatio) {
-    return JSValueMakeNumber(ctx, intersectionRatio);
-  }
-
-  return nullptr;
+double IntersectionChangeEventInstance::intersectionRatio() {
+  return m_intersectionRatio;
 }
 
-bool IntersectionChangeEventInstance::setProperty(std::string &name, JSValueRef value, JSValueRef *exception) {
-  auto &propertyMap = JSIntersectionChangeEvent::getIntersectionChangePropertyMap();
-  if (propertyMap.count(name) > 0) {
-    auto &&property = propertyMap[name];
-
-    if (property == JSIntersectionChangeEvent::IntersectionChangeProperty::intersectionRatio) {
-      intersectionRatio = JSValueToNumber(ctx, value, exception);
-    }
-    return true;
-  } else {
-    return EventInstance::setProperty(name, value, exception);
-  }
+void IntersectionChangeEventInstance::setIntersectionRatio(double value) {
+  m_intersectionRatio = value;
 }
 
 IntersectionChangeEventInstance::~IntersectionChangeEventInstance() {
   delete nativeIntersectionChangeEvent;
 }
 
-void IntersectionChangeEventInstance::getPropertyNames(JSPropertyNameAccumulatorRef accumulator) {
-  EventInstance::getPropertyNames(accumulator);
-
-  for (auto &property : JSIntersectionChangeEvent::getIntersectionChangePropertyNames()) {
-    JSPropertyNameAccumulatorAddName(accumulator, property);
-  }
-}
-
 } // namespace kraken::binding::jsc
@@ -20,9 +20,7 @@ struct NativeIntersectionChangeEvent;
 
 class JSIntersectionChangeEvent : public JSEvent {
 public:
-  DEFINE_OBJECT_PROPERTY(IntersectionChange, 1, intersectionRatio)
 
-  static std::unordered_map<JSContext *, JSIntersectionChangeEvent *> instanceMap;
   OBJECT_INSTANCE(JSIntersectionChangeEvent)
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -41,15 +39,16 @@ public:
   IntersectionChangeEventInstance() = delete;
   explicit IntersectionChangeEventInstance(JSIntersectionChangeEvent *jsIntersectionChangeEvent, NativeIntersectionChangeEvent *nativeIntersectionChangeEvent);
   explicit IntersectionChangeEventInstance(JSIntersectionChangeEvent *jsIntersectionChangeEvent, JSStringRef data);
-  JSValueRef getProperty(std::string &name, JSValueRef *exception) override;
-  bool setProperty(std::string &name, JSValueRef value, JSValueRef *exception) override;
-  void getPropertyNames(JSPropertyNameAccumulatorRef accumulator) override;
   ~IntersectionChangeEventInstance() override;
 
+  // Accessors of intersection_change_event.idl attributes.
+  double intersectionRatio();
+  void setIntersectionRatio(double value);
+
   NativeIntersectionChangeEvent *nativeIntersectionChangeEvent;
 
 private:
-  double intersectionRatio;
+  double m_intersectionRatio{0};
 };
 
 struct NativeIntersectionChangeEvent {
@@ -4,6 +4,7 @@
  */
 
 #include "media_error_event.h"
+#include "media_error_event_binding.h"
 
 namespace kraken::binding::jsc {
 
@@ -12,13 +13,14 @@ void bindMediaErrorEvent(std::unique_ptr<JSContext> &context) {
   JSC_GLOBAL_SET_PROPERTY(context, "MediaErrorEvent", event->classObject);
 };
 
-std::unordered_map<JSContext *, JSMediaErrorEvent *> JSMediaErrorEvent::instanceMap{};
 
 JSMediaErrorEvent::~JSMediaErrorEvent() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSMediaErrorEvent, this);
 }
 
-JSMediaErrorEvent::JSMediaErrorEvent(JSContext *context) : JSEvent(context, "MediaErrorEvent") {}
+JSMediaErrorEvent::JSMediaErrorEvent(JSContext *context) : JSEvent(context, "MediaErrorEvent") {
+  defineInstanceStaticValues(getMediaErrorEventStaticValues());
+}
 
 JSObjectRef JSMediaErrorEvent::instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
                                               const JSValueRef *arguments, JSValueRef *exception) {
@@ -38,7 +40,7 @@ JSValueRef JSMediaErrorEvent::getProperty(std::string &name, JSValueRef *excepti
 
 MediaErrorEventInstance::MediaErrorEventInstance(JSMediaErrorEvent *jsMediaErrorEvent, NativeMediaErrorEvent *nativeMediaErrorEvent)
   : EventInstance(jsMediaErrorEvent, nativeMediaErrorEvent->nativeEvent), nativeMediaErrorEvent(nativeMediaErrorEvent) {
-  if (nativeMediaErrorEvent->code != 0) code = nativeMediaErrorEvent->code;
+  if (nativeMediaErrorEvent->code != 0) m_code = nativeMediaErrorEvent->code;
   if (nativeMediaErrorEvent->message != nullptr) m_message.setString(nativeMediaErrorEvent->message);
 }
 
@@ -47,42 +49,20 @@ MediaErrorEventInstance::MediaErrorEventInstance(JSMediaErrorEvent *jsMediaError
   nativeMediaErrorEvent = new NativeMediaErrorEvent(nativeEvent);
 }
 
-JSValueRef MediaErrorEventInstance::getProperty(std::string &name, JSValueRef *exception) {
-  auto &propertyMap = JSMediaErrorEvent::getMediaErrorPropertyMap();
-
-  if (propertyMap.count(name) == 0) return EventInstance::getProperty(name, exception);
-
-  auto &property = propertyMap[name];
+double MediaErrorEventInstance::code() {
+  return m_code;
+}
 
-  if (property == JSMediaErrorEvent::MediaErrorProperty::code) {
-    return JSValueMakeNumber(ctx, code);
-  } else if (property == JSMediaErrorEvent::MediaErrorProperty::message) {
-    return m_message.makeString();
-  }
+void MediaErrorEventInstance::setCode(double value) {
+  m_code = value;
+}
 
-  return nullptr;
+JSValueRef MediaErrorEventInstance::message() {
+  return m_message.makeString();
 }
 
-bool MediaErrorEventInstance::setProperty(std::string &name, JSValueRef value, JSValueRef *exception) {
-  auto &propertyMap = JSMediaErrorEvent::getMediaErrorPropertyMap();
-  if (propertyMap.count(name) > 0) {
-    auto &&property = propertyMap[name];
-
-    switch (property) {
-    case JSMediaErrorEvent::MediaErrorProperty::message: {
-      JSStringRef str = JSValueToStringCopy(ctx, value, exception);
-      m_message.setString(str);
-      break;
-    }
-    case JSMediaErrorEvent::MediaErrorProperty::code: {
-      code = JSValueToNumber(ctx, value, exception);
-      break;
-    }
-    }
-    return true;
-  } else {
-    return EventInstance::setProperty(name, value, exception);
-  }
+void MediaErrorEventInstance::setMessage(JSStringRef value) {
+  m_message.setString(value);
 }
 
 MediaErrorEventInstance::~MediaErrorEventInstance() {
@@ -90,12 +70,4 @@ MediaErrorEventInstance::~MediaErrorEventInstance() {
   delete nativeMediaErrorEvent;
 }
 
-void MediaErrorEventInstance::getPropertyNames(JSPropertyNameAccumulatorRef accumulator) {
-  EventInstance::getPropertyNames(accumulator);
-
-  for (auto &property : JSMediaErrorEvent::getMediaErrorPropertyNames()) {
-    JSPropertyNameAccumulatorAddName(accumulator, property);
-  }
-}
-
 } // namespace kraken::binding::jsc
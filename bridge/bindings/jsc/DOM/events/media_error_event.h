@@ -20,8 +20,6 @@ struct NativeMediaErrorEvent;
 
 class JSMediaErrorEvent : public JSEvent {
 public:
-  DEFINE_OBJECT_PROPERTY(MediaError, 2, code, message)
-  static std::unordered_map<JSContext *, JSMediaErrorEvent *> instanceMap;
   OBJECT_INSTANCE(JSMediaErrorEvent)
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -40,16 +38,19 @@ public:
   MediaErrorEventInstance() = delete;
   explicit MediaErrorEventInstance(JSMediaErrorEvent *jSMediaErrorEvent, NativeMediaErrorEvent *nativeMediaErrorEvent);
   explicit MediaErrorEventInstance(JSMediaErrorEvent *jsMediaErrorEvent, JSStringRef data);
-  JSValueRef getProperty(std::string &name, JSValueRef *exception) override;
-  bool setProperty(std::string &name, JSValueRef value, JSValueRef *exception) override;
-  void getPropertyNames(JSPropertyNameAccumulatorRef accumulator) override;
   ~MediaErrorEventInstance() override;
 
+  // Accessors of media_error_event.idl attributes.
+  double code();
+  void setCode(double value);
+  JSValueRef message();
+  void setMessage(JSStringRef value);
+
   NativeMediaErrorEvent *nativeMediaErrorEvent;
 
 private:
   JSStringHolder m_message{context, ""};
-  int64_t code;
+  int64_t m_code{0};
 };
 
 struct NativeMediaErrorEvent {
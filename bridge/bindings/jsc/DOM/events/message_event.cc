@@ -4,6 +4,7 @@
  */
 
 #include "message_event.h"
+#include "message_event_binding.h"
 
 #include "media_error_event.h"
 
@@ -14,13 +15,14 @@ void bindMessageEvent(std::unique_ptr<JSContext> &context) {
   JSC_GLOBAL_SET_PROPERTY(context, "MessageEvent", event->classObject);
 };
 
-std::unordered_map<JSContext *, JSMessageEvent *> JSMessageEvent::instanceMap{};
 
 JSMessageEvent::~JSMessageEvent() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSMessageEvent, this);
 }
 
-JSMessageEvent::JSMessageEvent(JSContext *context) : JSEvent(context, "MessageEvent") {}
+JSMessageEvent::JSMessageEvent(JSContext *context) : JSEvent(context, "MessageEvent") {
+  defineInstanceStaticValues(getMessageEventStaticValues());
+}
 
 JSObjectRef JSMessageEvent::instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
                                                 const JSValueRef *arguments, JSValueRef *exception) {
@@ -90,44 +92,23 @@ MessageEventInstance::MessageEventInstance(JSMessageEvent *jsMessageEvent, std::
   }
 }
 
-JSValueRef MessageEventInstance::getProperty(std::string &name, JSValueRef *exception) {
-  auto &propertyMap = JSMessageEvent::getMessageEventPropertyMap();
-
-  if (propertyMap.count(name) == 0) return EventInstance::getProperty(name, exception);
-
-  auto &property = propertyMap[name];
-
-  switch(property) {
-  case JSMessageEvent::MessageEventProperty::data:
-    return JSValueMakeFromJSONString(ctx, m_data.getString());
-  case JSMessageEvent::MessageEventProperty::origin:
-    return m_origin.makeString();
-  }
+JSValueRef MessageEventInstance::data() {
+  return JSValueMakeFromJSONString(ctx, m_data.getString());
+}
 
-  return nullptr;
+void MessageEventInstance::setData(JSValueRef value) {
+  JSStringRef str = JSValueToStringCopy(ctx, value, nullptr);
+  if (str == nullptr) return;
+  m_data.setString(str);
+  JSStringRelease(str);
 }
 
-bool MessageEventInstance::setProperty(std::string &name, JSValueRef value, JSValueRef *exception) {
-  auto &propertyMap = JSMessageEvent::getMessageEventPropertyMap();
-  if (propertyMap.count(name) > 0) {
-    auto &property = propertyMap[name];
+JSValueRef MessageEventInstance::origin() {
+  return m_origin.makeString();
+}
 
-    switch(property) {
-    case JSMessageEvent::MessageEventProperty::data: {
-      JSStringRef str = JSValueToStringCopy(ctx, value, exception);
-      m_data.setString(str);
-      break;
-    }
-    case JSMessageEvent::MessageEventProperty::origin: {
-      JSStringRef str = JSValueToStringCopy(ctx, value, exception);
-      m_origin.setString(str);
-      break;
-    }
-    }
-    return true;
-  } else {
-    return EventInstance::setProperty(name, value, exception);
-  }
+void MessageEventInstance::setOrigin(JSStringRef value) {
+  m_origin.setString(value);
 }
 
 MessageEventInstance::~MessageEventInstance() {
@@ -142,12 +123,4 @@ MessageEventInstance::~MessageEventInstance() {
   }
 }
 
-void MessageEventInstance::getPropertyNames(JSPropertyNameAccumulatorRef accumulator) {
-  EventInstance::getPropertyNames(accumulator);
-
-  for (auto &property : JSMessageEvent::getMessageEventPropertyNames()) {
-    JSPropertyNameAccumulatorAddName(accumulator, property);
-  }
-}
-
 } // namespace kraken::binding::jsc
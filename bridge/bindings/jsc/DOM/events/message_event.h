@@ -20,8 +20,6 @@ struct NativeMessageEvent;
 
 class JSMessageEvent : public JSEvent {
 public:
-  DEFINE_OBJECT_PROPERTY(MessageEvent, 2, data, origin)
-  static std::unordered_map<JSContext *, JSMessageEvent *> instanceMap;
   OBJECT_INSTANCE(JSMessageEvent)
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -41,11 +39,14 @@ public:
   explicit MessageEventInstance(JSMessageEvent *jsMessageEvent, NativeMessageEvent *nativeMessageEvent);
   explicit MessageEventInstance(JSMessageEvent *jsMessageEvent, std::string eventType, JSValueRef eventInitValueRef);
   explicit MessageEventInstance(JSMessageEvent *jsMessageEvent, std::string eventType, JSValueRef data, JSValueRef origin);
-  JSValueRef getProperty(std::string &name, JSValueRef *exception) override;
-  bool setProperty(std::string &name, JSValueRef value, JSValueRef *exception) override;
-  void getPropertyNames(JSPropertyNameAccumulatorRef accumulator) override;
   ~MessageEventInstance() override;
 
+  // Accessors of message_event.idl attributes.
+  JSValueRef data();
+  void setData(JSValueRef value);
+  JSValueRef origin();
+  void setOrigin(JSStringRef value);
+
   NativeMessageEvent *nativeMessageEvent;
 
 private:
@@ -15,10 +15,9 @@ void bindMouseEvent(std::unique_ptr<JSContext> &context) {
   JSC_GLOBAL_SET_PROPERTY(context, "MouseEvent", MouseEvent->classObject);
 };
 
-std::unordered_map<JSContext *, JSMouseEvent *> JSMouseEvent::instanceMap{};
 
 JSMouseEvent::~JSMouseEvent() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSMouseEvent, this);
 }
 
 JSMouseEvent::JSMouseEvent(JSContext *context) : JSEvent(context, "MouseEvent") {}
@@ -75,12 +74,11 @@ MouseEventInstance::MouseEventInstance(JSMouseEvent *jsMouseEvent, NativeMouseEv
 }
 
 JSValueRef MouseEventInstance::getProperty(std::string &name, JSValueRef *exception) {
-  auto propertyMap = JSMouseEvent::getMouseEventPropertyMap();
-  auto prototypePropertyMap = JSMouseEvent::getMouseEventPrototypePropertyMap();
+  auto &propertyMap = JSMouseEvent::getMouseEventPropertyMap();
+  auto &prototypePropertyMap = JSMouseEvent::getMouseEventPrototypePropertyMap();
 
   if (prototypePropertyMap.count(name) > 0) {
-    return JSObjectGetProperty(ctx, prototype<JSEventTarget>()->prototypeObject,
-                               JSStringCreateWithUTF8CString(name.c_str()), exception);
+    return JSObjectGetProperty(ctx, prototype<JSEventTarget>()->prototypeObject, context->atom(name), exception);
   }
 
   if (propertyMap.count(name) == 0) return EventInstance::getProperty(name, exception);
@@ -101,7 +99,7 @@ JSValueRef MouseEventInstance::getProperty(std::string &name, JSValueRef *except
 }
 
 bool MouseEventInstance::setProperty(std::string &name, JSValueRef value, JSValueRef *exception) {
-  auto propertyMap = JSMouseEvent::getMouseEventPropertyMap();
+  auto &propertyMap = JSMouseEvent::getMouseEventPropertyMap();
   if (propertyMap.count(name) > 0) {
     auto property = propertyMap[name];
 
@@ -15,10 +15,9 @@ void bindPopStateEvent(std::unique_ptr<JSContext> &context) {
   JSC_GLOBAL_SET_PROPERTY(context, "PopStateEvent", PopStateEvent->classObject);
 };
 
-std::unordered_map<JSContext *, JSPopStateEvent *> JSPopStateEvent::instanceMap{};
 
 JSPopStateEvent::~JSPopStateEvent() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSPopStateEvent, this);
 }
 
 JSPopStateEvent::JSPopStateEvent(JSContext *context) : JSEvent(context, "PopStateEvent") {}
@@ -63,12 +62,11 @@ PopStateEventInstance::PopStateEventInstance(JSPopStateEvent *jsPopStateEvent, N
 }
 
 JSValueRef PopStateEventInstance::getProperty(std::string &name, JSValueRef *exception) {
-  auto propertyMap = JSPopStateEvent::getPopStateEventPropertyMap();
-  auto prototypePropertyMap = JSPopStateEvent::getPopStateEventPrototypePropertyMap();
+  auto &propertyMap = JSPopStateEvent::getPopStateEventPropertyMap();
+  auto &prototypePropertyMap = JSPopStateEvent::getPopStateEventPrototypePropertyMap();
 
   if (prototypePropertyMap.count(name) > 0) {
-    return JSObjectGetProperty(ctx, prototype<JSEventTarget>()->prototypeObject,
-                               JSStringCreateWithUTF8CString(name.c_str()), exception);
+    return JSObjectGetProperty(ctx, prototype<JSEventTarget>()->prototypeObject, context->atom(name), exception);
   }
 
   if (propertyMap.count(name) == 0) return EventInstance::getProperty(name, exception);
@@ -83,7 +81,7 @@ JSValueRef PopStateEventInstance::getProperty(std::string &name, JSValueRef *exc
 }
 
 bool PopStateEventInstance::setProperty(std::string &name, JSValueRef value, JSValueRef *exception) {
-  auto propertyMap = JSPopStateEvent::getPopStateEventPropertyMap();
+  auto &propertyMap = JSPopStateEvent::getPopStateEventPropertyMap();
   if (propertyMap.count(name) > 0) {
     auto property = propertyMap[name];
 
@@ -7,15 +7,29 @@
 
 namespace kraken::binding::jsc {
 
+namespace {
+
+void releaseTouchList(JSContext *context, JSTouchList *list, NativeTouch **touches, int64_t length) {
+  if (list != nullptr) {
+    if (context->isValid()) JSValueUnprotect(context->context(), list->jsObject);
+  } else {
+    for (int64_t i = 0; i < length; i++) {
+      delete touches[i];
+    }
+  }
+  delete[] touches;
+}
+
+} // namespace
+
 void bindTouchEvent(std::unique_ptr<JSContext> &context) {
   auto event = JSTouchEvent::instance(context.get());
   JSC_GLOBAL_SET_PROPERTY(context, "TouchEvent", event->classObject);
 };
 
-std::unordered_map<JSContext *, JSTouchEvent *> JSTouchEvent::instanceMap {};
 
 JSTouchEvent::~JSTouchEvent() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSTouchEvent, this);
 }
 
 JSTouchEvent::JSTouchEvent(JSContext *context) : JSEvent(context, "TouchEvent") {}
@@ -37,11 +51,7 @@ JSValueRef JSTouchEvent::getProperty(std::string &name, JSValueRef *exception) {
 }
 
 TouchEventInstance::TouchEventInstance(JSTouchEvent *jsTouchEvent, NativeTouchEvent *nativeTouchEvent)
-  : EventInstance(jsTouchEvent, nativeTouchEvent->nativeEvent), nativeTouchEvent(nativeTouchEvent) {
-  m_touches = new JSTouchList(jsTouchEvent->context, nativeTouchEvent->touches, nativeTouchEvent->touchLength);
-  m_targetTouches = new JSTouchList(jsTouchEvent->context, nativeTouchEvent->targetTouches, nativeTouchEvent->targetTouchesLength);
-  m_changedTouches = new JSTouchList(jsTouchEvent->context, nativeTouchEvent->changedTouches, nativeTouchEvent->changedTouchesLength);
-}
+  : EventInstance(jsTouchEvent, nativeTouchEvent->nativeEvent), nativeTouchEvent(nativeTouchEvent) {}
 
 TouchEventInstance::TouchEventInstance(JSTouchEvent *jsTouchEvent, JSStringRef data)
   : EventInstance(jsTouchEvent, "touch", nullptr, nullptr) {
@@ -57,11 +67,11 @@ JSValueRef TouchEventInstance::getProperty(std::string &name, JSValueRef *except
 
   switch (property) {
   case JSTouchEvent::TouchEventProperty::touches:
-    return m_touches->jsObject;
+    return touchList(m_touches, nativeTouchEvent->touches, nativeTouchEvent->touchLength);
   case JSTouchEvent::TouchEventProperty::targetTouches:
-    return m_targetTouches->jsObject;
+    return touchList(m_targetTouches, nativeTouchEvent->targetTouches, nativeTouchEvent->targetTouchesLength);
   case JSTouchEvent::TouchEventProperty::changedTouches:
-    return m_changedTouches->jsObject;
+    return touchList(m_changedTouches, nativeTouchEvent->changedTouches, nativeTouchEvent->changedTouchesLength);
   case JSTouchEvent::TouchEventProperty::altKey:
     return JSValueMakeBoolean(ctx, nativeTouchEvent->altKey == 1);
   case JSTouchEvent::TouchEventProperty::metaKey:
@@ -84,7 +94,20 @@ bool TouchEventInstance::setProperty(std::string &name, JSValueRef value, JSValu
   }
 }
 
+JSValueRef TouchEventInstance::touchList(JSTouchList *&list, NativeTouch **touches, int64_t length) {
+  if (list == nullptr) {
+    list = new JSTouchList(context, touches, length);
+    // Kept alive by the event, reading the same list twice returns the same object.
+    JSValueProtect(ctx, list->jsObject);
+  }
+  return list->jsObject;
+}
+
 TouchEventInstance::~TouchEventInstance() {
+  releaseTouchList(context, m_touches, nativeTouchEvent->touches, nativeTouchEvent->touchLength);
+  releaseTouchList(context, m_targetTouches, nativeTouchEvent->targetTouches, nativeTouchEvent->targetTouchesLength);
+  releaseTouchList(context, m_changedTouches, nativeTouchEvent->changedTouches,
+                   nativeTouchEvent->changedTouchesLength);
   delete nativeTouchEvent;
 }
 
@@ -131,7 +154,7 @@ void JSTouchList::getPropertyNames(JSPropertyNameAccumulatorRef accumulator) {
   }
 
   for (size_t i = 0; i < m_touchList.size(); i ++) {
-    JSPropertyNameAccumulatorAddName(accumulator, JSStringCreateWithUTF8CString(std::to_string(i).c_str()));
+    JSPropertyNameAccumulatorAddName(accumulator, context->atom(std::to_string(i)));
   }
 }
 
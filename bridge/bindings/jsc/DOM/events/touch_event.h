@@ -27,7 +27,6 @@ class JSTouchEvent : public JSEvent {
 public:
   DEFINE_OBJECT_PROPERTY(TouchEvent, 7, touches, targetTouches, changedTouches, altKey, metaKey, ctrlKey, shiftKey)
 
-  static std::unordered_map<JSContext *, JSTouchEvent *> instanceMap;
   OBJECT_INSTANCE(JSTouchEvent)
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -54,9 +53,12 @@ public:
   NativeTouchEvent *nativeTouchEvent;
 
 private:
-  JSTouchList *m_touches;
-  JSTouchList *m_targetTouches;
-  JSTouchList *m_changedTouches;
+  // Touch lists are created at the first read, most listeners never read some of them.
+  JSValueRef touchList(JSTouchList *&list, NativeTouch **touches, int64_t length);
+
+  JSTouchList *m_touches{nullptr};
+  JSTouchList *m_targetTouches{nullptr};
+  JSTouchList *m_changedTouches{nullptr};
 };
 
 class JSTouchList : public HostObject {
@@ -112,19 +114,20 @@ struct NativeTouchEvent {
 
   NativeEvent *nativeEvent;
 
-  NativeTouch **touches;
-  int64_t touchLength;
+  // The arrays belong to the event, the touches belong to the event until their touch list is created.
+  NativeTouch **touches{nullptr};
+  int64_t touchLength{0};
 
-  NativeTouch **targetTouches;
-  int64_t targetTouchesLength;
+  NativeTouch **targetTouches{nullptr};
+  int64_t targetTouchesLength{0};
 
-  NativeTouch **changedTouches;
-  int64_t changedTouchesLength;
+  NativeTouch **changedTouches{nullptr};
+  int64_t changedTouchesLength{0};
 
-  int64_t altKey;
-  int64_t metaKey;
-  int64_t ctrlKey;
-  int64_t shiftKey;
+  int64_t altKey{0};
+  int64_t metaKey{0};
+  int64_t ctrlKey{0};
+  int64_t shiftKey{0};
 };
 
 } // namespace kraken::binding::jsc
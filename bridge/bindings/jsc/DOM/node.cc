@@ -16,31 +16,38 @@ void bindNode(std::unique_ptr<JSContext> &context) {
 JSNode::JSNode(JSContext *context) : JSEventTarget(context, "Node") {}
 JSNode::JSNode(JSContext *context, const char *name) : JSEventTarget(context, name) {}
 
-std::unordered_map<JSContext *, JSNode *> JSNode::instanceMap{};
 
 JSNode *JSNode::instance(JSContext *context) {
-  if (instanceMap.count(context) == 0) {
-    instanceMap[context] = new JSNode(context);
+  auto &bindingState = context->bindingState();
+  auto hostClass = bindingState.hostClass<JSNode>(BindingSlot::JSNode);
+  if (hostClass == nullptr) {
+    hostClass = new JSNode(context);
+    bindingState.setHostClass(BindingSlot::JSNode, hostClass);
   }
-  return instanceMap[context];
+  return hostClass;
 }
 
 JSNode::~JSNode() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSNode, this);
 }
 
 NodeInstance::~NodeInstance() {
+  if (m_childNodes != nullptr) m_childNodes->m_node = nullptr;
+
   // The this node is finalized, should tell all children this parent will no longer protecting them.
   if (context->isValid()) {
-    for (auto &node : childNodes) {
+    NodeInstance *next;
+    for (NodeInstance *node = m_firstChild; node != nullptr; node = next) {
+      next = node->m_nextSibling;
       node->parentNode = nullptr;
+      node->m_previousSibling = node->m_nextSibling = nullptr;
       node->unrefer();
       assert(node->_referenceCount <= 0 &&
              ("Node recycled with a dangling node " + std::to_string(node->eventTargetId)).c_str());
     }
   }
 
-  foundation::UICommandCallbackQueue::instance()->registerCallback(
+  context->commandBuffer()->registerCallback(
     [](void *ptr) { delete reinterpret_cast<NativeNode *>(ptr); }, nativeNode);
 }
 
@@ -78,59 +85,80 @@ DocumentInstance *NodeInstance::ownerDocument() {
   return document();
 }
 
-NodeInstance *NodeInstance::firstChild() {
-  if (childNodes.empty()) {
-    return nullptr;
-  }
-  return childNodes.front();
-}
+NodeInstance *NodeInstance::childAt(uint32_t index) {
+  if (index >= m_childCount) return nullptr;
 
-NodeInstance *NodeInstance::lastChild() {
-  if (childNodes.empty()) {
-    return nullptr;
+  uint32_t current = 0;
+  NodeInstance *node = m_firstChild;
+  uint32_t distance = index;
+  if (m_cachedChild != nullptr) {
+    uint32_t cachedDistance = index > m_cachedChildIndex ? index - m_cachedChildIndex : m_cachedChildIndex - index;
+    if (cachedDistance < distance) {
+      current = m_cachedChildIndex;
+      node = m_cachedChild;
+      distance = cachedDistance;
+    }
   }
-  return childNodes.back();
-}
-
-NodeInstance *NodeInstance::previousSibling() {
-  if (parentNode == nullptr) return nullptr;
-
-  auto &&parentChildNodes = parentNode->childNodes;
-  auto it = std::find(parentChildNodes.begin(), parentChildNodes.end(), this);
-
-  if (parentChildNodes.size() < 2) {
-    return nullptr;
+  if (m_childCount - 1 - index < distance) {
+    current = m_childCount - 1;
+    node = m_lastChild;
   }
 
-  if (it != parentChildNodes.begin()) {
-    return *(it - 1);
-  }
+  for (; current < index; current++) node = node->m_nextSibling;
+  for (; current > index; current--) node = node->m_previousSibling;
 
-  return nullptr;
+  m_cachedChildIndex = index;
+  m_cachedChild = node;
+  return node;
 }
 
-NodeInstance *NodeInstance::nextSibling() {
-  if (parentNode == nullptr) return nullptr;
-
-  auto &&parentChildNodes = parentNode->childNodes;
-  auto it = std::find(parentChildNodes.begin(), parentChildNodes.end(), this);
+bool NodeInstance::hasChild(NodeInstance *node) {
+  return node->parentNode == this && (node->m_previousSibling != nullptr || m_firstChild == node);
+}
 
-  if ((it + 1) != parentChildNodes.end()) {
-    return *(it + 1);
+void NodeInstance::linkChild(NodeInstance *node, NodeInstance *referenceNode) {
+  NodeInstance *previous = referenceNode != nullptr ? referenceNode->m_previousSibling : m_lastChild;
+  node->m_previousSibling = previous;
+  node->m_nextSibling = referenceNode;
+  if (previous != nullptr) {
+    previous->m_nextSibling = node;
+  } else {
+    m_firstChild = node;
   }
+  if (referenceNode != nullptr) {
+    referenceNode->m_previousSibling = node;
+  } else {
+    m_lastChild = node;
+  }
+  node->parentNode = this;
+  m_childCount++;
+  m_cachedChild = nullptr;
+}
 
-  return nullptr;
+void NodeInstance::unlinkChild(NodeInstance *node) {
+  if (node->m_previousSibling != nullptr) {
+    node->m_previousSibling->m_nextSibling = node->m_nextSibling;
+  } else {
+    m_firstChild = node->m_nextSibling;
+  }
+  if (node->m_nextSibling != nullptr) {
+    node->m_nextSibling->m_previousSibling = node->m_previousSibling;
+  } else {
+    m_lastChild = node->m_previousSibling;
+  }
+  node->m_previousSibling = node->m_nextSibling = nullptr;
+  node->parentNode = nullptr;
+  m_childCount--;
+  m_cachedChild = nullptr;
 }
 
 void NodeInstance::ensureDetached(NodeInstance *node) {
-  if (node->parentNode != nullptr) {
-    auto it = std::find(node->parentNode->childNodes.begin(), node->parentNode->childNodes.end(), node);
-    if (it != node->parentNode->childNodes.end()) {
-      node->_notifyNodeRemoved(node->parentNode);
-      node->parentNode->childNodes.erase(it);
-      node->parentNode = nullptr;
-      node->unrefer();
-    }
+  NodeInstance *parent = node->parentNode;
+  if (parent != nullptr && parent->hasChild(node)) {
+    node->_notifyNodeRemoved(parent);
+    parent->unlinkChild(node);
+    node->updateParentSubtreeListeners(parent, false);
+    node->unrefer();
   }
 }
 
@@ -155,22 +183,13 @@ JSValueRef JSNode::copyNodeValue(JSContextRef ctx, NodeInstance *node) {
     JSObjectRef attributeObjectRef = JSValueToObject(ctx, attributeValueRef, nullptr);
     auto mAttributes = reinterpret_cast<JSElementAttributes *>(JSObjectGetPrivate(attributeObjectRef));
 
-    std::map<std::string, JSValueRef> &attributesMap = mAttributes->getAttributesMap();
-    std::vector<JSValueRef> &attributesVector = mAttributes->getAttributesVector();
-
-    (*newElement->getAttributes())->setAttributesMap(attributesMap);
-    (*newElement->getAttributes())->setAttributesVector(attributesVector);
+    (*newElement->getAttributes())->copyWith(mAttributes);
 
     /* copy style */
     newElement->setStyle(element->getStyle());
 
-    std::string newNodeEventTargetId = std::to_string(newElement->eventTargetId);
-
-    NativeString args_01{};
-    buildUICommandArgs(newNodeEventTargetId, args_01);
-
-    foundation::UICommandBuffer::instance(newElement->contextId)
-      ->addCommand(element->eventTargetId, UICommand::cloneNode, args_01, nullptr);
+    newElement->context->commandBuffer()
+      ->addCommand(element->eventTargetId, UICommand::cloneNode, newElement->eventTargetId, 0, nullptr);
 
     return newElement->object;
   } else if (node->nodeType == TEXT_NODE) {
@@ -186,7 +205,7 @@ JSValueRef JSNode::copyNodeValue(JSContextRef ctx, NodeInstance *node) {
 }
 
 void JSNode::traverseCloneNode(JSContextRef ctx, NodeInstance *element, NodeInstance *parentElement) {
-  for (auto iter : element->childNodes) {
+  for (NodeInstance *iter = element->firstChild(); iter != nullptr; iter = iter->nextSibling()) {
     JSValueRef newElementRef = copyNodeValue(ctx, static_cast<NodeInstance *>(iter));
     JSObjectRef newElementObjectRef = JSValueToObject(ctx, newElementRef, nullptr);
     auto newNodeInstance = static_cast<NodeInstance *>(JSObjectGetPrivate(newElementObjectRef));
@@ -369,7 +388,7 @@ void NodeInstance::internalInsertBefore(NodeInstance *node, NodeInstance *refere
   if (referenceNode == nullptr) {
     internalAppendChild(node);
   } else {
-    if (referenceNode->parentNode != this) {
+    if (!hasChild(referenceNode)) {
       throwJSError(
         _hostClass->ctx,
         "Uncaught TypeError: Failed to execute 'insertBefore' on 'Node': reference node is not a child of this node.",
@@ -377,34 +396,24 @@ void NodeInstance::internalInsertBefore(NodeInstance *node, NodeInstance *refere
       return;
     }
 
-    ensureDetached(node);
-    auto parent = referenceNode->parentNode;
-    if (parent != nullptr) {
-      auto &&parentChildNodes = parent->childNodes;
-      auto it = std::find(parentChildNodes.begin(), parentChildNodes.end(), referenceNode);
-
-      if (it == parentChildNodes.end()) {
-        throwJSError(_hostClass->ctx,
-                     "Failed to execute 'insertBefore' on 'Node': reference node is not a child of this node.",
-                     exception);
+    // Inserting a node before itself keeps it in place, same as inserting it before its next sibling.
+    if (referenceNode == node) {
+      referenceNode = node->nextSibling();
+      if (referenceNode == nullptr) {
+        internalAppendChild(node);
         return;
       }
+    }
 
-      parentChildNodes.insert(it, node);
-      node->parentNode = parent;
-      node->refer();
-      node->_notifyNodeInsert(parent);
-
-      std::string nodeEventTargetId = std::to_string(node->eventTargetId);
-      std::string position = std::string("beforebegin");
-
-      NativeString args_01{};
-      NativeString args_02{};
-      buildUICommandArgs(nodeEventTargetId, position, args_01, args_02);
+    ensureDetached(node);
+    linkChild(node, referenceNode);
+    node->updateParentSubtreeListeners(this, true);
+    node->refer();
+    node->_notifyNodeInsert(this);
 
-      foundation::UICommandBuffer::instance(_hostClass->contextId)
-        ->addCommand(referenceNode->eventTargetId, UICommand::insertAdjacentNode, args_01, args_02, nullptr);
-    }
+    context->commandBuffer()
+      ->addCommand(referenceNode->eventTargetId, UICommand::insertAdjacentNode, node->eventTargetId,
+                   AdjacentPosition::beforeBegin, nullptr);
   }
 }
 
@@ -453,22 +462,15 @@ JSValueRef JSNode::removeChild(JSContextRef ctx, JSObjectRef function, JSObjectR
 
 void NodeInstance::internalAppendChild(NodeInstance *node) {
   ensureDetached(node);
-  childNodes.emplace_back(node);
-  node->parentNode = this;
+  linkChild(node, nullptr);
+  node->updateParentSubtreeListeners(this, true);
   node->refer();
 
   node->_notifyNodeInsert(this);
 
-  std::string nodeEventTargetId = std::to_string(node->eventTargetId);
-  std::string position = std::string("beforeend");
-
-  NativeString args_01{};
-  NativeString args_02{};
-
-  buildUICommandArgs(nodeEventTargetId, position, args_01, args_02);
-
-  foundation::UICommandBuffer::instance(node->_hostClass->contextId)
-    ->addCommand(eventTargetId, UICommand::insertAdjacentNode, args_01, args_02, nullptr);
+  node->context->commandBuffer()
+    ->addCommand(eventTargetId, UICommand::insertAdjacentNode, node->eventTargetId, AdjacentPosition::beforeEnd,
+                 nullptr);
 }
 
 void NodeInstance::internalRemove(JSValueRef *exception) {
@@ -477,14 +479,12 @@ void NodeInstance::internalRemove(JSValueRef *exception) {
 }
 
 NodeInstance *NodeInstance::internalRemoveChild(NodeInstance *node, JSValueRef *exception) {
-  auto it = std::find(childNodes.begin(), childNodes.end(), node);
-
-  if (it != childNodes.end()) {
-    childNodes.erase(it);
-    node->parentNode = nullptr;
+  if (hasChild(node)) {
+    unlinkChild(node);
+    node->updateParentSubtreeListeners(this, false);
     node->unrefer();
     node->_notifyNodeRemoved(this);
-    foundation::UICommandBuffer::instance(node->_hostClass->contextId)
+    node->context->commandBuffer()
       ->addCommand(node->eventTargetId, UICommand::removeNode, nullptr);
   }
 
@@ -493,44 +493,37 @@ NodeInstance *NodeInstance::internalRemoveChild(NodeInstance *node, JSValueRef *
 
 NodeInstance *NodeInstance::internalReplaceChild(NodeInstance *newChild, NodeInstance *oldChild,
                                                  JSValueRef *exception) {
-  ensureDetached(newChild);
-  assert_m(newChild->parentNode == nullptr, "ReplaceChild Error: newChild was not detached.");
-  oldChild->parentNode = nullptr;
-  oldChild->unrefer();
-
-  auto childIndex = std::find(childNodes.begin(), childNodes.end(), oldChild);
-  if (childIndex == childNodes.end()) {
+  if (!hasChild(oldChild)) {
     throwJSError(ctx, "Failed to execute 'replaceChild' on 'Node': old child is not exist on childNodes.", exception);
     return nullptr;
   }
+  if (newChild == oldChild) return oldChild;
+
+  ensureDetached(newChild);
+  assert_m(newChild->parentNode == nullptr, "ReplaceChild Error: newChild was not detached.");
 
-  newChild->parentNode = this;
-  childNodes.erase(childIndex);
-  childNodes.insert(childIndex, newChild);
+  linkChild(newChild, oldChild);
+  unlinkChild(oldChild);
+  oldChild->unrefer();
+  oldChild->updateParentSubtreeListeners(this, false);
+  newChild->updateParentSubtreeListeners(this, true);
   newChild->refer();
 
   oldChild->_notifyNodeRemoved(this);
   newChild->_notifyNodeInsert(this);
 
-  std::string newChildEventTargetId = std::to_string(newChild->eventTargetId);
-  std::string position = std::string("afterend");
-
-  NativeString args_01{};
-  NativeString args_02{};
-
-  buildUICommandArgs(newChildEventTargetId, position, args_01, args_02);
+  context->commandBuffer()
+    ->addCommand(oldChild->eventTargetId, UICommand::insertAdjacentNode, newChild->eventTargetId,
+                 AdjacentPosition::afterEnd, nullptr);
 
-  foundation::UICommandBuffer::instance(_hostClass->contextId)
-    ->addCommand(oldChild->eventTargetId, UICommand::insertAdjacentNode, args_01, args_02, nullptr);
-
-  foundation::UICommandBuffer::instance(_hostClass->contextId)
+  context->commandBuffer()
     ->addCommand(oldChild->eventTargetId, UICommand::removeNode, nullptr);
 
   return oldChild;
 }
 
 JSValueRef JSNode::prototypeGetProperty(std::string &name, JSValueRef *exception) {
-  auto propertyMap = getNodePropertyMap();
+  auto &propertyMap = getNodePropertyMap();
 
   if (propertyMap.count(name) == 0) {
     return JSEventTarget::prototypeGetProperty(name, exception);
@@ -544,8 +537,7 @@ JSValueRef NodeInstance::getProperty(std::string &name, JSValueRef *exception) {
   auto &prototypePropertyMap = JSNode::getNodePrototypePropertyMap();
 
   if (prototypePropertyMap.count(name) > 0) {
-    JSStringHolder nameStringHolder = JSStringHolder(context, name);
-    return JSObjectGetProperty(ctx, prototype<JSNode>()->prototypeObject, nameStringHolder.getString(), exception);
+    return JSObjectGetProperty(ctx, prototype<JSNode>()->prototypeObject, context->atom(name), exception);
   }
 
   if (propertyMap.count(name) == 0) {
@@ -582,14 +574,10 @@ JSValueRef NodeInstance::getProperty(std::string &name, JSValueRef *exception) {
     return instance != nullptr ? instance->object : JSValueMakeNull(ctx);
   }
   case JSNode::NodeProperty::childNodes: {
-    JSValueRef arguments[childNodes.size()];
-
-    for (int i = 0; i < childNodes.size(); i++) {
-      arguments[i] = childNodes[i]->object;
+    if (m_childNodes == nullptr) {
+      m_childNodes = new JSNodeList(context, this);
     }
-
-    JSObjectRef array = JSObjectMakeArray(_hostClass->ctx, childNodes.size(), arguments, nullptr);
-    return array;
+    return m_childNodes->jsObject;
   }
   case JSNode::NodeProperty::nodeType:
     return JSValueMakeNumber(_hostClass->ctx, nodeType);
@@ -603,8 +591,8 @@ JSValueRef NodeInstance::getProperty(std::string &name, JSValueRef *exception) {
 }
 
 bool NodeInstance::setProperty(std::string &name, JSValueRef value, JSValueRef *exception) {
-  auto propertyMap = JSNode::getNodePropertyMap();
-  auto prototypePropertyMap = JSNode::getNodePrototypePropertyMap();
+  auto &propertyMap = JSNode::getNodePropertyMap();
+  auto &prototypePropertyMap = JSNode::getNodePrototypePropertyMap();
 
   if (prototypePropertyMap.count(name) > 0) return false;
 
@@ -652,6 +640,53 @@ void NodeInstance::unrefer() {
   }
 }
 
+JSNodeList::JSNodeList(JSContext *context, NodeInstance *node) : HostObject(context, "NodeList"), m_node(node) {
+  JSValueProtect(ctx, node->object);
+  // childNodes used to be an array, array methods such as forEach and indexOf only read length and indexes, so they
+  // keep working on the list.
+  JSObjectRef array = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+  JSObjectSetPrototype(ctx, jsObject, JSObjectGetPrototype(ctx, array));
+}
+
+JSNodeList::~JSNodeList() {
+  if (m_node == nullptr) return;
+  m_node->m_childNodes = nullptr;
+  if (context->isValid()) JSValueUnprotect(ctx, m_node->object);
+}
+
+JSValueRef JSNodeList::getProperty(std::string &name, JSValueRef *exception) {
+  if (isNumberIndex(name)) {
+    uint64_t index = std::strtoull(name.c_str(), nullptr, 10);
+    if (m_node == nullptr || index >= m_node->childCount()) return nullptr;
+    return m_node->childAt(index)->object;
+  }
+
+  auto &propertyMap = getNodeListPropertyMap();
+  if (propertyMap.count(name) > 0) {
+    auto property = propertyMap[name];
+    switch (property) {
+    case NodeListProperty::length:
+      return JSValueMakeNumber(ctx, m_node != nullptr ? m_node->childCount() : 0);
+    }
+  }
+
+  return HostObject::getProperty(name, exception);
+}
+
+void JSNodeList::getPropertyNames(JSPropertyNameAccumulatorRef accumulator) {
+  for (auto &property : getNodeListPropertyNames()) {
+    JSPropertyNameAccumulatorAddName(accumulator, property);
+  }
+
+  // Indexes are not interned, lists may be long.
+  uint32_t count = m_node != nullptr ? m_node->childCount() : 0;
+  for (uint32_t i = 0; i < count; i++) {
+    JSStringRef index = JSStringCreateWithUTF8CString(std::to_string(i).c_str());
+    JSPropertyNameAccumulatorAddName(accumulator, index);
+    JSStringRelease(index);
+  }
+}
+
 void NodeInstance::_notifyNodeRemoved(NodeInstance *node) {}
 void NodeInstance::_notifyNodeInsert(NodeInstance *node) {}
 void NodeInstance::internalSetTextContent(JSStringRef content, JSValueRef *exception) {}
@@ -4,7 +4,7 @@
  */
 
 #include "style_declaration.h"
-#include <map>
+#include <algorithm>
 #include <vector>
 
 namespace kraken::binding::jsc {
@@ -16,32 +16,92 @@ void bindCSSStyleDeclaration(std::unique_ptr<JSContext> &context) {
 
 namespace {
 
-static std::string parseJavaScriptCSSPropertyName(std::string &propertyName) {
-  static std::unordered_map<std::string, std::string> propertyCache{};
+// Properties unknown to dart side are sent in camelCase as before, custom properties keep their names.
+std::string toCamelCasePropertyName(const std::string &name) {
+  if (name.size() > 1 && name[0] == '-' && name[1] == '-') return name;
 
-  if (propertyCache.count(propertyName) > 0) {
-    return propertyCache[propertyName];
+  std::string result;
+  result.reserve(name.size());
+  for (size_t i = 0; i < name.size(); i++) {
+    if (name[i] == '-' && i + 1 < name.size()) {
+      result += toASCIIUpper(name[++i]);
+    } else {
+      result += name[i];
+    }
   }
+  return result;
+}
 
-  std::vector<char> buffer(propertyName.size() + 1);
-
-  size_t hyphen = 0;
-  for (size_t i = 0; i < propertyName.size(); ++i) {
-    char c = propertyName[i + hyphen];
-    if (!c) break;
-    if (c == '-') {
-      hyphen++;
-      buffer[i] = toASCIIUpper(propertyName[i + hyphen]);
-    } else {
-      buffer[i] = c;
+std::string toPropertyName(const JSChar *chars, size_t length) {
+  std::string name;
+  name.reserve(length);
+  for (size_t i = 0; i < length; i++) {
+    if (JSC_UNLIKELY(chars[i] >= 0x80)) {
+      JSStringRef string = JSStringCreateWithCharacters(chars, length);
+      name = JSStringToStdString(string);
+      JSStringRelease(string);
+      return name;
     }
+    name += static_cast<char>(chars[i]);
   }
+  return name;
+}
+
+inline bool isCSSSpace(JSChar c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
 
-  buffer.emplace_back('\0');
+void trimCSSSpaces(const JSChar *&begin, const JSChar *&end) {
+  while (begin < end && isCSSSpace(*begin)) begin++;
+  while (end > begin && isCSSSpace(*(end - 1))) end--;
+}
 
-  std::string result = std::string(buffer.data());
+// Split a declaration block into name and value pairs. Semicolons and colons inside strings and functions, such as
+// url(data:...;base64,...), don't end a declaration. Declarations without a name or a colon are dropped.
+template <typename Callback> void parseDeclarationBlock(const JSChar *chars, size_t length, Callback callback) {
+  const JSChar *end = chars + length;
+  const JSChar *start = chars;
+  const JSChar *colon = nullptr;
+  JSChar quote = 0;
+  int32_t depth = 0;
+
+  for (const JSChar *p = chars; p <= end; p++) {
+    if (p < end) {
+      JSChar c = *p;
+      if (quote != 0) {
+        if (c == '\\' && p + 1 < end) {
+          p++;
+        } else if (c == quote) {
+          quote = 0;
+        }
+        continue;
+      }
+      if (c == '"' || c == '\'') {
+        quote = c;
+        continue;
+      }
+      if (c == '(') depth++;
+      if (c == ')' && depth > 0) depth--;
+      if (c == ':' && colon == nullptr && depth == 0) colon = p;
+      if (c != ';' || depth > 0) continue;
+    }
 
-  propertyCache[propertyName] = result;
+    if (colon != nullptr) {
+      const JSChar *nameBegin = start, *nameEnd = colon;
+      const JSChar *valueBegin = colon + 1, *valueEnd = p;
+      trimCSSSpaces(nameBegin, nameEnd);
+      trimCSSSpaces(valueBegin, valueEnd);
+      if (nameBegin < nameEnd) callback(nameBegin, nameEnd - nameBegin, valueBegin, valueEnd - valueBegin);
+    }
+    start = p + 1;
+    colon = nullptr;
+  }
+}
+
+JSValueRef makeStringValue(JSContextRef ctx, const std::u16string &value) {
+  JSStringRef string = JSStringCreateWithCharacters(reinterpret_cast<const JSChar *>(value.data()), value.size());
+  JSValueRef result = JSValueMakeString(ctx, string);
+  JSStringRelease(string);
   return result;
 }
 
@@ -49,17 +109,19 @@ static std::string parseJavaScriptCSSPropertyName(std::string &propertyName) {
 
 CSSStyleDeclaration::CSSStyleDeclaration(JSContext *context) : HostClass(context, "CSSStyleDeclaration") {}
 
-std::unordered_map<JSContext *, CSSStyleDeclaration *> CSSStyleDeclaration::instanceMap{};
 
 CSSStyleDeclaration *CSSStyleDeclaration::instance(JSContext *context) {
-  if (instanceMap.count(context) == 0) {
-    instanceMap[context] = new CSSStyleDeclaration(context);
+  auto &bindingState = context->bindingState();
+  auto hostClass = bindingState.hostClass<CSSStyleDeclaration>(BindingSlot::CSSStyleDeclaration);
+  if (hostClass == nullptr) {
+    hostClass = new CSSStyleDeclaration(context);
+    bindingState.setHostClass(BindingSlot::CSSStyleDeclaration, hostClass);
   }
-  return instanceMap[context];
+  return hostClass;
 }
 
 CSSStyleDeclaration::~CSSStyleDeclaration() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::CSSStyleDeclaration, this);
 }
 
 JSObjectRef CSSStyleDeclaration::instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -85,75 +147,162 @@ StyleDeclarationInstance::~StyleDeclarationInstance() {}
 
 JSValueRef StyleDeclarationInstance::getProperty(std::string &name, JSValueRef *exception) {
   auto &prototypePropertyMap = getCSSStyleDeclarationPrototypePropertyMap();
-  JSStringHolder nameStringHolder = JSStringHolder(context, name);
 
   if (prototypePropertyMap.count(name) > 0) {
-    return JSObjectGetProperty(ctx, prototype<CSSStyleDeclaration>()->prototypeObject, nameStringHolder.getString(), exception);
+    return JSObjectGetProperty(ctx, prototype<CSSStyleDeclaration>()->prototypeObject, context->atom(name), exception);
   }
 
-  if (properties.count(name) > 0) {
-    return properties[name];
+  if (getCSSStyleDeclarationPropertyMap().count(name) > 0) {
+    return cssText();
   }
 
-  return JSValueMakeString(_hostClass->ctx, JSStringCreateWithUTF8CString(""));
+  CSSPropertyID id = cssPropertyID(name);
+  Declaration *declaration = findDeclaration(id, id == CSSPropertyID::Unknown ? toCamelCasePropertyName(name) : name);
+  if (declaration != nullptr) {
+    return makeStringValue(ctx, declaration->value);
+  }
+
+  return context->atomValue(context->atom(""));
 }
 
-bool StyleDeclarationInstance::setProperty(std::string &name, JSValueRef value,
-                                                                JSValueRef *exception) {
+bool StyleDeclarationInstance::setProperty(std::string &name, JSValueRef value, JSValueRef *exception) {
+  if (getCSSStyleDeclarationPropertyMap().count(name) > 0) {
+    JSStringRef cssText = JSValueToStringCopy(ctx, value, exception);
+    if (cssText == nullptr) return false;
+    setCssText(JSStringGetCharactersPtr(cssText), JSStringGetLength(cssText));
+    JSStringRelease(cssText);
+    return true;
+  }
+
   return internalSetProperty(name, value, exception);
 }
 
-bool StyleDeclarationInstance::internalSetProperty(std::string &name, JSValueRef value,
-                                                                        JSValueRef *exception) {
+bool StyleDeclarationInstance::internalSetProperty(std::string &name, JSValueRef value, JSValueRef *exception) {
   auto &prototypePropertyMap = getCSSStyleDeclarationPrototypePropertyMap();
   if (prototypePropertyMap.count(name) > 0) return false;
 
   JSStringRef valueStr;
-  if (JSValueIsNull(_hostClass->ctx, value)) {
+  if (JSValueIsNull(ctx, value)) {
     valueStr = JSStringCreateWithUTF8CString("");
   } else {
-    valueStr = JSValueToStringCopy(_hostClass->ctx, value, exception);
+    valueStr = JSValueToStringCopy(ctx, value, exception);
+    if (valueStr == nullptr) return false;
   }
 
-  name = parseJavaScriptCSSPropertyName(name);
-
-  JSValueProtect(ctx, value);
-  properties[name] = value;
-
-  NativeString args_01{};
-  NativeString args_02{};
-  buildUICommandArgs(name, valueStr, args_01, args_02);
-  foundation::UICommandBuffer::instance(_hostClass->contextId)
-    ->addCommand(ownerEventTarget->eventTargetId, UICommand::setStyle, args_01, args_02, nullptr);
-
+  setDeclaration(cssPropertyID(name), name, JSStringGetCharactersPtr(valueStr), JSStringGetLength(valueStr));
+  JSStringRelease(valueStr);
   return true;
 }
 
 void StyleDeclarationInstance::internalRemoveProperty(std::string &name, JSValueRef *exception) {
-  name = parseJavaScriptCSSPropertyName(name);
+  setDeclaration(cssPropertyID(name), name, nullptr, 0);
+}
+
+JSValueRef StyleDeclarationInstance::internalGetPropertyValue(std::string &name, JSValueRef *exception) {
+  CSSPropertyID id = cssPropertyID(name);
+  Declaration *declaration = findDeclaration(id, id == CSSPropertyID::Unknown ? toCamelCasePropertyName(name) : name);
+  if (declaration == nullptr) return context->atomValue(context->atom(""));
+  return makeStringValue(ctx, declaration->value);
+}
+
+StyleDeclarationInstance::Declaration *StyleDeclarationInstance::findDeclaration(CSSPropertyID id,
+                                                                                 const std::string &name) {
+  for (auto &declaration : m_declarations) {
+    if (declaration.id == id && (id != CSSPropertyID::Unknown || declaration.name == name)) return &declaration;
+  }
+  return nullptr;
+}
 
-  if (properties.count(name) == 0) {
+// An empty value removes the declaration, same as removeProperty.
+void StyleDeclarationInstance::setDeclaration(CSSPropertyID id, std::string &name, const JSChar *chars,
+                                              size_t length) {
+  if (id == CSSPropertyID::Unknown) name = toCamelCasePropertyName(name);
+
+  Declaration *declaration = findDeclaration(id, name);
+  if (declaration == nullptr) {
+    if (length == 0) return;
+    m_declarations.push_back({id, id == CSSPropertyID::Unknown ? name : std::string(), {}});
+    declaration = &m_declarations.back();
+  } else if (declaration->value.size() == length &&
+             std::char_traits<char16_t>::compare(declaration->value.data(),
+                                                 reinterpret_cast<const char16_t *>(chars), length) == 0) {
     return;
   }
 
-  JSValueRef value = properties[name];
-  JSValueUnprotect(ctx, value);
-  properties.erase(name);
+  declaration->value.assign(reinterpret_cast<const char16_t *>(chars), length);
+  sendStyle(*declaration, declaration->value);
+  if (length == 0) m_declarations.erase(m_declarations.begin() + (declaration - m_declarations.data()));
+}
 
+void StyleDeclarationInstance::sendStyle(const Declaration &declaration, const std::u16string &value) {
+  const std::string &name =
+    declaration.id == CSSPropertyID::Unknown ? declaration.name : cssPropertyName(declaration.id);
   NativeString args_01{};
   NativeString args_02{};
-  std::string empty;
-  buildUICommandArgs(name, empty, args_01, args_02);
-
-  foundation::UICommandBuffer::instance(_hostClass->contextId)
-    ->addCommand(ownerEventTarget->eventTargetId, UICommand::setStyle, args_01, args_02, nullptr);
+  buildUICommandAtomArgs(context, name, value, args_01, args_02);
+  context->commandBuffer()->addCommand(ownerEventTarget->eventTargetId, UICommand::setStyle, args_01, args_02,
+                                       nullptr);
 }
 
-JSValueRef StyleDeclarationInstance::internalGetPropertyValue(std::string &name,
-                                                                                   JSValueRef *exception) {
-  name = parseJavaScriptCSSPropertyName(name);
+void StyleDeclarationInstance::setCssText(const JSChar *chars, size_t length) {
+  std::vector<Declaration> declarations;
+  parseDeclarationBlock(chars, length, [&](const JSChar *name, size_t nameLength, const JSChar *value,
+                                           size_t valueLength) {
+    CSSPropertyID id = cssPropertyID(name, nameLength);
+    std::string unknownName;
+    if (id == CSSPropertyID::Unknown) {
+      // Property names are ASCII case-insensitive, except custom properties.
+      unknownName = toPropertyName(name, nameLength);
+      if (unknownName.compare(0, 2, "--") != 0) {
+        std::transform(unknownName.begin(), unknownName.end(), unknownName.begin(), ::tolower);
+        id = cssPropertyID(unknownName);
+        unknownName = id == CSSPropertyID::Unknown ? toCamelCasePropertyName(unknownName) : std::string();
+      }
+    }
 
-  return properties[name];
+    std::u16string text(reinterpret_cast<const char16_t *>(value), valueLength);
+    for (auto &declaration : declarations) {
+      if (declaration.id == id && declaration.name == unknownName) {
+        declaration.value = std::move(text);
+        return;
+      }
+    }
+    declarations.push_back({id, std::move(unknownName), std::move(text)});
+  });
+  declarations.erase(std::remove_if(declarations.begin(), declarations.end(),
+                                    [](const Declaration &declaration) { return declaration.value.empty(); }),
+                     declarations.end());
+
+  // Removed properties are reset before the new values are set, unchanged properties are not sent again.
+  std::u16string empty;
+  for (auto &declaration : m_declarations) {
+    bool kept = std::any_of(declarations.begin(), declarations.end(), [&](const Declaration &next) {
+      return next.id == declaration.id && next.name == declaration.name;
+    });
+    if (!kept) sendStyle(declaration, empty);
+  }
+  for (auto &next : declarations) {
+    Declaration *declaration = findDeclaration(next.id, next.name);
+    if (declaration == nullptr || declaration->value != next.value) sendStyle(next, next.value);
+  }
+
+  m_declarations = std::move(declarations);
+}
+
+JSValueRef StyleDeclarationInstance::cssText() {
+  std::u16string text;
+  for (auto &declaration : m_declarations) {
+    if (!text.empty()) text += u' ';
+    if (declaration.id == CSSPropertyID::Unknown) {
+      text.append(declaration.name.begin(), declaration.name.end());
+    } else {
+      for (const char *name = cssPropertyKebabName(declaration.id); *name != '\0'; name++) text += *name;
+    }
+    text += u": ";
+    text += declaration.value;
+    text += u';';
+  }
+  return makeStringValue(ctx, text);
 }
 
 JSValueRef CSSStyleDeclaration::setProperty(JSContextRef ctx, JSObjectRef function,
@@ -229,8 +378,14 @@ JSValueRef CSSStyleDeclaration::getPropertyValue(JSContextRef ctx, JSObjectRef f
 }
 
 void StyleDeclarationInstance::getPropertyNames(JSPropertyNameAccumulatorRef accumulator) {
-  for (auto &prop : properties) {
-    JSPropertyNameAccumulatorAddName(accumulator, JSStringCreateWithUTF8CString(prop.first.c_str()));
+  for (auto &declaration : m_declarations) {
+    const std::string &name =
+      declaration.id == CSSPropertyID::Unknown ? declaration.name : cssPropertyName(declaration.id);
+    JSPropertyNameAccumulatorAddName(accumulator, context->atom(name));
+  }
+
+  for (auto &prop : getCSSStyleDeclarationPropertyNames()) {
+    JSPropertyNameAccumulatorAddName(accumulator, prop);
   }
 
   for (auto &prop : getCSSStyleDeclarationPrototypePropertyNames()) {
@@ -12,16 +12,18 @@ void bindTextNode(std::unique_ptr<JSContext> &context) {
   JSC_GLOBAL_SET_PROPERTY(context, "Text", textNode->classObject);
 }
 
-std::unordered_map<JSContext *, JSTextNode *> JSTextNode::instanceMap{};
 
 JSTextNode *JSTextNode::instance(JSContext *context) {
-  if (instanceMap.count(context) == 0) {
-    instanceMap[context] = new JSTextNode(context);
+  auto &bindingState = context->bindingState();
+  auto hostClass = bindingState.hostClass<JSTextNode>(BindingSlot::JSTextNode);
+  if (hostClass == nullptr) {
+    hostClass = new JSTextNode(context);
+    bindingState.setHostClass(BindingSlot::JSTextNode, hostClass);
   }
-  return instanceMap[context];
+  return hostClass;
 }
 JSTextNode::~JSTextNode() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSTextNode, this);
 }
 
 JSTextNode::JSTextNode(JSContext *context) : JSNode(context, "Text") {}
@@ -39,8 +41,8 @@ JSTextNode::TextNodeInstance::TextNodeInstance(JSTextNode *jsTextNode, JSStringR
   m_data.setString(data);
 
   NativeString args_01{};
-  buildUICommandArgs(data, args_01);
-  foundation::UICommandBuffer::instance(_hostClass->contextId)
+  buildUICommandArgs(context, data, args_01);
+  context->commandBuffer()
     ->addCommand(eventTargetId, UICommand::createTextNode, args_01, nativeTextNode);
 }
 
@@ -59,8 +61,7 @@ JSValueRef JSTextNode::TextNodeInstance::getProperty(std::string &name, JSValueR
     return m_data.makeString();
   }
   case TextNodeProperty::nodeName: {
-    JSStringRef nodeName = JSStringCreateWithUTF8CString("#text");
-    return JSValueMakeString(_hostClass->ctx, nodeName);
+    return context->atomValue(context->atom("#text"));
   }
   }
 }
@@ -73,8 +74,8 @@ bool JSTextNode::TextNodeInstance::setProperty(std::string &name, JSValueRef val
     std::string dataString = JSStringToStdString(data);
     NativeString args_01{};
     NativeString args_02{};
-    buildUICommandArgs(name, dataString, args_01, args_02);
-    foundation::UICommandBuffer::instance(_hostClass->contextId)
+    buildUICommandArgs(context, name, dataString, args_01, args_02);
+    context->commandBuffer()
       ->addCommand(eventTargetId, UICommand::setProperty, args_01, args_02, nullptr);
     return true;
   } else {
@@ -95,7 +96,7 @@ std::string JSTextNode::TextNodeInstance::internalGetTextContent() {
 }
 
 JSTextNode::TextNodeInstance::~TextNodeInstance() {
-  foundation::UICommandCallbackQueue::instance()->registerCallback([](void *ptr) {
+  context->commandBuffer()->registerCallback([](void *ptr) {
     delete reinterpret_cast<NativeTextNode *>(ptr);
   }, nativeTextNode);
 }
@@ -106,8 +107,8 @@ void JSTextNode::TextNodeInstance::internalSetTextContent(JSStringRef content, J
   std::string key = "data";
   NativeString args_01{};
   NativeString args_02{};
-  buildUICommandArgs(key, content, args_01, args_02);
-  foundation::UICommandBuffer::instance(context->getContextId())
+  buildUICommandArgs(context, key, content, args_01, args_02);
+  context->commandBuffer()
     ->addCommand(eventTargetId, UICommand::setProperty, args_01, args_02, nullptr);
 }
 
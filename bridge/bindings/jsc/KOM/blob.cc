@@ -79,17 +79,19 @@ std::vector<uint8_t> BlobBuilder::finalize() {
   return std::move(_data);
 }
 
-std::unordered_map<JSContext *, JSBlob *> JSBlob::instanceMap{};
 
 JSBlob *JSBlob::instance(JSContext *context) {
-  if (instanceMap.count(context) == 0) {
-    instanceMap[context] = new JSBlob(context);
+  auto &bindingState = context->bindingState();
+  auto hostClass = bindingState.hostClass<JSBlob>(BindingSlot::JSBlob);
+  if (hostClass == nullptr) {
+    hostClass = new JSBlob(context);
+    bindingState.setHostClass(BindingSlot::JSBlob, hostClass);
   }
-  return instanceMap[context];
+  return hostClass;
 }
 
 JSBlob::~JSBlob() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSBlob, this);
 }
 
 JSObjectRef JSBlob::instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -234,10 +236,9 @@ int32_t JSBlob::BlobInstance::size() {
 JSValueRef JSBlob::BlobInstance::getProperty(std::string &name, JSValueRef *exception) {
   auto &propertyMap = getBlobPropertyMap();
   auto &prototypePropertyMap = getBlobPrototypePropertyMap();
-  JSStringHolder nameStringHolder = JSStringHolder(context, name);
 
   if (prototypePropertyMap.count(name) > 0) {
-    return JSObjectGetProperty(ctx, prototype<JSBlob>()->prototypeObject, nameStringHolder.getString(), exception);
+    return JSObjectGetProperty(ctx, prototype<JSBlob>()->prototypeObject, context->atom(name), exception);
   };
 
   if (propertyMap.count(name) > 0) {
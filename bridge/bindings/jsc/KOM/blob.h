@@ -23,7 +23,6 @@ class BlobBuilder;
 
 class KRAKEN_EXPORT JSBlob : public HostClass {
 public:
-  static std::unordered_map<JSContext *, JSBlob *> instanceMap;
   static JSBlob *instance(JSContext *context);
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
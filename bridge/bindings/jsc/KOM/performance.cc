@@ -6,6 +6,7 @@
 #include "performance.h"
 #include "dart_methods.h"
 #include "foundation/logging.h"
+#include "include/kraken_foundation.h"
 #include <chrono>
 #include <cmath>
 
@@ -58,7 +59,7 @@ JSPerformanceEntry::JSPerformanceEntry(JSContext *context, NativePerformanceEntr
   : HostObject(context, "PerformanceEntry"), m_nativePerformanceEntry(nativePerformanceEntry) {}
 
 JSValueRef JSPerformanceEntry::getProperty(std::string &name, JSValueRef *exception) {
-  auto propertyMap = getPerformanceEntryPropertyMap();
+  auto &propertyMap = getPerformanceEntryPropertyMap();
   if (propertyMap.count(name) > 0) {
     auto property = propertyMap[name];
     switch (property) {
@@ -92,8 +93,8 @@ JSPerformanceMeasure::JSPerformanceMeasure(JSContext *context, NativePerformance
   : JSPerformanceEntry(context, nativePerformanceEntry) {}
 
 JSValueRef JSPerformance::getProperty(std::string &name, JSValueRef *exception) {
-  auto propertyMap = getPerformancePropertyMap();
-  auto prototypePropertyMap = getPerformancePrototypePropertyMap();
+  auto &propertyMap = getPerformancePropertyMap();
+  auto &prototypePropertyMap = getPerformancePrototypePropertyMap();
 
   if (prototypePropertyMap.count(name) > 0) return nullptr;
 
@@ -106,6 +107,9 @@ JSValueRef JSPerformance::getProperty(std::string &name, JSValueRef *exception)
         std::chrono::duration_cast<std::chrono::milliseconds>(context->timeOrigin.time_since_epoch()).count();
       return JSValueMakeNumber(ctx, time);
     }
+    case PerformanceProperty::uiCommandStats: {
+      return internalUICommandStats();
+    }
     default:
       break;
     }
@@ -132,6 +136,36 @@ void JSPerformance::getPropertyNames(JSPropertyNameAccumulatorRef accumulator) {
   }
 }
 
+// Names of UICommand, used as keys of uiCommandStats.commands.
+static const char *uiCommandNames[UI_COMMAND_TYPE_COUNT] = {
+  "createElement", "createTextNode", "createComment", "disposeEventTarget", "addEvent",   "removeNode",  "insertAdjacentNode",
+  "setStyle",      "setProperty",    "removeProperty", "cloneNode",         "removeEvent", "registerAtom"};
+
+JSObjectRef JSPerformance::internalUICommandStats() {
+  UICommandStats *stats = context->commandBuffer()->stats();
+
+  JSObjectRef commands = JSObjectMake(ctx, nullptr, nullptr);
+  for (int32_t i = 0; i < UI_COMMAND_TYPE_COUNT; i++) {
+    JSC_SET_STRING_PROPERTY(context, commands, uiCommandNames[i],
+                            JSValueMakeNumber(ctx, static_cast<double>(stats->commandCount[i])));
+  }
+
+  JSValueRef histogram[UI_COMMAND_BATCH_HISTOGRAM_SIZE];
+  for (int32_t i = 0; i < UI_COMMAND_BATCH_HISTOGRAM_SIZE; i++) {
+    histogram[i] = JSValueMakeNumber(ctx, static_cast<double>(stats->batchSizeHistogram[i]));
+  }
+
+  JSObjectRef object = JSObjectMake(ctx, nullptr, nullptr);
+  JSC_SET_STRING_PROPERTY(context, object, "commands", commands);
+  JSC_SET_STRING_PROPERTY(context, object, "payloadBytes", JSValueMakeNumber(ctx, stats->payloadBytes));
+  JSC_SET_STRING_PROPERTY(context, object, "batchSizeHistogram",
+                          JSObjectMakeArray(ctx, UI_COMMAND_BATCH_HISTOGRAM_SIZE, histogram, nullptr));
+  JSC_SET_STRING_PROPERTY(context, object, "frameFlushCount", JSValueMakeNumber(ctx, stats->frameFlushCount));
+  JSC_SET_STRING_PROPERTY(context, object, "forcedFlushCount", JSValueMakeNumber(ctx, stats->forcedFlushCount));
+  JSC_SET_STRING_PROPERTY(context, object, "elidedFlushCount", JSValueMakeNumber(ctx, stats->elidedFlushCount));
+  return object;
+}
+
 double JSPerformance::internalNow() {
   auto now = std::chrono::system_clock::now();
   auto duration = std::chrono::duration_cast<std::chrono::microseconds>(now - context->timeOrigin);
@@ -192,7 +192,7 @@ public:
 
 class JSPerformance : public HostObject {
 public:
-  DEFINE_OBJECT_PROPERTY(Performance, 1, timeOrigin);
+  DEFINE_OBJECT_PROPERTY(Performance, 2, timeOrigin, uiCommandStats);
   DEFINE_PROTOTYPE_OBJECT_PROPERTY(Performance, 10, now, toJSON, clearMarks, clearMeasures, getEntries,
                                 getEntriesByName, getEntriesByType, mark, measure, __kraken_navigation_summary__);
 
@@ -257,6 +257,7 @@ private:
   JSObjectRef m_summary{nullptr};
   void measureSummary();
 #endif
+  JSObjectRef internalUICommandStats();
   void internalMeasure(const std::string &name, const std::string &startMark, const std::string &endMark,
                        JSValueRef *exception);
   double internalNow();
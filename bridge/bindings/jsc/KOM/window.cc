@@ -30,10 +30,9 @@ WindowInstance::~WindowInstance() {
 JSValueRef WindowInstance::getProperty(std::string &name, JSValueRef *exception) {
   auto &propertyMap = getWindowPropertyMap();
   auto &prototypePropertyMap = getWindowPrototypePropertyMap();
-  JSStringHolder nameStringHolder = JSStringHolder(context, name);
 
   if (prototypePropertyMap.count(name) > 0) {
-    return JSObjectGetProperty(ctx, prototype<JSWindow>()->prototypeObject, nameStringHolder.getString(), exception);
+    return JSObjectGetProperty(ctx, prototype<JSWindow>()->prototypeObject, context->atom(name), exception);
   }
 
   if (propertyMap.count(name) > 0) {
@@ -189,7 +188,7 @@ JSValueRef JSWindow::scrollBy(JSContextRef ctx, JSObjectRef function, JSObjectRe
 }
 
 JSWindow::~JSWindow() {
-  instanceMap.erase(context);
+  context->bindingState().removeHostClass(BindingSlot::JSWindow, this);
 }
 
 JSObjectRef JSWindow::instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -198,13 +197,15 @@ JSObjectRef JSWindow::instanceConstructor(JSContextRef ctx, JSObjectRef construc
   return window->object;
 }
 
-std::unordered_map<JSContext *, JSWindow *> JSWindow::instanceMap{};
 
 JSWindow *JSWindow::instance(JSContext *context) {
-  if (instanceMap.count(context) == 0) {
-    instanceMap[context] = new JSWindow(context);
+  auto &bindingState = context->bindingState();
+  auto hostClass = bindingState.hostClass<JSWindow>(BindingSlot::JSWindow);
+  if (hostClass == nullptr) {
+    hostClass = new JSWindow(context);
+    bindingState.setHostClass(BindingSlot::JSWindow, hostClass);
   }
-  return instanceMap[context];
+  return hostClass;
 }
 
 void bindWindow(std::unique_ptr<JSContext> &context) {
@@ -21,7 +21,6 @@ struct NativeWindow;
 
 class JSWindow : public JSEventTarget {
 public:
-  static std::unordered_map<JSContext *, JSWindow *> instanceMap;
   static JSWindow *instance(JSContext *context);
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
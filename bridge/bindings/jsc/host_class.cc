@@ -15,16 +15,14 @@ HostClass::HostClass(JSContext *context, std::string name)
   : context(context), _name(name), ctx(context->context()), contextId(context->getContextId()) {
   JSClassDefinition hostClassDefinition = kJSClassDefinitionEmpty;
   JSC_CREATE_HOST_CLASS_DEFINITION(hostClassDefinition, nullptr, _name.c_str(), nullptr, nullptr, HostClass);
-  jsClass = JSClassCreate(&hostClassDefinition);
-  JSClassRetain(jsClass);
+  jsClass = JSClassGetShared(hostClassDefinition);
   classObject = JSObjectMake(ctx, jsClass, this);
   prototypeObject = JSObjectMake(ctx, nullptr, this);
   JSValueProtect(ctx, classObject);
   JSValueProtect(ctx, prototypeObject);
   JSClassDefinition hostInstanceDefinition = kJSClassDefinitionEmpty;
   JSC_CREATE_HOST_CLASS_INSTANCE_DEFINITION(hostInstanceDefinition, _name.c_str(), HostClass, nullptr);
-  instanceClass = JSClassCreate(&hostInstanceDefinition);
-  JSClassRetain(instanceClass);
+  instanceClass = JSClassGetShared(hostInstanceDefinition);
 }
 
 HostClass::HostClass(JSContext *context, HostClass *parentHostClass, std::string name,
@@ -33,23 +31,29 @@ HostClass::HostClass(JSContext *context, HostClass *parentHostClass, std::string
   JSClassDefinition hostClassDefinition = kJSClassDefinitionEmpty;
   JSC_CREATE_HOST_CLASS_DEFINITION(hostClassDefinition, nullptr, _name.c_str(), staticFunction, staticValue, HostClass);
   hostClassDefinition.attributes = kJSClassAttributeNone;
-  jsClass = JSClassCreate(&hostClassDefinition);
-  JSClassRetain(jsClass);
+  jsClass = JSClassGetShared(hostClassDefinition);
   classObject = JSObjectMake(ctx, jsClass, this);
   prototypeObject = JSObjectMake(ctx, nullptr, this);
   JSValueProtect(ctx, classObject);
   JSValueProtect(ctx, prototypeObject);
   JSClassDefinition hostInstanceDefinition = kJSClassDefinitionEmpty;
   JSC_CREATE_HOST_CLASS_INSTANCE_DEFINITION(hostInstanceDefinition, _name.c_str(), HostClass, nullptr);
-  instanceClass = JSClassCreate(&hostInstanceDefinition);
-  JSClassRetain(instanceClass);
+  instanceClass = JSClassGetShared(hostInstanceDefinition);
+}
+
+void HostClass::defineInstanceStaticValues(const JSStaticValue *staticValues) {
+  JSClassDefinition staticInstanceDefinition = kJSClassDefinitionEmpty;
+  staticInstanceDefinition.className = _name.c_str();
+  staticInstanceDefinition.attributes = kJSClassAttributeNoAutomaticPrototype;
+  staticInstanceDefinition.staticValues = staticValues;
+  // Instances are finalized by the parent class, which keeps the dynamic property callbacks.
+  staticInstanceDefinition.parentClass = instanceClass;
+  instanceClass = JSClassGetShared(staticInstanceDefinition);
 }
 
 void HostClass::proxyFinalize(JSObjectRef object) {
   auto hostClass = static_cast<HostClass *>(JSObjectGetPrivate(object));
   JSObjectSetPrivate(object, nullptr);
-  JSClassRelease(hostClass->jsClass);
-  JSClassRelease(hostClass->instanceClass);
   delete hostClass;
 }
 
@@ -103,7 +107,8 @@ JSValueRef constructorCall(JSContextRef ctx, JSObjectRef function, JSObjectRef t
 
 JSValueRef HostClass::proxyGetProperty(JSContextRef ctx, JSObjectRef object, JSStringRef propertyName,
                                        JSValueRef *exception) {
-  auto &&name = JSStringToStdString(propertyName);
+  PropertyNameScope nameScope(propertyName);
+  std::string &name = nameScope.name();
   auto hostClass = static_cast<HostClass *>(JSObjectGetPrivate(object));
 
   if (name == "call") {
@@ -140,7 +145,8 @@ JSValueRef HostClass::proxyInstanceGetProperty(JSContextRef ctx, JSObjectRef obj
   auto startTime = std::chrono::system_clock::now().time_since_epoch().count();
   nativePerformance->mark(PERF_JS_HOST_CLASS_GET_PROPERTY_START);
 #endif
-  std::string &&name = JSStringToStdString(propertyName);
+  PropertyNameScope nameScope(propertyName);
+  std::string &name = nameScope.name();
   JSValueRef result = hostClassInstance->getProperty(name, exception);
 #if ENABLE_PROFILE
   auto endTime = std::chrono::system_clock::now().time_since_epoch().count();
@@ -158,7 +164,8 @@ JSValueRef HostClass::proxyInstanceGetProperty(JSContextRef ctx, JSObjectRef obj
 JSValueRef HostClass::proxyPrototypeGetProperty(JSContextRef ctx, JSObjectRef object, JSStringRef propertyName,
                                                 JSValueRef *exception) {
   auto hostClass = reinterpret_cast<HostClass *>(JSObjectGetPrivate(object));
-  std::string &&name = JSStringToStdString(propertyName);
+  PropertyNameScope nameScope(propertyName);
+  std::string &name = nameScope.name();
   JSValueRef result = hostClass->prototypeGetProperty(name, exception);
   return result;
 }
@@ -182,7 +189,8 @@ bool HostClass::proxyInstanceSetProperty(JSContextRef ctx, JSObjectRef object, J
   nativePerformance->mark(PERF_JS_HOST_CLASS_SET_PROPERTY_START);
   auto startTime = std::chrono::system_clock::now().time_since_epoch().count();
 #endif
-  std::string &&name = JSStringToStdString(propertyName);
+  PropertyNameScope nameScope(propertyName);
+  std::string &name = nameScope.name();
   bool handledBySelf = hostClassInstance->setProperty(name, value, exception);
   bool result = !hostClassInstance->context->handleException(*exception) || handledBySelf;
 #if ENABLE_PROFILE
@@ -219,9 +227,6 @@ HostClass::~HostClass() {
     JSValueUnprotect(ctx, classObject);
     JSValueUnprotect(ctx, prototypeObject);
   }
-
-  JSClassRelease(jsClass);
-  JSClassRelease(instanceClass);
 }
 
 JSValueRef HostClass::getProperty(std::string &name, JSValueRef *exception) {
@@ -254,6 +259,16 @@ HostClass::Instance::Instance(HostClass *hostClass)
   object = JSObjectMake(hostClass->ctx, hostClass->instanceClass, this);
 }
 
+HostClass::Instance::Instance(HostClass *hostClass, JSObjectRef object)
+  : _hostClass(hostClass), context(_hostClass->context), ctx(_hostClass->ctx), contextId(_hostClass->contextId) {
+  if (object == nullptr) {
+    this->object = JSObjectMake(hostClass->ctx, hostClass->instanceClass, this);
+  } else {
+    this->object = object;
+    JSObjectSetPrivate(object, this);
+  }
+}
+
 JSValueRef HostClass::Instance::getProperty(std::string &name, JSValueRef *exception) {
   return nullptr;
 }
@@ -12,7 +12,7 @@ HostObject::HostObject(JSContext *context, std::string name)
   : context(context), name(std::move(name)), ctx(context->context()), contextId(context->getContextId()) {
   JSClassDefinition hostObjectDefinition = kJSClassDefinitionEmpty;
   JSC_CREATE_HOST_OBJECT_DEFINITION(hostObjectDefinition, this->name.c_str(), HostObject);
-  jsClass = JSClassCreate(&hostObjectDefinition);
+  jsClass = JSClassGetShared(hostObjectDefinition);
   jsObject = JSObjectMake(context->context(), jsClass, this);
 }
 
@@ -20,7 +20,8 @@ JSValueRef HostObject::proxyGetProperty(JSContextRef ctx, JSObjectRef object, JS
                                         JSValueRef *exception) {
   auto hostObject = static_cast<HostObject *>(JSObjectGetPrivate(object));
   auto &context = hostObject->context;
-  std::string name = JSStringToStdString(propertyName);
+  PropertyNameScope nameScope(propertyName);
+  std::string &name = nameScope.name();
   JSValueRef ret = hostObject->getProperty(name, exception);
   if (!context->handleException(*exception)) {
     return nullptr;
@@ -32,7 +33,8 @@ bool HostObject::proxySetProperty(JSContextRef ctx, JSObjectRef object, JSString
                                   JSValueRef *exception) {
   auto hostObject = static_cast<HostObject *>(JSObjectGetPrivate(object));
   auto &context = hostObject->context;
-  std::string &&name = JSStringToStdString(propertyName);
+  PropertyNameScope nameScope(propertyName);
+  std::string &name = nameScope.name();
   bool handledBySelf = hostObject->setProperty(name, value, exception);
   return !context->handleException(*exception) || handledBySelf;
 }
@@ -40,7 +42,6 @@ bool HostObject::proxySetProperty(JSContextRef ctx, JSObjectRef object, JSString
 void HostObject::proxyFinalize(JSObjectRef obj) {
   auto hostObject = static_cast<HostObject *>(JSObjectGetPrivate(obj));
   JSObjectSetPrivate(obj, nullptr);
-  JSClassRelease(hostObject->jsClass);
   delete hostObject;
 }
 
@@ -26,36 +26,15 @@ void HTMLParser::parseProperty(ElementInstance* element, GumboElement * gumboEle
     GumboAttribute* attribute = (GumboAttribute*) attributes->data[j];
 
     if (strcmp(attribute->name, "style") == 0) {
-      std::vector<std::string> arrStyles;
-      std::string::size_type prev_pos = 0, pos = 0;
-      std::string strStyles = attribute->value;
-
-      while ((pos = strStyles.find(";", pos)) != std::string::npos) {
-        arrStyles.push_back(strStyles.substr(prev_pos, pos - prev_pos));
-        prev_pos = ++pos;
-      }
-      arrStyles.push_back(strStyles.substr(prev_pos, pos - prev_pos));
-
       JSStringRef propertyName = JSStringCreateWithUTF8CString("style");
       JSValueRef styleRef = JSObjectGetProperty(m_context->context(), element->object, propertyName, nullptr);
       JSObjectRef style = JSValueToObject(m_context->context(), styleRef, nullptr);
       auto styleDeclarationInstance = static_cast<StyleDeclarationInstance *>(JSObjectGetPrivate(style));
       JSStringRelease(propertyName);
 
-      for (auto s : arrStyles) {
-        std::string::size_type position = s.find(":");
-        if (position != s.npos) {
-          std::string styleKey = s.substr(0, position);
-          std::transform(styleKey.begin(), styleKey.end(), styleKey.begin(), ::tolower);
-          trim(styleKey);
-
-          std::string styleValue = s.substr(position + 1, s.length());
-          std::transform(styleValue.begin(), styleValue.end(), styleValue.begin(), ::tolower);
-          trim(styleValue);
-          
-          styleDeclarationInstance->internalSetProperty(styleKey, JSValueMakeString(m_context->context() ,JSStringCreateWithUTF8CString(styleValue.c_str())), nullptr);
-        }
-      }
+      JSStringRef cssText = JSStringCreateWithUTF8CString(attribute->value);
+      styleDeclarationInstance->setCssText(JSStringGetCharactersPtr(cssText), JSStringGetLength(cssText));
+      JSStringRelease(cssText);
     } else {
       std::string strName = attribute->name;
       std::transform(strName.begin(), strName.end(), strName.begin(), ::tolower);
@@ -117,10 +96,9 @@ bool HTMLParser::parseHTML(const uint16_t *code, size_t codeLength) {
   const GumboVector *root_children = &htmlTree->root->v.element.children;
 
   // find body.
-  ElementInstance* body;
+  ElementInstance* body = nullptr;
   auto document = DocumentInstance::instance(m_context.get());
-  for (int i = 0; i < document->documentElement->childNodes.size(); ++i) {
-    NodeInstance* node = document->documentElement->childNodes[i];
+  for (NodeInstance* node = document->documentElement->firstChild(); node != nullptr; node = node->nextSibling()) {
     ElementInstance* element = reinterpret_cast<ElementInstance *>(node);
 
     if (element->tagName() == "BODY") {
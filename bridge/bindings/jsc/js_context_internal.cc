@@ -8,8 +8,12 @@
 #include "bindings/jsc/kraken.h"
 #include "bindings/jsc/KOM/performance.h"
 #include "dart_methods.h"
+#include <cstring>
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 
@@ -22,6 +26,7 @@ static std::atomic<int32_t> context_unique_id{0};
 
 JSContext::JSContext(int32_t contextId, const JSExceptionHandler &handler, void *owner)
   : contextId(contextId), _handler(handler), owner(owner), ctxInvalid_(false), uniqueId(context_unique_id++) {
+  m_bindingState.commandBuffer = foundation::UICommandBuffer::instance(contextId);
 
   JSClassDefinition contextDefinition = kJSClassDefinitionEmpty;
 
@@ -53,9 +58,83 @@ JSContext::JSContext(int32_t contextId, const JSExceptionHandler &handler, void
 
 JSContext::~JSContext() {
   ctxInvalid_ = true;
+  m_atomTable.unprotectValues(ctx_);
   JSGlobalContextRelease(ctx_);
 }
 
+JSStringRef JSContext::atom(const char *name) {
+  return m_atomTable.atom(name, strlen(name));
+}
+
+JSStringRef JSContext::atom(const std::string &name) {
+  return m_atomTable.atom(name.data(), name.size());
+}
+
+JSStringRef JSContext::atom(const JSChar *chars, size_t length) {
+  return m_atomTable.atom(chars, length);
+}
+
+JSStringRef JSContext::atom(JSStringRef string) {
+  return m_atomTable.atom(JSStringGetCharactersPtr(string), JSStringGetLength(string));
+}
+
+JSValueRef JSContext::atomValue(JSStringRef atom) {
+  return m_atomTable.value(ctx_, atom);
+}
+
+JSStringAtomTable::~JSStringAtomTable() {
+  for (auto &atom : m_atoms) {
+    JSStringRelease(atom.second.string);
+  }
+}
+
+JSStringAtomTable::Atom &JSStringAtomTable::find(const JSChar *chars, size_t length) {
+  std::u16string_view key(reinterpret_cast<const char16_t *>(chars), length);
+  auto it = m_atoms.find(key);
+  if (it != m_atoms.end()) return it->second;
+
+  JSStringRef string = JSStringCreateWithCharacters(chars, length);
+  key = std::u16string_view(reinterpret_cast<const char16_t *>(JSStringGetCharactersPtr(string)), length);
+  return m_atoms.emplace(key, Atom{string, nullptr}).first->second;
+}
+
+JSStringRef JSStringAtomTable::atom(const char *name, size_t length) {
+  // Names are ASCII in most cases, widen them into the reused buffer without allocation.
+  m_buffer.resize(length);
+  for (size_t i = 0; i < length; i++) {
+    if (static_cast<unsigned char>(name[i]) >= 0x80) {
+      std::string utf8(name, length);
+      JSStringRef string = JSStringCreateWithUTF8CString(utf8.c_str());
+      JSStringRef result = find(JSStringGetCharactersPtr(string), JSStringGetLength(string)).string;
+      JSStringRelease(string);
+      return result;
+    }
+    m_buffer[i] = static_cast<char16_t>(name[i]);
+  }
+  return find(reinterpret_cast<const JSChar *>(m_buffer.data()), length).string;
+}
+
+JSStringRef JSStringAtomTable::atom(const JSChar *chars, size_t length) {
+  return find(chars, length).string;
+}
+
+JSValueRef JSStringAtomTable::value(JSContextRef ctx, JSStringRef atom) {
+  Atom &entry = find(JSStringGetCharactersPtr(atom), JSStringGetLength(atom));
+  if (entry.value == nullptr) {
+    entry.value = JSValueMakeString(ctx, entry.string);
+    JSValueProtect(ctx, entry.value);
+  }
+  return entry.value;
+}
+
+void JSStringAtomTable::unprotectValues(JSContextRef ctx) {
+  for (auto &atom : m_atoms) {
+    if (atom.second.value == nullptr) continue;
+    JSValueUnprotect(ctx, atom.second.value);
+    atom.second.value = nullptr;
+  }
+}
+
 bool JSContext::evaluateJavaScript(const uint16_t *code, size_t codeLength, const char *sourceURL, int startLine) {
   JSStringRef sourceRef = JSStringCreateWithCharacters(code, codeLength);
   JSStringRef sourceURLRef = nullptr;
@@ -149,13 +228,66 @@ std::string JSStringToStdString(JSStringRef jsString) {
   return std::string(buffer.data());
 }
 
+namespace {
+// Elements of deque never move when it grows, names of outer scopes stay valid.
+std::deque<std::string> propertyNameBuffers;
+size_t propertyNameDepth = 0;
+} // namespace
+
+PropertyNameScope::PropertyNameScope(JSStringRef propertyName) {
+  if (propertyNameDepth == propertyNameBuffers.size()) {
+    propertyNameBuffers.emplace_back();
+  }
+  m_name = &propertyNameBuffers[propertyNameDepth++];
+
+  size_t length = JSStringGetLength(propertyName);
+  const JSChar *chars = JSStringGetCharactersPtr(propertyName);
+  m_name->resize(length);
+  for (size_t i = 0; i < length; i++) {
+    if (chars[i] >= 0x80) {
+      // Fallback to UTF-8 conversion of JSC for non ASCII names.
+      m_name->resize(JSStringGetMaximumUTF8CStringSize(propertyName));
+      size_t size = JSStringGetUTF8CString(propertyName, &(*m_name)[0], m_name->size());
+      m_name->resize(size > 0 ? size - 1 : 0);
+      return;
+    }
+    (*m_name)[i] = static_cast<char>(chars[i]);
+  }
+}
+
+PropertyNameScope::~PropertyNameScope() {
+  propertyNameDepth--;
+}
+
+namespace {
+// Classes are keyed by the bytes of their definition with className taken out, followed by className.
+std::unordered_map<std::string, JSClassRef> sharedClasses;
+std::mutex sharedClassesMutex;
+} // namespace
+
+JSClassRef JSClassGetShared(const JSClassDefinition &definition) {
+  JSClassDefinition keyDefinition = definition;
+  keyDefinition.className = nullptr;
+  std::string key(reinterpret_cast<const char *>(&keyDefinition), sizeof(JSClassDefinition));
+  if (definition.className != nullptr) key.append(definition.className);
+
+  std::lock_guard<std::mutex> guard(sharedClassesMutex);
+  auto it = sharedClasses.find(key);
+  if (it != sharedClasses.end()) return it->second;
+
+  // Never released, the number of distinct definitions is bounded by the bindings.
+  JSClassRef jsClass = JSClassCreate(&definition);
+  sharedClasses.emplace(std::move(key), jsClass);
+  return jsClass;
+}
+
 JSObjectRef makeObjectFunctionWithPrivateData(JSContext *context, void *data, const char *name,
                                               JSObjectCallAsFunctionCallback callback) {
   JSClassDefinition functionDefinition = kJSClassDefinitionEmpty;
   functionDefinition.className = name;
   functionDefinition.callAsFunction = callback;
   functionDefinition.version = 0;
-  JSClassRef functionClass = JSClassCreate(&functionDefinition);
+  JSClassRef functionClass = JSClassGetShared(functionDefinition);
   return JSObjectMake(context->context(), functionClass, data);
 }
 
@@ -172,51 +304,93 @@ JSObjectRef JSObjectMakePromise(JSContext *context, void *data, JSObjectCallAsFu
 }
 
 namespace {
-const JSChar *cloneString(const JSChar *string, size_t length) {
-  auto *newString = new JSChar[length];
+void copyToArena(foundation::UICommandStringArena &arena, const JSChar *string, size_t length,
+                 NativeString &target) {
+  target.string = arena.copy(string, length);
+  target.length = length;
+}
+
+void copyToArena(foundation::UICommandStringArena &arena, const std::string &string, NativeString &target) {
+  // Most of the keys and values (tag names, property names, ids) are ascii, UTF-16 code units can be
+  // widened in place without creating a temporary JSString.
+  size_t length = string.size();
+  uint16_t *buffer = arena.allocate(length);
   for (size_t i = 0; i < length; i++) {
-    newString[i] = string[i];
+    auto c = static_cast<unsigned char>(string[i]);
+    if (JSC_UNLIKELY(c >= 0x80)) {
+      // Non-ascii string, the UTF-16 length is always shorter than UTF-8 bytes.
+      std::u16string utf16;
+      fromUTF8(string, utf16);
+      memcpy(buffer, utf16.c_str(), utf16.size() * sizeof(uint16_t));
+      length = utf16.size();
+      break;
+    }
+    buffer[i] = c;
   }
-  return newString;
-};
-} // namespace
-
-void buildUICommandArgs(JSStringRef key, NativeString &args_01) {
-  args_01.length = JSStringGetLength(key);
-  args_01.string = cloneString(JSStringGetCharactersPtr(key), args_01.length);
+  target.string = buffer;
+  target.length = length;
 }
 
-void buildUICommandArgs(std::string &key, NativeString &args_01) {
-  JSStringRef keyStringRef = JSStringCreateWithUTF8CString(key.c_str());
-  args_01.length = JSStringGetLength(keyStringRef);
-  args_01.string = cloneString(JSStringGetCharactersPtr(keyStringRef), args_01.length);
-  JSStringRelease(keyStringRef);
+void buildAtom(foundation::UICommandBuffer *buffer, const std::string &key, NativeString &target) {
+  int32_t atom = buffer->findAtom(key);
+  if (atom < 0) {
+    NativeString name{};
+    copyToArena(buffer->stringArena(), key, name);
+    atom = buffer->registerAtom(key, name);
+  }
+  // Negative length marks an atom argument, see readNativeUICommandToDart in to_native.dart.
+  target.string = nullptr;
+  target.length = -(atom + 1);
 }
+} // namespace
 
-void buildUICommandArgs(std::string &key, JSStringRef value, NativeString &args_01, NativeString &args_02) {
-  JSStringRef keyStringRef = JSStringCreateWithUTF8CString(key.c_str());
+void buildUICommandArgs(JSContext *context, JSStringRef key, NativeString &args_01) {
+  auto &arena = context->commandBuffer()->stringArena();
+  copyToArena(arena, JSStringGetCharactersPtr(key), JSStringGetLength(key), args_01);
+}
 
-  args_01.length = JSStringGetLength(keyStringRef);
-  args_01.string = cloneString(JSStringGetCharactersPtr(keyStringRef), args_01.length);
+void buildUICommandArgs(JSContext *context, std::string &key, NativeString &args_01) {
+  auto &arena = context->commandBuffer()->stringArena();
+  copyToArena(arena, key, args_01);
+}
 
-  args_02.length = JSStringGetLength(value);
-  args_02.string = cloneString(JSStringGetCharactersPtr(value), args_02.length);
+void buildUICommandArgs(JSContext *context, std::string &key, JSStringRef value, NativeString &args_01,
+                        NativeString &args_02) {
+  auto &arena = context->commandBuffer()->stringArena();
+  copyToArena(arena, key, args_01);
+  copyToArena(arena, JSStringGetCharactersPtr(value), JSStringGetLength(value), args_02);
+}
 
-  JSStringRelease(keyStringRef);
+void buildUICommandArgs(JSContext *context, std::string &key, std::string &value, NativeString &args_01,
+                        NativeString &args_02) {
+  auto &arena = context->commandBuffer()->stringArena();
+  copyToArena(arena, key, args_01);
+  copyToArena(arena, value, args_02);
 }
 
-void buildUICommandArgs(std::string &key, std::string &value, NativeString &args_01, NativeString &args_02) {
-  JSStringRef keyStringRef = JSStringCreateWithUTF8CString(key.c_str());
-  JSStringRef valueStringRef = JSStringCreateWithUTF8CString(value.c_str());
+void buildUICommandAtomArgs(JSContext *context, const std::string &key, NativeString &args_01) {
+  buildAtom(context->commandBuffer(), key, args_01);
+}
 
-  args_01.length = JSStringGetLength(keyStringRef);
-  args_01.string = cloneString(JSStringGetCharactersPtr(keyStringRef), args_01.length);
+void buildUICommandAtomArgs(JSContext *context, const std::string &key, JSStringRef value, NativeString &args_01,
+                            NativeString &args_02) {
+  auto buffer = context->commandBuffer();
+  buildAtom(buffer, key, args_01);
+  copyToArena(buffer->stringArena(), JSStringGetCharactersPtr(value), JSStringGetLength(value), args_02);
+}
 
-  args_02.length = JSStringGetLength(valueStringRef);
-  args_02.string = cloneString(JSStringGetCharactersPtr(valueStringRef), args_02.length);
+void buildUICommandAtomArgs(JSContext *context, const std::string &key, std::string &value, NativeString &args_01,
+                            NativeString &args_02) {
+  auto buffer = context->commandBuffer();
+  buildAtom(buffer, key, args_01);
+  copyToArena(buffer->stringArena(), value, args_02);
+}
 
-  JSStringRelease(keyStringRef);
-  JSStringRelease(valueStringRef);
+void buildUICommandAtomArgs(JSContext *context, const std::string &key, const std::u16string &value,
+                            NativeString &args_01, NativeString &args_02) {
+  auto buffer = context->commandBuffer();
+  buildAtom(buffer, key, args_01);
+  copyToArena(buffer->stringArena(), reinterpret_cast<const JSChar *>(value.data()), value.size(), args_02);
 }
 
 NativeString *stringToNativeString(std::string &string) {
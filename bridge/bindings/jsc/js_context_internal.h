@@ -72,6 +72,23 @@ inline std::string trim(std::string &str) {
 
 std::unique_ptr<JSContext> createJSContext(int32_t contextId, const JSExceptionHandler &handler, void *owner);
 
+// Convert a property name into a std::string buffer reused across property accesses, so reading and writing
+// properties of host objects does not allocate once buffers had grown. Getters and setters may run js which
+// accesses other host objects, every nested scope takes its own buffer.
+class PropertyNameScope {
+public:
+  explicit PropertyNameScope(JSStringRef propertyName);
+  ~PropertyNameScope();
+
+  std::string &name() {
+    return *m_name;
+  }
+
+private:
+  std::string *m_name;
+  KRAKEN_DISALLOW_COPY_AND_ASSIGN(PropertyNameScope);
+};
+
 #if ENABLE_PROFILE
 std::unordered_map<std::string, double> *getNativeFunctionCallTime();
 std::unordered_map<std::string, int> *getNativeFunctionCallCount();
@@ -82,6 +82,8 @@ JSBridge::JSBridge(int32_t contextId, const JSExceptionHandler &handler) : conte
     std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 #endif
   bridgeCallback = new foundation::BridgeCallback();
+  // Atoms and compaction states of the previous js context of this contextId are no longer valid.
+  ::foundation::UICommandBuffer::instance(contextId)->clearAtoms();
 
   m_context = binding::jsc::createJSContext(contextId, errorHandler, this);
 
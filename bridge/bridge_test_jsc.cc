@@ -222,6 +222,12 @@ JSValueRef simulateInputText(JSContextRef ctx, JSObjectRef function, JSObjectRef
   return nullptr;
 }
 
+JSValueRef dispatchedEventCount(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argumentCount,
+                                const JSValueRef *arguments, JSValueRef *exception) {
+  auto context = static_cast<binding::jsc::JSContext *>(JSObjectGetPrivate(function));
+  return JSValueMakeNumber(ctx, binding::jsc::JSEventTarget::instance(context)->dispatchedEventCount);
+}
+
 JSBridgeTest::JSBridgeTest(JSBridge *bridge) : bridge_(bridge), context(bridge->getContext()) {
   bridge->owner = this;
   JSC_GLOBAL_BINDING_FUNCTION(context, "__kraken_execute_test__", executeTest);
@@ -229,6 +235,7 @@ JSBridgeTest::JSBridgeTest(JSBridge *bridge) : bridge_(bridge), context(bridge->
   JSC_GLOBAL_BINDING_FUNCTION(context, "__kraken_environment__", environment);
   JSC_GLOBAL_BINDING_FUNCTION(context, "__kraken_simulate_pointer__", simulatePointer);
   JSC_GLOBAL_BINDING_FUNCTION(context, "__kraken_simulate_inputtext__", simulateInputText);
+  JSC_GLOBAL_BINDING_FUNCTION(context, "__kraken_dispatched_event_count__", dispatchedEventCount);
 
   initKrakenTestFramework(bridge);
 }
@@ -5,49 +5,184 @@
 
 #include "dart_methods.h"
 #include "include/kraken_bridge.h"
+#include "ui_command_compactor.h"
+#include "ui_command_trace.h"
+#include <algorithm>
 
 namespace foundation {
 
-UICommandBuffer::UICommandBuffer(int32_t contextId) : contextId(contextId) {}
+namespace {
+
+// Commands which can not change the result of layout reads of js side.
+bool affectsLayout(int32_t type) {
+  switch (type) {
+  case UICommand::disposeEventTarget:
+  case UICommand::addEvent:
+  case UICommand::removeEvent:
+  case UICommand::registerAtom:
+    return false;
+  default:
+    return true;
+  }
+}
+
+int64_t commandBytes(const UICommandItem &command) {
+  return sizeof(UICommandItem) +
+         (std::max<int32_t>(command.args_01_length, 0) + std::max<int32_t>(command.args_02_length, 0)) *
+           sizeof(uint16_t);
+}
+
+int32_t batchSizeBucket(int64_t size) {
+  int32_t bucket = 0;
+  for (int64_t limit = 1; size > limit && bucket < UI_COMMAND_BATCH_HISTOGRAM_SIZE - 1; limit *= 4) {
+    bucket++;
+  }
+  return bucket;
+}
+
+} // namespace
+
+bool UICommandBuffer::frame_flushing = false;
+
+UICommandBuffer::UICommandBuffer(int32_t contextId)
+  : contextId(contextId), geometry_snapshot(UIGeometrySnapshot::instance(contextId)),
+    command_stats(std::make_unique<UICommandStats>()) {}
+
+UICommandBuffer::~UICommandBuffer() = default;
 
 void UICommandBuffer::addCommand(int32_t id, int32_t type, void *nativePtr, bool batchedUpdate) {
   if (batchedUpdate) {
-    kraken::getDartMethod()->requestBatchUpdate(contextId);
-    update_batched = true;
+    update_batched = false;
+    requestBatchUpdate();
   }
 
   UICommandItem item{id, type, nativePtr};
-  queue.emplace_back(item);
+  push(item);
 }
 
 void UICommandBuffer::addCommand(int32_t id, int32_t type, void *nativePtr) {
-  if (!update_batched) {
-    kraken::getDartMethod()->requestBatchUpdate(contextId);
-    update_batched = true;
-  }
+  requestBatchUpdate();
 
   UICommandItem item{id, type, nativePtr};
-  queue.emplace_back(item);
+  push(item);
 }
 
 void UICommandBuffer::addCommand(int32_t id, int32_t type, NativeString &args_01, void *nativePtr) {
-  if (!update_batched) {
-    kraken::getDartMethod()->requestBatchUpdate(contextId);
-    update_batched = true;
-  }
+  requestBatchUpdate();
 
   UICommandItem item{id, type, args_01, nativePtr};
-  queue.emplace_back(item);
+  push(item);
 }
 
 void UICommandBuffer::addCommand(int32_t id, int32_t type, NativeString &args_01, NativeString &args_02,
                                                 void *nativePtr) {
-  if (!update_batched) {
-    kraken::getDartMethod()->requestBatchUpdate(contextId);
-    update_batched = true;
-  }
+  requestBatchUpdate();
   UICommandItem item{id, type, args_01, args_02, nativePtr};
-  queue.emplace_back(item);
+  push(item);
+}
+
+void UICommandBuffer::addCommand(int32_t id, int32_t type, int64_t int64_01, int64_t int64_02, void *nativePtr) {
+  requestBatchUpdate();
+  UICommandItem item{id, type, int64_01, int64_02, nativePtr};
+  push(item);
+}
+
+void UICommandBuffer::requestBatchUpdate() {
+  if (update_batched) return;
+  auto request = kraken::getDartMethod()->requestBatchUpdate;
+  // Dart methods are not available outside of the ui thread, or when replaying traces without dart side.
+  if (request != nullptr) {
+    request(contextId);
+  }
+  update_batched = true;
+}
+
+void UICommandBuffer::push(const UICommandItem &item) {
+  if (item.type >= 0 && item.type < UI_COMMAND_TYPE_COUNT) {
+    command_stats->commandCount[item.type]++;
+  }
+  command_stats->payloadBytes += commandBytes(item);
+  if (trace_writer != nullptr) {
+    trace_writer->writeCommand(item);
+  }
+
+  if (affectsLayout(item.type)) {
+    producer().layoutDirty = true;
+    geometry_snapshot->invalidate();
+  }
+  producer().queue.emplace_back(item);
+}
+
+bool UICommandBuffer::hasPendingLayoutCommands() {
+  return producer().layoutDirty || consumer().layoutDirty;
+}
+
+bool UICommandBuffer::empty() {
+  return producer().queue.empty() && static_cast<int64_t>(consumer().queue.size()) <= consumer_offset;
+}
+
+void UICommandBuffer::registerCallback(const UICommandCallbackQueue::Callback &callback, void *data) {
+  // The consuming batch is released before the producing one, see data().
+  if (!producer().queue.empty()) {
+    producer().callbacks.push_back({callback, data});
+  } else if (consumer_offset < static_cast<int64_t>(consumer().queue.size())) {
+    consumer().callbacks.push_back({callback, data});
+  } else {
+    UICommandCallbackQueue::instance()->registerCallback(callback, data);
+  }
+}
+
+void UICommandBuffer::releaseCallbacks(CommandBatch &batch) {
+  auto queue = UICommandCallbackQueue::instance();
+  for (auto &item : batch.callbacks) {
+    queue->registerCallback(item.callback, item.data);
+  }
+  batch.callbacks.clear();
+}
+
+int64_t UICommandBuffer::batchSequence() {
+  return producer().sequence;
+}
+
+bool UICommandBuffer::isBatchApplied(int64_t sequence) {
+  return sequence <= applied_sequence;
+}
+
+void UICommandBuffer::flushForLayout() {
+  if (!hasPendingLayoutCommands()) {
+    command_stats->elidedFlushCount++;
+    return;
+  }
+  kraken::getDartMethod()->flushContextUICommand(contextId);
+}
+
+int32_t UICommandBuffer::findAtom(const std::string &name) {
+  auto it = atoms.find(name);
+  return it == atoms.end() ? -1 : it->second;
+}
+
+int32_t UICommandBuffer::registerAtom(const std::string &name, NativeString &args_01) {
+  auto atom = static_cast<int32_t>(atoms.size());
+  atoms[name] = atom;
+  addCommand(atom, UICommand::registerAtom, args_01, nullptr);
+  return atom;
+}
+
+void UICommandBuffer::clearAtoms() {
+  atoms.clear();
+  // Target ids such as document and body are reused by the new js context.
+  if (compactor != nullptr) compactor->reset();
+}
+
+void UICommandBuffer::setCompactionEnabled(bool enabled) {
+  compaction_enabled = enabled;
+  if (enabled && compactor == nullptr) {
+    compactor = std::make_unique<UICommandCompactor>();
+  }
+}
+
+UICommandCompactionStats *UICommandBuffer::compactionStats() {
+  return compactor == nullptr ? nullptr : &compactor->stats;
 }
 
 UICommandBuffer *UICommandBuffer::instance(int32_t contextId) {
@@ -60,21 +195,112 @@ UICommandBuffer *UICommandBuffer::instance(int32_t contextId) {
   return instanceMap[contextId];
 }
 
+bool UICommandBuffer::startTrace(const std::string &path) {
+  trace_writer = UICommandTraceWriter::open(path);
+  return trace_writer != nullptr;
+}
+
+void UICommandBuffer::stopTrace() {
+  trace_writer.reset();
+}
+
+UICommandStats *UICommandBuffer::stats() {
+  return command_stats.get();
+}
+
+void UICommandBuffer::resetStats() {
+  *command_stats = UICommandStats();
+}
+
+void UICommandBuffer::setFrameFlushing(bool flushing) {
+  frame_flushing = flushing;
+}
+
+void UICommandBuffer::setFlushPolicy(int64_t maxCommandsPerFrame, int64_t maxBytesPerFrame) {
+  max_commands_per_frame = std::max<int64_t>(maxCommandsPerFrame, 0);
+  max_bytes_per_frame = std::max<int64_t>(maxBytesPerFrame, 0);
+}
+
 UICommandItem *UICommandBuffer::data() {
-  return queue.data();
+  if (consumer().queue.empty() && !producer().queue.empty()) {
+    producer_index = 1 - producer_index;
+    producer().sequence = next_sequence++;
+    consumer_offset = 0;
+    // Commands added after this point belongs to the next batch.
+    update_batched = false;
+    if (compaction_enabled) {
+      compactor->compact(consumer().queue);
+    }
+  }
+  slice_size = nextSliceSize();
+  if (slice_size > 0) {
+    command_stats->batchSizeHistogram[batchSizeBucket(slice_size)]++;
+    if (frame_flushing) {
+      command_stats->frameFlushCount++;
+    } else {
+      command_stats->forcedFlushCount++;
+    }
+    if (trace_writer != nullptr) {
+      trace_writer->writeFlush(slice_size, !frame_flushing);
+    }
+  }
+  return consumer().queue.data() + consumer_offset;
 }
 
 int64_t UICommandBuffer::size() {
-  return queue.size();
+  return slice_size;
 }
 
 void UICommandBuffer::clear() {
-  for (auto command : queue) {
-    delete[] reinterpret_cast<const uint16_t *>(command.string_01);
-    delete[] reinterpret_cast<const uint16_t *>(command.string_02);
+  if (slice_size > 0) {
+    consumer_offset += slice_size;
+    slice_size = 0;
+    // Strings of the remaining commands are still in use.
+    if (consumer_offset < static_cast<int64_t>(consumer().queue.size())) return;
+  } else {
+    if (trace_writer != nullptr) {
+      trace_writer->writeDiscard();
+    }
+    // Styles of the dropped commands were taken as flushed when the batch was compacted.
+    if (compactor != nullptr && consumer_offset < static_cast<int64_t>(consumer().queue.size())) {
+      compactor->reset();
+    }
+    producer().stringArena.reset();
+    producer().queue.clear();
+    producer().layoutDirty = false;
+    releaseCallbacks(producer());
+    applied_sequence = producer().sequence;
+    producer().sequence = next_sequence++;
+    update_batched = false;
+  }
+  // Dart side applies the last slice before flushing UICommandCallbackQueue.
+  releaseCallbacks(consumer());
+  applied_sequence = std::max(applied_sequence, consumer().sequence);
+  // Command strings are owned by the arena, release them all at once.
+  consumer().stringArena.reset();
+  consumer().queue.clear();
+  consumer().layoutDirty = false;
+  consumer_offset = 0;
+}
+
+int64_t UICommandBuffer::nextSliceSize() {
+  auto &queue = consumer().queue;
+  int64_t remaining = queue.size() - consumer_offset;
+  if (max_commands_per_frame > 0) {
+    remaining = std::min(remaining, max_commands_per_frame);
+  }
+  if (max_bytes_per_frame == 0) return remaining;
+
+  // Every command is a complete dom mutation, so the tree is consistent at any slice boundary.
+  int64_t bytes = 0;
+  int64_t length = 0;
+  while (length < remaining) {
+    int64_t size = commandBytes(queue[consumer_offset + length]);
+    if (length > 0 && bytes + size > max_bytes_per_frame) break;
+    bytes += size;
+    length++;
   }
-  queue.clear();
-  update_batched = false;
+  return length;
 }
 
 } // namespace foundation
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+#include "ui_command_compactor.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+namespace foundation {
+
+namespace {
+
+// Bound the memory of flushed styles, they are forgotten all at once when there are more.
+constexpr size_t MAX_FLUSHED_STYLE_COUNT = 16384;
+
+// Whether args_01 of both commands are the same key. Atom keys have negative length, see buildUICommandAtomArgs.
+bool sameKey(const UICommandItem &a, const UICommandItem &b) {
+  if (a.args_01_length != b.args_01_length) return false;
+  if (a.args_01_length <= 0) return true;
+  return memcmp(reinterpret_cast<const void *>(a.string_01), reinterpret_cast<const void *>(b.string_01),
+                a.args_01_length * sizeof(uint16_t)) == 0;
+}
+
+} // namespace
+
+void UICommandCompactor::compact(std::vector<UICommandItem> &queue) {
+  if (queue.empty()) return;
+
+  std::vector<bool> dropped(queue.size(), false);
+  cancelDisposedTargets(queue, dropped);
+  collapseSets(queue, dropped);
+  dropNoopStyles(queue, dropped);
+
+  size_t length = 0;
+  for (size_t i = 0; i < queue.size(); i++) {
+    if (dropped[i]) continue;
+    if (length != i) queue[length] = queue[i];
+    length++;
+  }
+  queue.erase(queue.begin() + length, queue.end());
+}
+
+void UICommandCompactor::reset() {
+  m_flushedStyles.clear();
+  m_flushedStyleCount = 0;
+}
+
+void UICommandCompactor::cancelDisposedTargets(std::vector<UICommandItem> &queue, std::vector<bool> &dropped) {
+  std::unordered_set<int32_t> created;
+  std::unordered_set<int32_t> disposed;
+  // Targets which had been connected to other nodes can not be cancelled.
+  std::unordered_set<int32_t> linked;
+
+  for (auto &command : queue) {
+    switch (command.type) {
+    case UICommand::createElement:
+    case UICommand::createTextNode:
+    case UICommand::createComment:
+      created.emplace(command.id);
+      break;
+    case UICommand::disposeEventTarget:
+      disposed.emplace(command.id);
+      break;
+    case UICommand::insertAdjacentNode:
+    case UICommand::cloneNode:
+      linked.emplace(command.id);
+      // The other target id is carried by int64_01.
+      linked.emplace(static_cast<int32_t>(command.int64_01));
+      break;
+    case UICommand::removeNode:
+      linked.emplace(command.id);
+      break;
+    default:
+      break;
+    }
+  }
+
+  std::unordered_set<int32_t> cancelled;
+  for (int32_t id : disposed) {
+    if (created.count(id) > 0 && linked.count(id) == 0) cancelled.emplace(id);
+  }
+  if (cancelled.empty()) return;
+
+  for (size_t i = 0; i < queue.size(); i++) {
+    // The id of registerAtom is an atom, not a target.
+    if (queue[i].type == UICommand::registerAtom) continue;
+    if (cancelled.count(queue[i].id) > 0) {
+      dropped[i] = true;
+      stats.cancelledCommandCount++;
+    }
+  }
+}
+
+void UICommandCompactor::collapseSets(std::vector<UICommandItem> &queue, std::vector<bool> &dropped) {
+  // Walk backward, a set is redundant if the next set of the same kind on the same target has the same key. Sets of
+  // other keys are never reordered with it, which matters to keys like transition that apply to the changes after.
+  // target id -> index of the next set. Style and property keys are in different namespaces.
+  std::unordered_map<int32_t, size_t> nextStyles;
+  std::unordered_map<int32_t, size_t> nextProperties;
+
+  for (size_t i = queue.size(); i-- > 0;) {
+    if (dropped[i]) continue;
+    UICommandItem &command = queue[i];
+
+    switch (command.type) {
+    case UICommand::setStyle:
+    case UICommand::setProperty: {
+      auto &next = command.type == UICommand::setStyle ? nextStyles : nextProperties;
+      auto it = next.find(command.id);
+      if (it != next.end() && sameKey(queue[it->second], command)) {
+        dropped[i] = true;
+        stats.collapsedSetCount++;
+      } else {
+        next[command.id] = i;
+      }
+      break;
+    }
+    case UICommand::removeProperty:
+      nextProperties.erase(command.id);
+      break;
+    case UICommand::cloneNode:
+      // Clone copies the current styles and properties of the source target.
+      nextStyles.erase(command.id);
+      nextProperties.erase(command.id);
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+void UICommandCompactor::dropNoopStyles(std::vector<UICommandItem> &queue, std::vector<bool> &dropped) {
+  for (size_t i = 0; i < queue.size(); i++) {
+    if (dropped[i]) continue;
+    UICommandItem &command = queue[i];
+
+    if (command.type == UICommand::disposeEventTarget) {
+      auto it = m_flushedStyles.find(command.id);
+      if (it != m_flushedStyles.end()) {
+        m_flushedStyleCount -= it->second.size();
+        m_flushedStyles.erase(it);
+      }
+      continue;
+    }
+
+    if (command.type != UICommand::setStyle || command.args_01_length >= 0) continue;
+
+    int32_t atom = -command.args_01_length - 1;
+    auto value = reinterpret_cast<const char16_t *>(command.string_02);
+    size_t length = command.string_02 == 0 ? 0 : std::max<int32_t>(command.args_02_length, 0);
+
+    auto &styles = m_flushedStyles[command.id];
+    auto style = std::find_if(styles.begin(), styles.end(), [atom](const FlushedStyle &s) { return s.atom == atom; });
+    if (style == styles.end()) {
+      if (m_flushedStyleCount >= MAX_FLUSHED_STYLE_COUNT) {
+        reset();
+        // styles is invalidated by reset().
+        m_flushedStyles[command.id].push_back({atom, std::u16string(value, length)});
+      } else {
+        styles.push_back({atom, std::u16string(value, length)});
+      }
+      m_flushedStyleCount++;
+    } else if (style->value.size() == length && std::char_traits<char16_t>::compare(style->value.data(), value,
+                                                                                      length) == 0) {
+      dropped[i] = true;
+      stats.noopSetCount++;
+    } else {
+      // Reuses the buffer of the previous value.
+      style->value.assign(value, length);
+    }
+  }
+}
+
+} // namespace foundation
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+#ifndef KRAKENBRIDGE_UI_COMMAND_COMPACTOR_H
+#define KRAKENBRIDGE_UI_COMMAND_COMPACTOR_H
+
+#include "include/kraken_bridge.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace foundation {
+
+// Remove redundant commands of a batch before dart side reads them:
+// 1. Commands of targets which are created and disposed in the same batch without ever being inserted.
+// 2. setStyle and setProperty overwritten by the next set of the same target, when it has the same key.
+// 3. setStyle with the same value as the one flushed to dart side last time.
+class UICommandCompactor {
+public:
+  UICommandCompactor() = default;
+
+  void compact(std::vector<UICommandItem> &queue);
+  // Forget all flushed styles, should be called when js context recreated or when commands are dropped without
+  // reaching dart side.
+  void reset();
+
+  UICommandCompactionStats stats{};
+
+private:
+  void cancelDisposedTargets(std::vector<UICommandItem> &queue, std::vector<bool> &dropped);
+  void collapseSets(std::vector<UICommandItem> &queue, std::vector<bool> &dropped);
+  void dropNoopStyles(std::vector<UICommandItem> &queue, std::vector<bool> &dropped);
+
+  struct FlushedStyle {
+    int32_t atom;
+    std::u16string value;
+  };
+  // target id -> last flushed values. Only styles with atom keys are tracked, an element has few of them.
+  std::unordered_map<int32_t, std::vector<FlushedStyle>> m_flushedStyles;
+  size_t m_flushedStyleCount{0};
+};
+
+} // namespace foundation
+
+#endif // KRAKENBRIDGE_UI_COMMAND_COMPACTOR_H
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+#include "include/kraken_foundation.h"
+#include <algorithm>
+#include <cstring>
+
+namespace foundation {
+
+// 32KB per chunk, large enough to hold all style commands of a common frame.
+static constexpr size_t ARENA_CHUNK_SIZE = 16 * 1024;
+
+uint16_t *UICommandStringArena::allocate(size_t length) {
+  m_stringAllocationCount++;
+
+  while (m_chunkIndex < m_chunks.size()) {
+    Chunk &chunk = m_chunks[m_chunkIndex];
+    if (m_offset + length <= chunk.capacity) {
+      uint16_t *result = chunk.data.get() + m_offset;
+      m_offset += length;
+      return result;
+    }
+    m_chunkIndex++;
+    m_offset = 0;
+  }
+
+  size_t capacity = std::max(ARENA_CHUNK_SIZE, length);
+  m_chunks.emplace_back(Chunk{std::unique_ptr<uint16_t[]>(new uint16_t[capacity]), capacity});
+  m_heapAllocationCount++;
+
+  m_chunkIndex = m_chunks.size() - 1;
+  m_offset = length;
+  return m_chunks[m_chunkIndex].data.get();
+}
+
+const uint16_t *UICommandStringArena::copy(const uint16_t *string, size_t length) {
+  uint16_t *result = allocate(length);
+  if (length > 0) {
+    memcpy(result, string, length * sizeof(uint16_t));
+  }
+  return result;
+}
+
+void UICommandStringArena::reset() {
+  m_chunkIndex = 0;
+  m_offset = 0;
+}
+
+} // namespace foundation
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+#include "ui_command_trace.h"
+
+namespace foundation {
+
+namespace {
+
+// Trace is written from the ui thread, keep a large stdio buffer so recording does not hit the disk per command.
+constexpr size_t TRACE_WRITE_BUFFER_SIZE = 64 * 1024;
+
+template <typename T> void writeValue(FILE *file, const T &value) {
+  fwrite(&value, sizeof(T), 1, file);
+}
+
+template <typename T> bool readValue(FILE *file, T &value) {
+  return fread(&value, sizeof(T), 1, file) == 1;
+}
+
+void writePayload(FILE *file, int64_t string, int32_t length) {
+  if (length <= 0 || string == 0) return;
+  fwrite(reinterpret_cast<const uint16_t *>(string), sizeof(uint16_t), length, file);
+}
+
+bool readPayload(FILE *file, int32_t length, std::u16string &payload) {
+  payload.clear();
+  if (length <= 0) return true;
+  payload.resize(length);
+  return fread(&payload[0], sizeof(char16_t), length, file) == static_cast<size_t>(length);
+}
+
+bool hasArgument(int64_t string, int32_t length) {
+  return string != 0 || length != 0;
+}
+
+} // namespace
+
+std::unique_ptr<UICommandTraceWriter> UICommandTraceWriter::open(const std::string &path) {
+  FILE *file = fopen(path.c_str(), "wb");
+  if (file == nullptr) return nullptr;
+  setvbuf(file, nullptr, _IOFBF, TRACE_WRITE_BUFFER_SIZE);
+  writeValue(file, UI_COMMAND_TRACE_MAGIC);
+  writeValue(file, UI_COMMAND_TRACE_VERSION);
+  return std::unique_ptr<UICommandTraceWriter>(new UICommandTraceWriter(file));
+}
+
+UICommandTraceWriter::~UICommandTraceWriter() {
+  fclose(m_file);
+}
+
+void UICommandTraceWriter::writeCommand(const UICommandItem &item) {
+  UICommandTraceCommand command{item.type,          item.id,       item.args_01_length,
+                                item.args_02_length, item.int64_01, item.int64_02};
+  writeValue(m_file, UICommandTraceTag::command);
+  uint8_t args = (hasArgument(item.string_01, item.args_01_length) ? UICommandTraceArgs::hasArgs01 : 0) |
+                 (hasArgument(item.string_02, item.args_02_length) ? UICommandTraceArgs::hasArgs02 : 0);
+  writeValue(m_file, command);
+  writeValue(m_file, args);
+  writePayload(m_file, item.string_01, item.args_01_length);
+  writePayload(m_file, item.string_02, item.args_02_length);
+}
+
+void UICommandTraceWriter::writeFlush(int64_t size, bool forced) {
+  writeValue(m_file, UICommandTraceTag::flush);
+  writeValue(m_file, size);
+  writeValue(m_file, static_cast<uint8_t>(forced ? 1 : 0));
+}
+
+void UICommandTraceWriter::writeDiscard() {
+  writeValue(m_file, UICommandTraceTag::discard);
+}
+
+std::unique_ptr<UICommandTraceReader> UICommandTraceReader::open(const std::string &path) {
+  FILE *file = fopen(path.c_str(), "rb");
+  if (file == nullptr) return nullptr;
+
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  if (!readValue(file, magic) || !readValue(file, version) || magic != UI_COMMAND_TRACE_MAGIC ||
+      version != UI_COMMAND_TRACE_VERSION) {
+    fclose(file);
+    return nullptr;
+  }
+  return std::unique_ptr<UICommandTraceReader>(new UICommandTraceReader(file));
+}
+
+UICommandTraceReader::~UICommandTraceReader() {
+  fclose(m_file);
+}
+
+bool UICommandTraceReader::next(UICommandTraceRecord &record) {
+  if (!readValue(m_file, record.tag)) return false;
+
+  switch (record.tag) {
+  case UICommandTraceTag::command:
+    return readValue(m_file, record.command) && readValue(m_file, record.args) &&
+           readPayload(m_file, record.command.args_01_length, record.args_01) &&
+           readPayload(m_file, record.command.args_02_length, record.args_02);
+  case UICommandTraceTag::flush: {
+    uint8_t forced = 0;
+    if (!readValue(m_file, record.flushSize) || !readValue(m_file, forced)) return false;
+    record.forced = forced == 1;
+    return true;
+  }
+  case UICommandTraceTag::discard:
+    return true;
+  default:
+    return false;
+  }
+}
+
+} // namespace foundation
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+#ifndef KRAKENBRIDGE_UI_COMMAND_TRACE_H
+#define KRAKENBRIDGE_UI_COMMAND_TRACE_H
+
+#include "include/kraken_bridge.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace foundation {
+
+// Binary trace of a ui command stream. A trace starts with UI_COMMAND_TRACE_MAGIC and UI_COMMAND_TRACE_VERSION,
+// followed by records, each starts with a UICommandTraceTag:
+// 1. command: UICommandTraceCommand, then uint8_t UICommandTraceArgs bits of the arguments the command was created
+//    with, then payload strings of args_01 and args_02 in UTF-16 code units. Atom arguments (negative length) have
+//    no payload. Native pointers are not recorded.
+// 2. flush: int64_t size of the batch read by dart side, then uint8_t 1 if the flush was forced.
+// 3. discard: pending commands were dropped without being read.
+// All values are in host byte order.
+constexpr uint32_t UI_COMMAND_TRACE_MAGIC = 0x5443554b; // "KUCT"
+constexpr uint32_t UI_COMMAND_TRACE_VERSION = 3;
+
+enum class UICommandTraceTag : uint8_t { command = 1, flush = 2, discard = 3 };
+
+// An empty string argument (such as the value of a removed style) differs from a missing one.
+enum UICommandTraceArgs : uint8_t { hasArgs01 = 1 << 0, hasArgs02 = 1 << 1 };
+
+struct UICommandTraceCommand {
+  int32_t type;
+  int32_t id;
+  int32_t args_01_length;
+  int32_t args_02_length;
+  int64_t int64_01;
+  int64_t int64_02;
+};
+
+class UICommandTraceWriter {
+public:
+  // Returns nullptr if path can not be opened for writing.
+  static std::unique_ptr<UICommandTraceWriter> open(const std::string &path);
+  ~UICommandTraceWriter();
+
+  void writeCommand(const UICommandItem &item);
+  void writeFlush(int64_t size, bool forced);
+  void writeDiscard();
+
+private:
+  explicit UICommandTraceWriter(FILE *file) : m_file(file){};
+  FILE *m_file;
+};
+
+struct UICommandTraceRecord {
+  UICommandTraceTag tag;
+  UICommandTraceCommand command;
+  uint8_t args;
+  std::u16string args_01;
+  std::u16string args_02;
+  int64_t flushSize;
+  bool forced;
+};
+
+class UICommandTraceReader {
+public:
+  // Returns nullptr if path can not be opened or is not a trace of this version.
+  static std::unique_ptr<UICommandTraceReader> open(const std::string &path);
+  ~UICommandTraceReader();
+
+  // Returns false at the end of trace, or if the trace is truncated.
+  bool next(UICommandTraceRecord &record);
+
+private:
+  explicit UICommandTraceReader(FILE *file) : m_file(file){};
+  FILE *m_file;
+};
+
+} // namespace foundation
+
+#endif // KRAKENBRIDGE_UI_COMMAND_TRACE_H
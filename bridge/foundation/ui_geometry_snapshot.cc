@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+#include "include/kraken_bridge.h"
+#include "include/kraken_foundation.h"
+#include <algorithm>
+
+namespace foundation {
+
+namespace {
+
+// Targets which have not been read for about one second at 60fps are no longer published.
+constexpr uint32_t MAX_IDLE_PUBLISHES = 60;
+
+} // namespace
+
+int64_t UIGeometrySnapshot::layout_epoch = 0;
+
+UIGeometrySnapshot::UIGeometrySnapshot(int32_t contextId)
+  : contextId(contextId), native_snapshot(std::make_unique<NativeGeometrySnapshot>()) {}
+
+UIGeometrySnapshot::~UIGeometrySnapshot() = default;
+
+UIGeometrySnapshot *UIGeometrySnapshot::instance(int32_t contextId) {
+  static std::unordered_map<int32_t, UIGeometrySnapshot *> instanceMap;
+
+  if (instanceMap.count(contextId) == 0) {
+    instanceMap[contextId] = new UIGeometrySnapshot(contextId);
+  }
+
+  return instanceMap[contextId];
+}
+
+const double *UIGeometrySnapshot::read(int32_t targetId) {
+  auto it = slots.find(targetId);
+  if (it == slots.end()) {
+    slots[targetId] = target_ids.size();
+    target_ids.emplace_back(targetId);
+    rows.resize(rows.size() + GEOMETRY_ROW_SIZE, 0);
+    published.emplace_back(false);
+    idle_publishes.emplace_back(0);
+    return nullptr;
+  }
+
+  size_t slot = it->second;
+  idle_publishes[slot] = 0;
+  if (!valid || committed_epoch != layout_epoch || !published[slot]) return nullptr;
+  return rows.data() + slot * GEOMETRY_ROW_SIZE;
+}
+
+void UIGeometrySnapshot::unwatch(int32_t targetId) {
+  auto it = slots.find(targetId);
+  if (it == slots.end()) return;
+  removeSlot(it->second);
+}
+
+void UIGeometrySnapshot::removeSlot(size_t slot) {
+  // Move the last row into the slot of the removed one.
+  slots.erase(target_ids[slot]);
+  size_t last = target_ids.size() - 1;
+  if (slot != last) {
+    target_ids[slot] = target_ids[last];
+    std::copy(rows.begin() + last * GEOMETRY_ROW_SIZE, rows.end(), rows.begin() + slot * GEOMETRY_ROW_SIZE);
+    published[slot] = published[last];
+    idle_publishes[slot] = idle_publishes[last];
+    slots[target_ids[slot]] = slot;
+  }
+
+  target_ids.pop_back();
+  rows.resize(last * GEOMETRY_ROW_SIZE);
+  published.pop_back();
+  idle_publishes.pop_back();
+}
+
+void UIGeometrySnapshot::invalidate() {
+  valid = false;
+}
+
+void UIGeometrySnapshot::commit() {
+  // Rows written before pending commands were applied are already out of date.
+  valid = !UICommandBuffer::instance(contextId)->hasPendingLayoutCommands();
+  committed_epoch = layout_epoch;
+  std::fill(published.begin(), published.end(), true);
+}
+
+NativeGeometrySnapshot *UIGeometrySnapshot::nativeSnapshot() {
+  for (size_t slot = target_ids.size(); slot-- > 0;) {
+    if (++idle_publishes[slot] > MAX_IDLE_PUBLISHES) removeSlot(slot);
+  }
+
+  // Vectors may be reallocated by read(), so pointers are refreshed every time dart side asks for them.
+  native_snapshot->targetIds = target_ids.data();
+  native_snapshot->rows = rows.data();
+  native_snapshot->length = target_ids.size();
+  return native_snapshot.get();
+}
+
+int64_t *UIGeometrySnapshot::layoutEpoch() {
+  return &layout_epoch;
+}
+
+} // namespace foundation
@@ -39,9 +39,12 @@ typedef void (*ToBlob)(void *callbackContext, int32_t contextId, AsyncBlobCallba
                        double devicePixelRatio);
 typedef void (*OnJSError)(int32_t contextId, const char *);
 typedef void (*FlushUICommand)();
+typedef void (*FlushContextUICommand)(int32_t contextId);
 typedef void (*InitHTML)(int32_t contextId, void *nativePtr);
 typedef void (*InitWindow)(int32_t contextId, void *nativePtr);
 typedef void (*InitDocument)(int32_t contextId, void *nativePtr);
+// Write 8 doubles of the bounding client rect of each target into rects, in the order of NativeBoundingClientRect.
+typedef void (*GetBoundingClientRects)(int32_t contextId, int32_t *targetIds, int32_t length, double *rects);
 
 using MatchImageSnapshotCallback = void (*)(void *callbackContext, int32_t contextId, int8_t);
 using MatchImageSnapshot = void (*)(void *callbackContext, int32_t contextId, uint8_t *bytes, int32_t length,
@@ -86,12 +89,14 @@ struct DartMethodPointer {
   SimulatePointer simulatePointer{nullptr};
   SimulateInputText simulateInputText{nullptr};
   FlushUICommand flushUICommand{nullptr};
+  FlushContextUICommand flushContextUICommand{nullptr};
 #if ENABLE_PROFILE
   GetPerformanceEntries getPerformanceEntries{nullptr};
 #endif
   InitHTML initHTML{nullptr};
   InitWindow initWindow{nullptr};
   InitDocument initDocument{nullptr};
+  GetBoundingClientRects getBoundingClientRects{nullptr};
 };
 
 void registerDartMethods(uint64_t *methodBytes, int32_t length);
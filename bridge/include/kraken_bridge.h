@@ -57,6 +57,15 @@ enum UICommand {
   removeProperty,
   cloneNode,
   removeEvent,
+  registerAtom,
+};
+
+// Position argument of insertAdjacentNode command.
+enum AdjacentPosition {
+  beforeBegin,
+  afterBegin,
+  beforeEnd,
+  afterEnd,
 };
 
 struct KRAKEN_EXPORT UICommandItem {
@@ -69,6 +78,9 @@ struct KRAKEN_EXPORT UICommandItem {
       nativePtr(reinterpret_cast<int64_t>(nativePtr)){};
   UICommandItem(int32_t id, int32_t type, void *nativePtr)
     : type(type), id(id), nativePtr(reinterpret_cast<int64_t>(nativePtr)){};
+  UICommandItem(int32_t id, int32_t type, int64_t int64_01, int64_t int64_02, void *nativePtr)
+    : type(type), id(id), nativePtr(reinterpret_cast<int64_t>(nativePtr)), int64_01(int64_01),
+      int64_02(int64_02){};
   int32_t type;
   int32_t id;
   int32_t args_01_length{0};
@@ -76,6 +88,48 @@ struct KRAKEN_EXPORT UICommandItem {
   int64_t string_01{0};
   int64_t string_02{0};
   int64_t nativePtr{0};
+  // Numeric arguments such as target ids and enums, which should not be formatted to strings.
+  int64_t int64_01{0};
+  int64_t int64_02{0};
+};
+
+constexpr int32_t UI_COMMAND_TYPE_COUNT = UICommand::registerAtom + 1;
+// Buckets of batch sizes: 1, 2-4, 5-16, 17-64, 65-256, 257-1024, 1025-4096 and more than 4096.
+constexpr int32_t UI_COMMAND_BATCH_HISTOGRAM_SIZE = 8;
+
+struct KRAKEN_EXPORT UICommandStats {
+  // Commands added by js side, indexed by UICommand.
+  int64_t commandCount[UI_COMMAND_TYPE_COUNT]{};
+  // Size of command items and their payload strings.
+  int64_t payloadBytes{0};
+  // Size of command batches read by dart side.
+  int64_t batchSizeHistogram[UI_COMMAND_BATCH_HISTOGRAM_SIZE]{};
+  // Batches read by the frame callback of dart side.
+  int64_t frameFlushCount{0};
+  // Batches read by synchronous flushes, such as layout reads of js side.
+  int64_t forcedFlushCount{0};
+  // Layout reads which skipped flushing because no layout affecting command was pending.
+  int64_t elidedFlushCount{0};
+};
+
+struct KRAKEN_EXPORT UICommandCompactionStats {
+  // setStyle and setProperty commands overwritten by a later one with the same target and key.
+  int64_t collapsedSetCount{0};
+  // setStyle commands with the same value as the last flushed one.
+  int64_t noopSetCount{0};
+  // Commands of targets which were created and disposed in the same batch.
+  int64_t cancelledCommandCount{0};
+};
+
+// Geometry rows of elements published by dart side. Each row is GEOMETRY_ROW_SIZE doubles: values of
+// ViewModuleProperty in order, followed by the bounding client rect in the order of NativeBoundingClientRect.
+constexpr int32_t GEOMETRY_ROW_SIZE = 20;
+constexpr int32_t GEOMETRY_BOUNDING_CLIENT_RECT_OFFSET = 12;
+
+struct NativeGeometrySnapshot {
+  int32_t *targetIds{nullptr};
+  double *rows{nullptr};
+  int64_t length{0};
 };
 
 typedef void (*Task)(void *);
@@ -125,6 +179,36 @@ int64_t getUICommandItemSize(int32_t contextId);
 KRAKEN_EXPORT_C
 void clearUICommandItems(int32_t contextId);
 KRAKEN_EXPORT_C
+void setUICommandCompactionEnabled(int32_t contextId, int32_t enabled);
+KRAKEN_EXPORT_C
+UICommandCompactionStats *getUICommandCompactionStats(int32_t contextId);
+// Limit the ui commands flushed to dart side in one frame, remaining commands are deferred to the next frames.
+// Zero means unlimited, which is the default.
+KRAKEN_EXPORT_C
+void setUICommandFlushPolicy(int32_t contextId, int64_t maxCommandsPerFrame, int64_t maxBytesPerFrame);
+KRAKEN_EXPORT_C
+UICommandStats *getUICommandStats(int32_t contextId);
+KRAKEN_EXPORT_C
+void resetUICommandStats(int32_t contextId);
+// Called by dart side around the flush of each frame, so batches can be counted as frame or forced flushes.
+KRAKEN_EXPORT_C
+void setUICommandFrameFlushing(int32_t flushing);
+// Record ui commands of the context into a binary trace file at path, returns 0 if the file can not be opened.
+KRAKEN_EXPORT_C
+int32_t startUICommandTrace(int32_t contextId, const char *path);
+KRAKEN_EXPORT_C
+void stopUICommandTrace(int32_t contextId);
+KRAKEN_EXPORT_C
+NativeGeometrySnapshot *getGeometrySnapshot(int32_t contextId);
+KRAKEN_EXPORT_C
+void commitGeometrySnapshot(int32_t contextId);
+KRAKEN_EXPORT_C
+int64_t *getGeometryLayoutEpoch();
+KRAKEN_EXPORT_C
+void flushCanvasDisplayLists(int32_t contextId);
+KRAKEN_EXPORT_C
+void setCanvasRecordingEnabled(int32_t enabled);
+KRAKEN_EXPORT_C
 void registerContextDisposedCallbacks(int32_t contextId, Task task, void *data);
 KRAKEN_EXPORT_C
 void registerPluginSource(NativeString* code, const char *pluginName);
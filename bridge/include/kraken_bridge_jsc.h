@@ -10,16 +10,19 @@
 // All the struct which prefix with NativeXXX struct (exp: NativeElement) has a corresponding struct in Dart code.
 // All struct members include variables and functions must be follow the same order with Dart class, to keep the same memory layout cross dart and C++ code.
 #include "kraken_foundation.h"
+#include "kraken_small_vector.h"
 #include <JavaScriptCore/JavaScript.h>
 #include <chrono>
 #include <deque>
 #include <cassert>
 #include <functional>
 #include <map>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 #include <forward_list>
 #include "third_party/gumbo-parser/src/gumbo.h"
+#include "bindings/jsc/DOM/css_property_names.h"
 
 using JSExceptionHandler = std::function<void(int32_t contextId, const char *errmsg, JSObjectRef error)>;
 
@@ -42,6 +45,7 @@ class JSEventTarget;
 class EventTargetInstance;
 class JSNode;
 class NodeInstance;
+class JSNodeList;
 struct NativeNode;
 class JSDocument;
 class DocumentCookie;
@@ -66,6 +70,92 @@ class MouseEventInstance;
 struct NativePopStateEvent;
 class PopStateEventInstance;
 
+// Retained strings of names the bridge looks up or returns repeatedly: property names, tag names, event types and
+// CSS property names. Atoms are owned by the table and released with the context, callers must not release them.
+// Only names from a bounded set should be interned, never arbitrary user strings.
+class JSStringAtomTable {
+public:
+  JSStringAtomTable() = default;
+  ~JSStringAtomTable();
+
+  JSStringRef atom(const char *name, size_t length);
+  JSStringRef atom(const JSChar *chars, size_t length);
+  // A protected js string value of the atom, returning it to js does not allocate a new string.
+  JSValueRef value(JSContextRef ctx, JSStringRef atom);
+  void unprotectValues(JSContextRef ctx);
+
+private:
+  struct Atom {
+    JSStringRef string;
+    JSValueRef value;
+  };
+  Atom &find(const JSChar *chars, size_t length);
+
+  // Keys point to the characters of the retained atom strings.
+  std::unordered_map<std::u16string_view, Atom> m_atoms;
+  std::u16string m_buffer;
+  KRAKEN_DISALLOW_COPY_ASSIGN_AND_MOVE(JSStringAtomTable);
+};
+
+// Slots of host classes in BindingState, one for each host class created once per context.
+enum class BindingSlot : uint8_t {
+  JSEventTarget,
+  JSWindow,
+  JSNode,
+  JSDocument,
+  JSElement,
+  JSTextNode,
+  JSCommentNode,
+  CSSStyleDeclaration,
+  JSAnchorElement,
+  JSCanvasElement,
+  CanvasRenderingContext2D,
+  JSImageElement,
+  JSInputElement,
+  JSObjectElement,
+  JSScriptElement,
+  JSSVGElement,
+  JSEvent,
+  JSCustomEvent,
+  JSCloseEvent,
+  JSGestureEvent,
+  JSInputEvent,
+  JSIntersectionChangeEvent,
+  JSMediaErrorEvent,
+  JSMessageEvent,
+  JSMouseEvent,
+  JSPopStateEvent,
+  JSTouchEvent,
+  JSBlob,
+  COUNT
+};
+
+// Per-context objects of the bindings, reached from JSContext without any map lookup: host classes of the context,
+// its document and its ui command buffer.
+class BindingState {
+public:
+  BindingState() = default;
+
+  template <typename T> T *hostClass(BindingSlot slot) const {
+    return static_cast<T *>(m_hostClasses[static_cast<size_t>(slot)]);
+  }
+  void setHostClass(BindingSlot slot, HostClass *hostClass) {
+    m_hostClasses[static_cast<size_t>(slot)] = hostClass;
+  }
+  // Called by destructors of host classes. The slot is left alone when it holds another class, destructors of base
+  // classes run for every subclass too.
+  void removeHostClass(BindingSlot slot, HostClass *hostClass) {
+    if (m_hostClasses[static_cast<size_t>(slot)] == hostClass) setHostClass(slot, nullptr);
+  }
+
+  DocumentInstance *document{nullptr};
+  ::foundation::UICommandBuffer *commandBuffer{nullptr};
+
+private:
+  HostClass *m_hostClasses[static_cast<size_t>(BindingSlot::COUNT)]{};
+  KRAKEN_DISALLOW_COPY_ASSIGN_AND_MOVE(BindingState);
+};
+
 class JSContext {
 public:
   static std::vector<JSStaticFunction> globalFunctions;
@@ -91,6 +181,20 @@ public:
 
   KRAKEN_EXPORT void reportError(const char *errmsg);
 
+  // Atoms of this context, see JSStringAtomTable.
+  KRAKEN_EXPORT JSStringRef atom(const char *name);
+  KRAKEN_EXPORT JSStringRef atom(const std::string &name);
+  KRAKEN_EXPORT JSStringRef atom(const JSChar *chars, size_t length);
+  KRAKEN_EXPORT JSStringRef atom(JSStringRef string);
+  KRAKEN_EXPORT JSValueRef atomValue(JSStringRef atom);
+
+  BindingState &bindingState() {
+    return m_bindingState;
+  }
+  ::foundation::UICommandBuffer *commandBuffer() {
+    return m_bindingState.commandBuffer;
+  }
+
   std::chrono::time_point<std::chrono::system_clock> timeOrigin;
 
   int32_t uniqueId;
@@ -101,6 +205,8 @@ private:
   void *owner;
   std::atomic<bool> ctxInvalid_{false};
   JSGlobalContextRef ctx_;
+  JSStringAtomTable m_atomTable;
+  BindingState m_bindingState;
 };
 
 class HTMLParser {
@@ -167,12 +273,23 @@ private:
   KRAKEN_DISALLOW_COPY_ASSIGN_AND_MOVE(JSValueHolder);
 };
 
-void KRAKEN_EXPORT buildUICommandArgs(JSStringRef key, NativeString &args_01);
-void KRAKEN_EXPORT buildUICommandArgs(std::string &key, NativeString &args_01);
-void KRAKEN_EXPORT buildUICommandArgs(std::string &key, JSStringRef value, NativeString &args_01,
-                                      NativeString &args_02);
-void KRAKEN_EXPORT buildUICommandArgs(std::string &key, std::string &value, NativeString &args_01,
-                                      NativeString &args_02);
+// UI command arguments are copied into the string arena of the context's UICommandBuffer, and stay valid
+// until dart side has consumed the commands and called clearUICommandItems.
+void KRAKEN_EXPORT buildUICommandArgs(JSContext *context, JSStringRef key, NativeString &args_01);
+void KRAKEN_EXPORT buildUICommandArgs(JSContext *context, std::string &key, NativeString &args_01);
+void KRAKEN_EXPORT buildUICommandArgs(JSContext *context, std::string &key, JSStringRef value,
+                                      NativeString &args_01, NativeString &args_02);
+void KRAKEN_EXPORT buildUICommandArgs(JSContext *context, std::string &key, std::string &value,
+                                      NativeString &args_01, NativeString &args_02);
+// Same as buildUICommandArgs, but key (tag name, style property name or event type) is sent as an atom id of
+// the context instead of a string.
+void KRAKEN_EXPORT buildUICommandAtomArgs(JSContext *context, const std::string &key, NativeString &args_01);
+void KRAKEN_EXPORT buildUICommandAtomArgs(JSContext *context, const std::string &key, JSStringRef value,
+                                          NativeString &args_01, NativeString &args_02);
+void KRAKEN_EXPORT buildUICommandAtomArgs(JSContext *context, const std::string &key, std::string &value,
+                                          NativeString &args_01, NativeString &args_02);
+void KRAKEN_EXPORT buildUICommandAtomArgs(JSContext *context, const std::string &key, const std::u16string &value,
+                                          NativeString &args_01, NativeString &args_02);
 
 void KRAKEN_EXPORT throwJSError(JSContextRef ctx, const char *msg, JSValueRef *exception);
 
@@ -180,6 +297,11 @@ KRAKEN_EXPORT NativeString *stringToNativeString(std::string &string);
 KRAKEN_EXPORT NativeString *stringRefToNativeString(JSStringRef string);
 
 
+// Return the class of the definition, which is created once per process and shared by every context and object.
+// className is compared by content, callbacks, static tables and parentClass by address, so static tables must have
+// static storage. The class is owned by the registry, callers must not release it.
+KRAKEN_EXPORT JSClassRef JSClassGetShared(const JSClassDefinition &definition);
+
 KRAKEN_EXPORT JSObjectRef makeObjectFunctionWithPrivateData(JSContext *context, void *data, const char *name,
                                                 JSObjectCallAsFunctionCallback callback);
 
@@ -292,6 +414,8 @@ public:
   public:
     Instance() = delete;
     KRAKEN_EXPORT explicit Instance(HostClass *hostClass);
+    // Adopt a js object of the instance class which has never been exposed to js, or create one when it is null.
+    KRAKEN_EXPORT Instance(HostClass *hostClass, JSObjectRef object);
     KRAKEN_EXPORT virtual ~Instance();
     KRAKEN_EXPORT virtual JSValueRef getProperty(std::string &name, JSValueRef *exception);
     KRAKEN_EXPORT virtual bool setProperty(std::string &name, JSValueRef value, JSValueRef *exception);
@@ -324,6 +448,12 @@ public:
   JSObjectRef prototypeObject{nullptr};
   JSObjectRef _call{nullptr};
 
+protected:
+  // Define accessors generated from the idl of this class on its instances. The static values are checked by JSC
+  // before the dynamic getProperty and setProperty of the instance, names found there never go through
+  // proxyInstanceGetProperty. Subclasses call it after their parent, so their own attributes are checked first.
+  void defineInstanceStaticValues(const JSStaticValue *staticValues);
+
 private:
   // The class template of javascript constructor function.
   JSClassRef jsClass{nullptr};
@@ -352,11 +482,9 @@ using EventCreator = EventInstance *(*)(JSContext *context, void *nativeEvent);
 
 class JSEvent : public HostClass {
 public:
-  DEFINE_OBJECT_PROPERTY(Event, 10, type, bubbles, cancelable, timestamp, defaultPrevented, target, srcElement,
-                         currentTarget, returnValue, cancelBubble)
-  DEFINE_PROTOTYPE_OBJECT_PROPERTY(Event, 4, stopImmediatePropagation, stopPropagation, preventDefault, initEvent)
+  DEFINE_PROTOTYPE_OBJECT_PROPERTY(Event, 5, stopImmediatePropagation, stopPropagation, preventDefault, initEvent,
+                                   getCoalescedEvents)
 
-  static std::unordered_map<JSContext *, JSEvent *> instanceMap;
   static std::unordered_map<std::string, EventCreator> eventCreatorMap;
   OBJECT_INSTANCE(JSEvent)
   // Create an Event Object from an nativeEvent address which allocated by dart side.
@@ -375,8 +503,18 @@ public:
   static JSValueRef preventDefault(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argumentCount,
                                    const JSValueRef arguments[], JSValueRef *exception);
 
+  static JSValueRef getCoalescedEvents(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+                                       size_t argumentCount, const JSValueRef arguments[], JSValueRef *exception);
+
   static EventInstance *buildEventInstance(std::string &eventType, JSContext *context, void *nativeEvent,
                                            bool isCustomEvent);
+  // Same as above with an event type atom of context, the creator of each atom is looked up once per context.
+  static EventInstance *buildEventInstance(JSStringRef eventType, JSContext *context, void *nativeEvent,
+                                           bool isCustomEvent);
+
+  // Free an event which has been dispatched from dart without reaching any listener. Its js object was never
+  // exposed, so it is kept for the next instance of this class instead of being left to the GC.
+  void recycleEventInstance(EventInstance *event);
 
   static void defineEvent(std::string eventType, EventCreator creator);
 
@@ -393,12 +531,18 @@ protected:
 
 private:
   friend EventInstance;
+  // Objects of recycled instances, protected while they are in the pool.
+  static constexpr size_t MAX_POOLED_OBJECTS = 8;
+  std::vector<JSObjectRef> m_pooledObjects;
+  std::unordered_map<JSStringRef, EventCreator> m_eventCreators;
+  JSObjectRef takePooledObject();
   JSFunctionHolder m_initWithNativeEvent{context, classObject, this, "__initWithNativeEvent__", initWithNativeEvent};
   JSFunctionHolder m_stopImmediatePropagation{context, prototypeObject, this, "stopImmediatePropagation",
                                               stopImmediatePropagation};
   JSFunctionHolder m_stopPropagation{context, prototypeObject, this, "stopPropagation", stopPropagation};
   JSFunctionHolder m_initEvent{context, prototypeObject, this, "initEvent", initEvent};
   JSFunctionHolder m_preventDefault{context, prototypeObject, this, "preventDefault", preventDefault};
+  JSFunctionHolder m_getCoalescedEvents{context, prototypeObject, this, "getCoalescedEvents", getCoalescedEvents};
 };
 
 class EventInstance : public HostClass::Instance {
@@ -411,10 +555,35 @@ public:
   bool setProperty(std::string &name, JSValueRef value, JSValueRef *exception) override;
   void getPropertyNames(JSPropertyNameAccumulatorRef accumulator) override;
   ~EventInstance() override;
+
+  // Accessors of event.idl attributes.
+  JSValueRef type();
+  bool bubbles();
+  bool cancelable();
+  double timestamp();
+  bool defaultPrevented();
+  JSValueRef target();
+  JSValueRef srcElement();
+  JSValueRef currentTarget();
+  double eventPhase();
+  bool returnValue();
+  bool cancelBubble();
+  void setCancelBubble(bool value);
+
+  // https://dom.spec.whatwg.org/#dom-event-eventphase
+  enum EventPhase : uint8_t { NONE = 0, CAPTURING_PHASE = 1, AT_TARGET = 2, BUBBLING_PHASE = 3 };
+
   NativeEvent *nativeEvent;
   bool _cancelled{false};
   bool _propagationStopped{false};
   bool _propagationImmediatelyStopped{false};
+  EventPhase _eventPhase{NONE};
+  // Set once the js object is passed to a listener, an event which never reached js can be recycled.
+  bool _exposed{false};
+  bool _inPassiveListener{false};
+  // Earlier events of the same target and type folded into this one within a frame, oldest first. Their objects are
+  // protected until this event is freed.
+  std::vector<EventInstance *> _coalescedEvents;
 
 private:
   friend JSEvent;
@@ -436,7 +605,6 @@ struct NativeEvent {
 
 class JSEventTarget : public HostClass {
 public:
-  static std::unordered_map<JSContext *, JSEventTarget *> instanceMap;
   static JSEventTarget *instance(JSContext *context);
   DEFINE_OBJECT_PROPERTY(EventTarget, 1, eventTargetId);
 
@@ -452,6 +620,18 @@ public:
 
   JSValueRef prototypeGetProperty(std::string &name, JSValueRef *exception) override;
 
+  // Continuous events dispatched from dart side, such as touchmove and scroll, are queued until the next frame. Only
+  // the last event of each target and type is dispatched, it keeps the earlier ones for getCoalescedEvents().
+  bool isContinuousEvent(JSStringRef eventType);
+  void queueContinuousEvent(EventTargetInstance *target, JSStringRef eventType, EventInstance *event);
+  // Dispatch the queued events, called at the next frame and before any other event from dart side.
+  void flushContinuousEvents();
+
+#if defined(IS_TEST)
+  // Events dispatched from dart side, specs read it to check the events dart side skips.
+  uint32_t dispatchedEventCount{0};
+#endif
+
 protected:
   JSEventTarget() = delete;
   friend EventTargetInstance;
@@ -463,6 +643,15 @@ protected:
 private:
   std::vector<std::string> m_jsOnlyEvents;
 
+  // Targets and events are protected while they are queued.
+  struct QueuedEvent {
+    EventTargetInstance *target;
+    JSStringRef type;
+    EventInstance *event;
+  };
+  std::vector<QueuedEvent> m_queuedEvents;
+  bool m_frameRequested{false};
+
   static JSValueRef addEventListener(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
                                      size_t argumentCount, const JSValueRef arguments[], JSValueRef *exception);
   static JSValueRef removeEventListener(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
@@ -490,18 +679,67 @@ public:
   KRAKEN_EXPORT void getPropertyNames(JSPropertyNameAccumulatorRef accumulator) override;
   JSValueRef getPropertyHandler(std::string &name, JSValueRef *exception);
   void setPropertyHandler(std::string &name, JSValueRef value, JSValueRef *exception);
+  // Dispatch the event along the path from this target to the root, capturing listeners are called on the way
+  // down and bubbling listeners on the way up. Returns whether the event has been canceled.
   bool dispatchEvent(EventInstance *event);
+  // The next target on the propagation path, only nodes have one.
+  virtual EventTargetInstance *parentEventTarget() {
+    return nullptr;
+  }
 
   ~EventTargetInstance() override;
   int32_t eventTargetId;
   NativeEventTarget *nativeEventTarget{nullptr};
 
+  // Event types whose presence in subtrees is published to dart side, see NativeEventTarget::subtreeListenerMask.
+  static constexpr uint32_t SUBTREE_LISTENER_EVENT_COUNT = 10;
+
+protected:
+  // Called by nodes when this target is attached to or detached from parent, the listeners of its subtree are
+  // added to or removed from the subtrees of parent and its ancestors.
+  void updateParentSubtreeListeners(EventTargetInstance *parent, bool attached);
+
 private:
   friend JSEventTarget;
-  // TODO: use std::u16string for better performance.
-  std::unordered_map<std::string, std::forward_list<JSObjectRef>> _eventHandlers;
-  std::unordered_map<std::string, JSObjectRef> _propertyEventHandler;
-  bool internalDispatchEvent(EventInstance *eventInstance);
+
+  struct EventListener {
+    // Atom of the event type.
+    JSStringRef type;
+    // Set to nullptr when removed while listeners are being dispatched, see m_dispatchDepth.
+    JSObjectRef callback;
+    bool capture;
+    // Passive listeners can not cancel the event, preventDefault() is ignored while they run.
+    bool passive;
+    // Set by `on` prefixed properties, called after the listeners added by addEventListener.
+    bool isPropertyHandler;
+  };
+
+  // What dart side is told about the listeners of an event type.
+  enum class DartListenerState : uint8_t { NONE, PASSIVE, ACTIVE };
+
+  DartListenerState dartListenerState(JSStringRef eventType);
+  int32_t indexOfPropertyHandler(JSStringRef eventType);
+  void removeEventListenerAt(uint32_t index);
+  // Send addEvent or removeEvent to dart side when the listeners changed from the state before, unless the event type
+  // is js only. addEvent carries "passive" as its second argument when all the listeners are passive, dart side then
+  // dispatches touchmove as not cancelable. addEvent is sent again when passive changes, dart side ignores the
+  // handlers it already added.
+  void updateDartEventListener(JSStringRef eventType, DartListenerState before);
+  // Call the listeners of one phase on this target. Listeners added meanwhile are not called, only the ones in the
+  // list when the call begins.
+  void invokeEventListeners(JSStringRef eventType, EventInstance *event);
+  void compactEventListeners();
+  void updateSubtreeListenerCount(uint32_t index, bool increase);
+
+  // Listeners of all event types in registration order. Most targets have no listener or a single one, which is kept
+  // inline, the list is only allocated for the second listener.
+  ::foundation::SmallVector<EventListener, 1> m_eventListeners;
+  // Listeners are not erased while dispatching, so that the running loop keeps valid indexes.
+  uint32_t m_dispatchDepth{0};
+  bool m_hasRemovedListeners{false};
+  // For each published event type, the number of children whose subtree has listeners, plus one when this target
+  // has listeners. Only allocated once a listener is added in the subtree.
+  uint32_t *m_subtreeListenerCounts{nullptr};
 };
 
 using NativeDispatchEvent = void (*)(NativeEventTarget *nativeEventTarget, NativeString *eventType, void *nativeEvent,
@@ -517,6 +755,10 @@ struct NativeEventTarget {
 
   EventTargetInstance *instance;
   NativeDispatchEvent dispatchEvent;
+  // Bit i is set when this target or one of its descendants has listeners of the i-th event type of click,
+  // touchstart, touchmove, touchend, touchcancel, scroll, swipe, pan, longpress and scale. Dart side walks up the
+  // targets of an event and does not dispatch it when none of them has the bit.
+  uint32_t subtreeListenerMask{0};
 };
 
 enum NodeType {
@@ -530,7 +772,6 @@ enum NodeType {
 
 class JSNode : public JSEventTarget {
 public:
-  static std::unordered_map<JSContext *, JSNode *> instanceMap;
   static JSNode *instance(JSContext *context);
   DEFINE_OBJECT_PROPERTY(Node, 10, isConnected, ownerDocument, firstChild, lastChild, parentNode, childNodes, previousSibling,
                          nextSibling, nodeType, textContent);
@@ -595,10 +836,14 @@ public:
 
   bool isConnected();
   DocumentInstance *ownerDocument();
-  NodeInstance *firstChild();
-  NodeInstance *lastChild();
-  NodeInstance *previousSibling();
-  NodeInstance *nextSibling();
+  inline NodeInstance *firstChild() { return m_firstChild; }
+  inline NodeInstance *lastChild() { return m_lastChild; }
+  inline NodeInstance *previousSibling() { return m_previousSibling; }
+  inline NodeInstance *nextSibling() { return m_nextSibling; }
+  inline uint32_t childCount() { return m_childCount; }
+  // Walks from the closest of the first, the last and the last accessed child, so reading children by increasing or
+  // decreasing index is linear in total.
+  NodeInstance *childAt(uint32_t index);
   void internalAppendChild(NodeInstance *node);
   void internalRemove(JSValueRef *exception);
   NodeInstance *internalRemoveChild(NodeInstance *node, JSValueRef *exception);
@@ -609,7 +854,6 @@ public:
 
   NodeType nodeType;
   NodeInstance *parentNode{nullptr};
-  std::vector<NodeInstance *> childNodes;
 
   NativeNode *nativeNode{nullptr};
 
@@ -622,11 +866,51 @@ public:
   virtual void _notifyNodeRemoved(NodeInstance *node);
   virtual void _notifyNodeInsert(NodeInstance *node);
 
+  EventTargetInstance *parentEventTarget() override {
+    return parentNode;
+  }
+
 private:
   DocumentInstance *m_document{nullptr};
+  // Children are linked through their sibling pointers, inserting or removing a child doesn't touch the others.
+  NodeInstance *m_firstChild{nullptr};
+  NodeInstance *m_lastChild{nullptr};
+  NodeInstance *m_previousSibling{nullptr};
+  NodeInstance *m_nextSibling{nullptr};
+  uint32_t m_childCount{0};
+  // The child last returned by childAt(), reset when children change.
+  uint32_t m_cachedChildIndex{0};
+  NodeInstance *m_cachedChild{nullptr};
+  // The list returned by childNodes while js holds it, cleared when the list is finalized.
+  JSNodeList *m_childNodes{nullptr};
   void ensureDetached(NodeInstance *node);
+  // documentElement has document as its parentNode without being one of its children.
+  bool hasChild(NodeInstance *node);
+  // Link node before referenceNode, or as the last child when referenceNode is null.
+  void linkChild(NodeInstance *node, NodeInstance *referenceNode);
+  void unlinkChild(NodeInstance *node);
   friend DocumentInstance;
   friend JSNode;
+  friend JSNodeList;
+};
+
+// Live list of the children of a node, returned by childNodes. Indexes are read by NodeInstance::childAt(), so
+// reading all the children in order is linear. The list keeps its node alive, the node does not keep the list.
+class JSNodeList : public HostObject {
+public:
+  DEFINE_OBJECT_PROPERTY(NodeList, 1, length)
+
+  JSNodeList() = delete;
+  explicit JSNodeList(JSContext *context, NodeInstance *node);
+  ~JSNodeList() override;
+
+  JSValueRef getProperty(std::string &name, JSValueRef *exception) override;
+  void getPropertyNames(JSPropertyNameAccumulatorRef accumulator) override;
+
+private:
+  friend NodeInstance;
+  // Null once the node is finalized, which only happens when the context is released.
+  NodeInstance *m_node;
 };
 
 struct NativeNode {
@@ -637,7 +921,6 @@ struct NativeNode {
 
 class JSDocument : public JSNode {
 public:
-  static std::unordered_map<JSContext *, JSDocument *> instanceMap;
   static JSDocument *instance(JSContext *context);
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -733,24 +1016,32 @@ public:
   static std::vector<JSStringRef> &getAttributePropertyNames();
   static std::unordered_map<std::string, AttributeProperty> &getAttributePropertyMap();
 
+  // Returns a new js string of the value, or nullptr if the attribute does not exist. Names of decimal numbers
+  // read attributes by index.
   KRAKEN_EXPORT JSValueRef getAttribute(std::string &name);
+  // Values are stored as strings, same as Element.setAttribute.
   KRAKEN_EXPORT void setAttribute(std::string &name, JSValueRef value);
   KRAKEN_EXPORT bool hasAttribute(std::string &name);
   KRAKEN_EXPORT void removeAttribute(std::string &name);
-
-  KRAKEN_EXPORT std::map<std::string, JSValueRef>& getAttributesMap();
-  KRAKEN_EXPORT void setAttributesMap(std::map<std::string, JSValueRef>& attributes);
-
-  KRAKEN_EXPORT std::vector<JSValueRef>& getAttributesVector();
-  KRAKEN_EXPORT void setAttributesVector(std::vector<JSValueRef>& attributes);
+  // Replace all attributes with the ones of other, used by cloneNode. Value strings are shared by both.
+  KRAKEN_EXPORT void copyWith(JSElementAttributes *other);
 
   KRAKEN_EXPORT JSValueRef getProperty(std::string &name, JSValueRef *exception) override;
   KRAKEN_EXPORT bool setProperty(std::string &name, JSValueRef value, JSValueRef *exception) override;
   KRAKEN_EXPORT void getPropertyNames(JSPropertyNameAccumulatorRef accumulator) override;
 
 private:
-  std::map<std::string, JSValueRef> m_attributes;
-  std::vector<JSValueRef> v_attributes;
+  struct Attribute {
+    // Atom of the context, not retained.
+    JSStringRef name;
+    // Retained, js values are only created when the attribute is read.
+    JSStringRef value;
+  };
+  // Index of the attribute, or -1 if it does not exist.
+  int32_t indexOf(std::string &name);
+
+  // Most elements have less than 4 attributes, they are kept inline without any allocation.
+  ::foundation::SmallVector<Attribute, 4> m_attributes;
 };
 
 struct NativeBoundingClientRect {
@@ -766,7 +1057,6 @@ struct NativeBoundingClientRect {
 
 class CSSStyleDeclaration : public HostClass {
 public:
-  static std::unordered_map<JSContext *, CSSStyleDeclaration *> instanceMap;
   static CSSStyleDeclaration *instance(JSContext *context);
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -791,6 +1081,7 @@ protected:
 
 class StyleDeclarationInstance : public HostClass::Instance {
 public:
+  DEFINE_OBJECT_PROPERTY(CSSStyleDeclaration, 1, cssText);
   DEFINE_PROTOTYPE_OBJECT_PROPERTY(CSSStyleDeclaration, 3, setProperty, removeProperty, getPropertyValue);
 
   StyleDeclarationInstance() = delete;
@@ -803,14 +1094,45 @@ public:
   bool internalSetProperty(std::string &name, JSValueRef value, JSValueRef *exception);
   void internalRemoveProperty(std::string &name, JSValueRef *exception);
   JSValueRef internalGetPropertyValue(std::string &name, JSValueRef *exception);
+  // Replace all declarations with the ones parsed from a CSS declaration block, only changed properties are sent
+  // to dart side.
+  void setCssText(const JSChar *chars, size_t length);
+  JSValueRef cssText();
 
 private:
-  std::unordered_map<std::string, JSValueRef> properties;
+  struct Declaration {
+    CSSPropertyID id;
+    // Only set for properties unknown to dart side, known properties are compared by id.
+    std::string name;
+    std::u16string value;
+  };
+
+  Declaration *findDeclaration(CSSPropertyID id, const std::string &name);
+  void setDeclaration(CSSPropertyID id, std::string &name, const JSChar *chars, size_t length);
+  void sendStyle(const Declaration &declaration, const std::u16string &value);
+
+  // Declarations in the order they were set, values are kept as native strings so they don't hold JS values.
+  std::vector<Declaration> m_declarations;
   const EventTargetInstance *ownerEventTarget;
 };
 
 using ElementCreator = ElementInstance *(*)(JSContext *context);
 
+enum class ViewModuleProperty {
+  offsetTop,
+  offsetLeft,
+  offsetWidth,
+  offsetHeight,
+  clientWidth,
+  clientHeight,
+  clientTop,
+  clientLeft,
+  scrollTop,
+  scrollLeft,
+  scrollHeight,
+  scrollWidth
+};
+
 class KRAKEN_EXPORT JSElement : public JSNode {
 public:
   DEFINE_OBJECT_PROPERTY(Element, 17, style, attributes, nodeName, tagName, offsetLeft, offsetTop, offsetWidth,
@@ -820,7 +1142,6 @@ public:
   DEFINE_PROTOTYPE_OBJECT_PROPERTY(Element, 10, getBoundingClientRect, getAttribute, setAttribute, hasAttribute,
                                    removeAttribute, toBlob, click, scroll, scrollBy, scrollTo);
 
-  static std::unordered_map<JSContext *, JSElement *> instanceMap;
   static std::unordered_map<std::string, ElementCreator> elementCreatorMap;
   OBJECT_INSTANCE(JSElement)
 
@@ -833,6 +1154,10 @@ public:
 
   static void defineElement(std::string tagName, ElementCreator creator);
 
+  // Batched getBoundingClientRect for measuring many elements at once, bound as a global function.
+  static JSValueRef getBoundingClientRects(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject,
+                                           size_t argumentCount, const JSValueRef arguments[], JSValueRef *exception);
+
 protected:
   JSElement() = delete;
   explicit JSElement(JSContext *context);
@@ -893,13 +1218,19 @@ public:
 
   NativeElement *nativeElement{nullptr};
 
+  // Layout reads are served from the geometry snapshot if it's up to date, otherwise read from dart side.
+  double getViewModuleProperty(ViewModuleProperty property);
+  NativeBoundingClientRect *getBoundingClientRect();
+
   std::string tagName();
 
   std::string getRegisteredTagName();
 
 private:
   friend JSElement;
-  JSStringHolder m_tagName{context, ""};
+  // Atoms of the registered tag name and the upper case tag name returned by tagName and nodeName.
+  JSStringRef m_tagName{nullptr};
+  JSStringRef m_upperCaseTagName{nullptr};
 
   KRAKEN_EXPORT void _notifyNodeRemoved(NodeInstance *node) override;
   void _notifyChildRemoved();
@@ -912,20 +1243,6 @@ private:
                             new StyleDeclarationInstance(CSSStyleDeclaration::instance(context), this)};
 };
 
-enum class ViewModuleProperty {
-  offsetTop,
-  offsetLeft,
-  offsetWidth,
-  offsetHeight,
-  clientWidth,
-  clientHeight,
-  clientTop,
-  clientLeft,
-  scrollTop,
-  scrollLeft,
-  scrollHeight,
-  scrollWidth
-};
 using GetViewModuleProperty = double (*)(NativeElement *nativeElement, int64_t property);
 using SetViewModuleProperty = void (*)(NativeElement *nativeElement, int64_t property, double value);
 using GetBoundingClientRect = NativeBoundingClientRect *(*)(NativeElement *nativeElement);
@@ -984,11 +1301,8 @@ struct NativeGestureEvent {
 
 class JSGestureEvent : public JSEvent {
 public:
-  DEFINE_OBJECT_PROPERTY(GestureEvent, 8, state, direction, deltaX, deltaY, velocityX, velocityY, scale, rotation);
-
   DEFINE_PROTOTYPE_OBJECT_PROPERTY(GestureEvent, 1, initGestureEvent);
 
-  static std::unordered_map<JSContext *, JSGestureEvent *> instanceMap;
   OBJECT_INSTANCE(JSGestureEvent)
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -1017,10 +1331,26 @@ public:
                                 JSValueRef *exception);
   explicit GestureEventInstance(JSGestureEvent *jsGestureEvent, NativeGestureEvent *nativeGestureEvent);
   JSValueRef getProperty(std::string &name, JSValueRef *exception) override;
-  bool setProperty(std::string &name, JSValueRef value, JSValueRef *exception) override;
-  void getPropertyNames(JSPropertyNameAccumulatorRef accumulator) override;
   ~GestureEventInstance() override;
 
+  // Accessors of gesture_event.idl attributes.
+  JSValueRef state();
+  void setState(JSValueRef value);
+  JSValueRef direction();
+  void setDirection(JSValueRef value);
+  JSValueRef deltaX();
+  void setDeltaX(JSValueRef value);
+  JSValueRef deltaY();
+  void setDeltaY(JSValueRef value);
+  JSValueRef velocityX();
+  void setVelocityX(JSValueRef value);
+  JSValueRef velocityY();
+  void setVelocityY(JSValueRef value);
+  JSValueRef scale();
+  void setScale(JSValueRef value);
+  JSValueRef rotation();
+  void setRotation(JSValueRef value);
+
 private:
   friend JSGestureEvent;
   JSValueHolder m_state{context, nullptr};
@@ -1055,7 +1385,6 @@ public:
 
   DEFINE_PROTOTYPE_OBJECT_PROPERTY(MouseEvent, 1, initMouseEvent);
 
-  static std::unordered_map<JSContext *, JSMouseEvent *> instanceMap;
   OBJECT_INSTANCE(JSMouseEvent)
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
@@ -1112,7 +1441,6 @@ public:
 
   DEFINE_PROTOTYPE_OBJECT_PROPERTY(PopStateEvent, 1, initPopStateEvent);
 
-  static std::unordered_map<JSContext *, JSPopStateEvent *> instanceMap;
   OBJECT_INSTANCE(JSPopStateEvent)
 
   JSObjectRef instanceConstructor(JSContextRef ctx, JSObjectRef constructor, size_t argumentCount,
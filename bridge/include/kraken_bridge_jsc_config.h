@@ -1,3 +1,5 @@
+#include "kraken_property_table.h"
+
 #define KRAKEN_EXPORT __attribute__((__visibility__("default")))
 
 #define HTML_TARGET_ID -1
@@ -8,10 +10,13 @@
 
 #define OBJECT_INSTANCE(NAME)                                                                                          \
   static NAME *instance(JSContext *context) {                                                                          \
-    if (instanceMap.count(context) == 0) {                                                                             \
-      instanceMap[context] = new NAME(context);                                                                        \
+    auto &bindingState = context->bindingState();                                                                      \
+    auto hostClass = bindingState.hostClass<NAME>(::kraken::binding::jsc::BindingSlot::NAME);                          \
+    if (hostClass == nullptr) {                                                                                        \
+      hostClass = new NAME(context);                                                                                   \
+      bindingState.setHostClass(::kraken::binding::jsc::BindingSlot::NAME, hostClass);                                 \
     }                                                                                                                  \
-    return instanceMap[context];                                                                                       \
+    return hostClass;                                                                                                  \
   }
 
 #define JSC_GLOBAL_BINDING_FUNCTION(context, nameStr, func)                                                            \
@@ -20,7 +25,7 @@
     functionDefinition.className = nameStr;                                                                            \
     functionDefinition.callAsFunction = func;                                                                          \
     functionDefinition.version = 0;                                                                                    \
-    JSClassRef functionClass = JSClassCreate(&functionDefinition);                                                     \
+    JSClassRef functionClass = ::kraken::binding::jsc::JSClassGetShared(functionDefinition);                           \
     JSObjectRef function = JSObjectMake(context->context(), functionClass, context.get());                             \
     JSValueProtect(context->context(), function);                                                                      \
     JSStringRef name = JSStringCreateWithUTF8CString(nameStr);                                                         \
@@ -893,17 +898,18 @@
     OBJECT_PROPERTY_ITEM(NAME, _46), OBJECT_PROPERTY_ITEM(NAME, _47), OBJECT_PROPERTY_ITEM(NAME, _48),                 \
     OBJECT_PROPERTY_ITEM(NAME, _49), OBJECT_PROPERTY_ITEM(NAME, _50),
 
+// Property maps are perfect hash tables built at compile time, see foundation::PropertyTable.
 #define OBJECT_PROPERTY_MAP_FUNCTION(NAME, ARGS_COUNT, ...)                                                            \
-  static std::unordered_map<std::string, NAME##Property> &get##NAME##PropertyMap() {                                   \
-    static std::unordered_map<std::string, NAME##Property> propertyMap{                                                \
-      OBJECT_PROPERTY_ITEM_##ARGS_COUNT(NAME, __VA_ARGS__)};                                                           \
+  static const ::foundation::PropertyTable<NAME##Property, ARGS_COUNT> &get##NAME##PropertyMap() {                     \
+    static constexpr ::foundation::PropertyTable<NAME##Property, ARGS_COUNT> propertyMap{                              \
+      {OBJECT_PROPERTY_ITEM_##ARGS_COUNT(NAME, __VA_ARGS__)}};                                                         \
     return propertyMap;                                                                                                \
   };
 
 #define OBJECT_PROTOTYPE_PROPERTY_MAP_FUNCTION(NAME, ARGS_COUNT, ...)                                                  \
-  static std::unordered_map<std::string, NAME##PrototypeProperty> &get##NAME##PrototypePropertyMap() {                 \
-    static std::unordered_map<std::string, NAME##PrototypeProperty> prototypePropertyMap{                              \
-      OBJECT_PROTOTYPE_PROPERTY_ITEM_##ARGS_COUNT(NAME, __VA_ARGS__)};                                                 \
+  static const ::foundation::PropertyTable<NAME##PrototypeProperty, ARGS_COUNT> &get##NAME##PrototypePropertyMap() {   \
+    static constexpr ::foundation::PropertyTable<NAME##PrototypeProperty, ARGS_COUNT> prototypePropertyMap{            \
+      {OBJECT_PROTOTYPE_PROPERTY_ITEM_##ARGS_COUNT(NAME, __VA_ARGS__)}};                                               \
     return prototypePropertyMap;                                                                                       \
   };
 
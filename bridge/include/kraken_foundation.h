@@ -7,7 +7,9 @@
 #define KRAKENBRIDGE_FOUNDATION_H
 
 #include "kraken_bridge_jsc_config.h"
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -39,6 +41,9 @@
 
 struct NativeString;
 struct UICommandItem;
+struct UICommandCompactionStats;
+struct UICommandStats;
+struct NativeGeometrySnapshot;
 
 namespace foundation {
 
@@ -61,10 +66,92 @@ private:
   std::vector<CallbackItem> queue;
 };
 
+// A bump allocator for the string payloads of ui commands. All strings of one flush are packed into a few
+// contiguous chunks, which are reused after reset() instead of being returned to the heap.
+class UICommandStringArena {
+public:
+  UICommandStringArena() = default;
+  // Returns storage for length UTF-16 code units. The returned pointer is never null, even for empty strings,
+  // because dart side treat null string pointer as a missing argument.
+  KRAKEN_EXPORT uint16_t *allocate(size_t length);
+  KRAKEN_EXPORT const uint16_t *copy(const uint16_t *string, size_t length);
+  // Invalidate all strings allocated since the last reset, chunks are kept for the next flush.
+  KRAKEN_EXPORT void reset();
+
+  // Number of chunks requested from the heap since the arena created.
+  int64_t heapAllocationCount() const {
+    return m_heapAllocationCount;
+  };
+  // Number of strings allocated since the arena created.
+  int64_t stringAllocationCount() const {
+    return m_stringAllocationCount;
+  };
+
+private:
+  struct Chunk {
+    std::unique_ptr<uint16_t[]> data;
+    size_t capacity;
+  };
+
+  std::vector<Chunk> m_chunks;
+  size_t m_chunkIndex{0};
+  size_t m_offset{0};
+  int64_t m_heapAllocationCount{0};
+  int64_t m_stringAllocationCount{0};
+
+  KRAKEN_DISALLOW_COPY_AND_ASSIGN(UICommandStringArena);
+};
+
+class UICommandCompactor;
+class UICommandTraceWriter;
+
+// Geometry of elements published by dart side after each layout, so layout reads of js side can be served without
+// calling into dart side. Elements are watched once js side read from them, and are no longer published when js side
+// stops reading from them.
+class UIGeometrySnapshot {
+public:
+  UIGeometrySnapshot() = delete;
+  explicit UIGeometrySnapshot(int32_t contextId);
+  ~UIGeometrySnapshot();
+  static KRAKEN_EXPORT UIGeometrySnapshot *instance(int32_t contextId);
+
+  // Returns the published row of target, or nullptr if the snapshot is out of date or the target has not been
+  // published yet. Target will be published after the next layout.
+  KRAKEN_EXPORT const double *read(int32_t targetId);
+  KRAKEN_EXPORT void unwatch(int32_t targetId);
+  // Mark the snapshot out of date, should be called when geometry may changed without a layout command.
+  KRAKEN_EXPORT void invalidate();
+  // Called by dart side after all rows were written.
+  KRAKEN_EXPORT void commit();
+  // Called by dart side before writing rows, drops targets which have not been read for a while.
+  KRAKEN_EXPORT NativeGeometrySnapshot *nativeSnapshot();
+  // Dart side increases the counter whenever its render tree is marked for layout, which invalidates snapshots of
+  // all contexts without calling into bridge.
+  static KRAKEN_EXPORT int64_t *layoutEpoch();
+
+private:
+  void removeSlot(size_t slot);
+
+  int32_t contextId;
+  bool valid{false};
+  int64_t committed_epoch{0};
+  std::vector<int32_t> target_ids;
+  std::vector<double> rows;
+  std::vector<bool> published;
+  // Publishes since the last read of each target.
+  std::vector<uint32_t> idle_publishes;
+  std::unordered_map<int32_t, size_t> slots;
+  std::unique_ptr<NativeGeometrySnapshot> native_snapshot;
+  static int64_t layout_epoch;
+
+  KRAKEN_DISALLOW_COPY_AND_ASSIGN(UIGeometrySnapshot);
+};
+
 class UICommandBuffer {
 public:
   UICommandBuffer() = delete;
   explicit UICommandBuffer(int32_t contextId);
+  ~UICommandBuffer();
   static KRAKEN_EXPORT UICommandBuffer *instance(int32_t contextId);
 
   KRAKEN_EXPORT void addCommand(int32_t id, int32_t type, void *nativePtr, bool batchedUpdate);
@@ -72,14 +159,107 @@ public:
   KRAKEN_EXPORT void addCommand(int32_t id, int32_t type, NativeString &args_01, NativeString &args_02,
                                      void *nativePtr);
   KRAKEN_EXPORT void addCommand(int32_t id, int32_t type, NativeString &args_01, void *nativePtr);
+  KRAKEN_EXPORT void addCommand(int32_t id, int32_t type, int64_t int64_01, int64_t int64_02, void *nativePtr);
+  // Commands are double buffered: js side keeps producing into one batch while dart side consumes the other.
+  // data() hands the produced batch to dart side once the previous one has been consumed, and returns the next
+  // slice of the consuming batch which fits in the flush policy.
   KRAKEN_EXPORT UICommandItem *data();
+  // Size of the slice returned by the last data() call.
   KRAKEN_EXPORT int64_t size();
+  // Release the slice returned by data(), or drop all pending commands if there is no slice being consumed.
   KRAKEN_EXPORT void clear();
+  // Limit the commands handed to dart side by one data() call, the remaining commands are deferred to the
+  // following calls in order. Zero means unlimited. At least one command is returned if there is any.
+  KRAKEN_EXPORT void setFlushPolicy(int64_t maxCommandsPerFrame, int64_t maxBytesPerFrame);
+  // Synchronously flush commands of this context before reading layout from dart side. Skipped if none of the
+  // pending commands could change layout.
+  KRAKEN_EXPORT void flushForLayout();
+  KRAKEN_EXPORT bool hasPendingLayoutCommands();
+  // Whether all commands had been handed to dart side.
+  KRAKEN_EXPORT bool empty();
+  // Run callback by UICommandCallbackQueue after the commands added before it have been handed to dart side, such as
+  // deleting native structs of a finalized target whose createElement may still wait in a later slice of the batch.
+  KRAKEN_EXPORT void registerCallback(const UICommandCallbackQueue::Callback &callback, void *data);
+  // Sequence of the batch which commands added now belong to. Callers which must not run before some commands are
+  // applied keep it and check isBatchApplied(), instead of flushing all pending commands.
+  KRAKEN_EXPORT int64_t batchSequence();
+  // Whether the batch had been applied by dart side, or dropped.
+  KRAKEN_EXPORT bool isBatchApplied(int64_t sequence);
+  UICommandStringArena &stringArena() {
+    return producer().stringArena;
+  };
+
+  // Returns the atom id of name, or -1 if name has not been registered yet.
+  KRAKEN_EXPORT int32_t findAtom(const std::string &name);
+  // Intern name as an atom of this context and add a registerAtom command, so dart side can resolve the atom
+  // from the commands followed.
+  KRAKEN_EXPORT int32_t registerAtom(const std::string &name, NativeString &args_01);
+  // Atoms should be registered again when js context recreated, dart side will overwrite atoms by id.
+  KRAKEN_EXPORT void clearAtoms();
+
+  // Counters of the command stream, always enabled.
+  KRAKEN_EXPORT UICommandStats *stats();
+  KRAKEN_EXPORT void resetStats();
+  // Batches read by dart side while frame flushing are counted as frame flushes, others are forced flushes.
+  static KRAKEN_EXPORT void setFrameFlushing(bool flushing);
+
+  // Record the command stream with flush boundaries into a binary trace file, see ui_command_trace.h.
+  // Returns false if the file can not be opened.
+  KRAKEN_EXPORT bool startTrace(const std::string &path);
+  KRAKEN_EXPORT void stopTrace();
+
+  // Compaction removes redundant commands before dart side reads them, it's disabled by default.
+  KRAKEN_EXPORT void setCompactionEnabled(bool enabled);
+  // Returns nullptr if compaction has never been enabled.
+  KRAKEN_EXPORT UICommandCompactionStats *compactionStats();
 
 private:
+  struct PendingCallback {
+    UICommandCallbackQueue::Callback callback;
+    void *data;
+  };
+
+  struct CommandBatch {
+    std::vector<UICommandItem> queue;
+    UICommandStringArena stringArena;
+    // Whether the batch contains any layout affecting command.
+    bool layoutDirty{false};
+    // Callbacks waiting for this batch to be released.
+    std::vector<PendingCallback> callbacks;
+    int64_t sequence{0};
+  };
+
+  void push(const UICommandItem &item);
+  void releaseCallbacks(CommandBatch &batch);
+  void requestBatchUpdate();
+
+  CommandBatch &producer() {
+    return batches[producer_index];
+  };
+  CommandBatch &consumer() {
+    return batches[1 - producer_index];
+  };
+  int64_t nextSliceSize();
+
   int32_t contextId;
   std::atomic<bool> update_batched{false};
-  std::vector<UICommandItem> queue;
+  // Both batches keep their capacity after cleared, so queues and arenas are reused across frames.
+  CommandBatch batches[2];
+  int32_t producer_index{0};
+  // Commands of the consuming batch before consumer_offset have been read by dart side.
+  int64_t consumer_offset{0};
+  int64_t slice_size{0};
+  int64_t next_sequence{1};
+  int64_t applied_sequence{-1};
+  int64_t max_commands_per_frame{0};
+  int64_t max_bytes_per_frame{0};
+  std::unordered_map<std::string, int32_t> atoms;
+  bool compaction_enabled{false};
+  std::unique_ptr<UICommandCompactor> compactor;
+  UIGeometrySnapshot *geometry_snapshot{nullptr};
+  std::unique_ptr<UICommandStats> command_stats;
+  std::unique_ptr<UICommandTraceWriter> trace_writer;
+  static bool frame_flushing;
 };
 
 typedef int LogSeverity;
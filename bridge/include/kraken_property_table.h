@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+#ifndef KRAKENBRIDGE_PROPERTY_TABLE_H
+#define KRAKENBRIDGE_PROPERTY_TABLE_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace foundation {
+
+template <typename T> struct PropertyTableEntry {
+  const char *name{nullptr};
+  T value{};
+};
+
+// Called when no seed can place every name into its own slot, which is only possible with duplicated names.
+// Not being constexpr, it stops the compilation of the table.
+inline void propertyTableSeedNotFound() {}
+
+// Map property names of a host class to its property enum without allocation.
+// The table is built at compile time: names are hashed with a seed searched to put every name into its own slot,
+// so a lookup hashes the name once and compares it with at most one entry. Names are looked up in the std::string
+// converted by PropertyNameScope.
+template <typename T, size_t N> class PropertyTable {
+  static_assert(N > 0 && N < 0xff, "PropertyTable supports 1 to 254 names.");
+
+public:
+  constexpr explicit PropertyTable(const PropertyTableEntry<T> (&entries)[N]) {
+    for (size_t i = 0; i < N; i++) {
+      m_entries[i] = entries[i];
+      m_lengths[i] = nameLength(entries[i].name);
+      m_hashes[i] = hash(entries[i].name, m_lengths[i]);
+    }
+
+    while (!trySeed(m_seed)) {
+      if (++m_seed > MAX_SEED) {
+        propertyTableSeedNotFound();
+        break;
+      }
+    }
+
+    for (size_t i = 0; i < SLOT_COUNT; i++) {
+      m_slots[i] = EMPTY_SLOT;
+    }
+    for (size_t i = 0; i < N; i++) {
+      m_slots[slotOf(m_hashes[i], m_seed)] = static_cast<uint8_t>(i);
+    }
+  }
+
+  // Return the index of name in the property list, which is also the value of its enum, or -1 if not found.
+  constexpr int32_t find(const char *chars, size_t length) const {
+    uint8_t index = m_slots[slotOf(hash(chars, length), m_seed)];
+    if (index == EMPTY_SLOT || m_lengths[index] != length) return -1;
+    const char *name = m_entries[index].name;
+    for (size_t i = 0; i < length; i++) {
+      if (chars[i] != name[i]) return -1;
+    }
+    return index;
+  }
+
+  size_t count(const std::string &name) const {
+    return find(name.data(), name.size()) >= 0 ? 1 : 0;
+  }
+
+  const T &operator[](const std::string &name) const {
+    int32_t index = find(name.data(), name.size());
+    assert(index >= 0);
+    return m_entries[index].value;
+  }
+
+  constexpr size_t size() const {
+    return N;
+  }
+
+private:
+  static constexpr size_t slotCount() {
+    size_t count = 1;
+    // At least four slots per name, keeps the seed search short.
+    while (count < N * 4) count <<= 1;
+    return count;
+  }
+
+  static constexpr size_t SLOT_COUNT = slotCount();
+  static constexpr uint8_t EMPTY_SLOT = 0xff;
+  static constexpr uint32_t MAX_SEED = 1 << 16;
+
+  static constexpr size_t nameLength(const char *name) {
+    size_t length = 0;
+    while (name[length] != '\0') length++;
+    return length;
+  }
+
+  // FNV-1a over bytes of the name.
+  static constexpr uint32_t hash(const char *chars, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+      hash ^= static_cast<uint8_t>(chars[i]);
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+  static constexpr size_t slotOf(uint32_t hash, uint32_t seed) {
+    uint32_t x = hash ^ (seed * 0x9e3779b9u);
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x & (SLOT_COUNT - 1);
+  }
+
+  constexpr bool trySeed(uint32_t seed) const {
+    bool used[SLOT_COUNT]{};
+    for (size_t i = 0; i < N; i++) {
+      size_t slot = slotOf(m_hashes[i], seed);
+      if (used[slot]) return false;
+      used[slot] = true;
+    }
+    return true;
+  }
+
+  PropertyTableEntry<T> m_entries[N]{};
+  size_t m_lengths[N]{};
+  uint32_t m_hashes[N]{};
+  uint8_t m_slots[SLOT_COUNT]{};
+  uint32_t m_seed{0};
+};
+
+} // namespace foundation
+
+#endif // KRAKENBRIDGE_PROPERTY_TABLE_H
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+#ifndef KRAKENBRIDGE_SMALL_VECTOR_H
+#define KRAKENBRIDGE_SMALL_VECTOR_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace foundation {
+
+// A vector of trivially copyable items keeping the first N items inline, for the lists which are short on almost
+// every node, such as attributes. Items are moved and copied with memcpy, a copy of the whole vector is a single
+// memcpy when it fits inline.
+template <typename T, uint32_t N> class SmallVector {
+  static_assert(std::is_trivially_copyable<T>::value, "SmallVector only holds trivially copyable items.");
+  static_assert(N > 0, "SmallVector needs inline capacity, use std::vector otherwise.");
+
+public:
+  SmallVector() = default;
+  SmallVector(const SmallVector &other) {
+    *this = other;
+  }
+  SmallVector &operator=(const SmallVector &other) {
+    if (this == &other) return *this;
+    m_size = 0;
+    reserve(other.m_size);
+    memcpy(data(), other.data(), other.m_size * sizeof(T));
+    m_size = other.m_size;
+    return *this;
+  }
+  ~SmallVector() {
+    if (m_heap != nullptr) ::operator delete(m_heap);
+  }
+
+  T *data() {
+    return m_heap != nullptr ? m_heap : reinterpret_cast<T *>(m_inline);
+  }
+  const T *data() const {
+    return m_heap != nullptr ? m_heap : reinterpret_cast<const T *>(m_inline);
+  }
+
+  uint32_t size() const {
+    return m_size;
+  }
+  bool empty() const {
+    return m_size == 0;
+  }
+
+  T *begin() {
+    return data();
+  }
+  T *end() {
+    return data() + m_size;
+  }
+  const T *begin() const {
+    return data();
+  }
+  const T *end() const {
+    return data() + m_size;
+  }
+
+  T &operator[](uint32_t index) {
+    assert(index < m_size);
+    return data()[index];
+  }
+  const T &operator[](uint32_t index) const {
+    assert(index < m_size);
+    return data()[index];
+  }
+
+  void push_back(const T &item) {
+    if (m_size == m_capacity) reserve(m_capacity * 2);
+    data()[m_size++] = item;
+  }
+
+  // Keeps the order of the remaining items.
+  void erase(uint32_t index) {
+    assert(index < m_size);
+    T *items = data();
+    memmove(items + index, items + index + 1, (m_size - index - 1) * sizeof(T));
+    m_size--;
+  }
+
+  // Drop the items after the first size ones.
+  void shrink(uint32_t size) {
+    assert(size <= m_size);
+    m_size = size;
+  }
+
+  void clear() {
+    m_size = 0;
+  }
+
+  void reserve(uint32_t capacity) {
+    if (capacity <= m_capacity) return;
+    auto heap = static_cast<T *>(::operator new(capacity * sizeof(T)));
+    memcpy(heap, data(), m_size * sizeof(T));
+    if (m_heap != nullptr) ::operator delete(m_heap);
+    m_heap = heap;
+    m_capacity = capacity;
+  }
+
+private:
+  T *m_heap{nullptr};
+  uint32_t m_size{0};
+  uint32_t m_capacity{N};
+  alignas(T) unsigned char m_inline[N * sizeof(T)];
+};
+
+} // namespace foundation
+
+#endif // KRAKENBRIDGE_SMALL_VECTOR_H
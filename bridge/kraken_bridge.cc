@@ -8,6 +8,7 @@
 #include "foundation/logging.h"
 #include "foundation/ui_task_queue.h"
 #include "foundation/inspector_task_queue.h"
+#include "bindings/jsc/DOM/elements/canvas_element.h"
 #include "bindings/jsc/KOM/performance.h"
 
 #ifdef KRAKEN_ENABLE_JSA
@@ -240,6 +241,60 @@ void clearUICommandItems(int32_t contextId) {
   return foundation::UICommandBuffer::instance(contextId)->clear();
 }
 
+void setUICommandCompactionEnabled(int32_t contextId, int32_t enabled) {
+  foundation::UICommandBuffer::instance(contextId)->setCompactionEnabled(enabled == 1);
+}
+
+UICommandCompactionStats *getUICommandCompactionStats(int32_t contextId) {
+  return foundation::UICommandBuffer::instance(contextId)->compactionStats();
+}
+
+void setUICommandFlushPolicy(int32_t contextId, int64_t maxCommandsPerFrame, int64_t maxBytesPerFrame) {
+  foundation::UICommandBuffer::instance(contextId)->setFlushPolicy(maxCommandsPerFrame, maxBytesPerFrame);
+}
+
+UICommandStats *getUICommandStats(int32_t contextId) {
+  return foundation::UICommandBuffer::instance(contextId)->stats();
+}
+
+void resetUICommandStats(int32_t contextId) {
+  foundation::UICommandBuffer::instance(contextId)->resetStats();
+}
+
+void setUICommandFrameFlushing(int32_t flushing) {
+  foundation::UICommandBuffer::setFrameFlushing(flushing == 1);
+}
+
+int32_t startUICommandTrace(int32_t contextId, const char *path) {
+  return foundation::UICommandBuffer::instance(contextId)->startTrace(path) ? 1 : 0;
+}
+
+void stopUICommandTrace(int32_t contextId) {
+  foundation::UICommandBuffer::instance(contextId)->stopTrace();
+}
+
+NativeGeometrySnapshot *getGeometrySnapshot(int32_t contextId) {
+  return foundation::UIGeometrySnapshot::instance(contextId)->nativeSnapshot();
+}
+
+void commitGeometrySnapshot(int32_t contextId) {
+  foundation::UIGeometrySnapshot::instance(contextId)->commit();
+}
+
+int64_t *getGeometryLayoutEpoch() {
+  return foundation::UIGeometrySnapshot::layoutEpoch();
+}
+
+void flushCanvasDisplayLists(int32_t contextId) {
+  assert(checkContext(contextId) && "flushCanvasDisplayLists: contextId is not valid");
+  auto context = static_cast<kraken::JSBridge *>(getJSContext(contextId));
+  kraken::binding::jsc::CanvasRenderingContext2D::flushDisplayLists(context->getContext().get());
+}
+
+void setCanvasRecordingEnabled(int32_t enabled) {
+  kraken::binding::jsc::CanvasRenderingContext2D::recordingEnabled = enabled == 1;
+}
+
 void registerContextDisposedCallbacks(int32_t contextId, Task task, void *data) {
   assert(checkContext(contextId));
   auto context = static_cast<kraken::JSBridge *>(getJSContext(contextId));
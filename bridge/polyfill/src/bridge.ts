@@ -25,5 +25,8 @@ export const krakenInvokeModule = __kraken_invoke_module__;
 declare const __kraken_module_listener__: (fn: (moduleName: string, event: Event, extra: string) => void) => void;
 export const addKrakenModuleListener = __kraken_module_listener__;
 
+declare const __kraken_get_bounding_client_rects__: (elements: Element[]) => DOMRect[];
+export const krakenGetBoundingClientRects = __kraken_get_bounding_client_rects__;
+
 declare const __kraken_print__: (log: string, level?: string) => void;
 export const krakenPrint = __kraken_print__;
@@ -1,4 +1,4 @@
-import { addKrakenModuleListener, krakenInvokeModule, privateKraken } from './bridge';
+import { addKrakenModuleListener, krakenGetBoundingClientRects, krakenInvokeModule, privateKraken } from './bridge';
 import { methodChannel, triggerMethodCallHandler } from './method-channel';
 import { dispatchConnectivityChangeEvent } from "./connection";
 import { dispatchWebSocketEvent } from "./websocket";
@@ -28,5 +28,6 @@ export const kraken = {
   ...privateKraken,
   methodChannel,
   invokeModule: krakenInvokeModule,
+  getBoundingClientRects: krakenGetBoundingClientRects,
   addKrakenModuleListener: addKrakenModuleListener
 };
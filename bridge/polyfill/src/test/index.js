@@ -162,6 +162,7 @@ global.simulatePointer = function simulatePointer(list, pointer) {
 }
 
 global.simulateInputText = __kraken_simulate_inputtext__;
+global.getDispatchedEventCount = __kraken_dispatched_event_count__;
 
 function resetDocumentElement() {
   window.scrollTo(0, 0);
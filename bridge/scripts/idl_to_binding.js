@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+// Generate JavaScriptCore static value tables from WebIDL interface definitions.
+//
+// Every attribute of an interface becomes an entry of a JSStaticValue table whose getter and setter call the
+// accessors of the `<Interface>Instance` class declared in the header next to the idl file:
+//
+//   boolean             bool name() / void setName(bool)
+//   numeric types       double name() / void setName(double)
+//   DOMString           JSValueRef name() / void setName(JSStringRef), the string is borrowed by the setter
+//   any and interfaces  JSValueRef name() / void setName(JSValueRef)
+//
+// Getters returning nullptr read as undefined.
+//
+// Only the subset of WebIDL used by the bridge is supported: one interface per file, optional inheritance,
+// attributes with optional `readonly`, and comments. Inherited attributes are not repeated in the table, the
+// host class of the base interface defines its own table and JSC walks up the class chain.
+
+const path = require('path');
+const fs = require('fs');
+
+function parseArgs(argv) {
+  const args = { sources: [] };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    if (arg === '-o') {
+      args.output = argv[++i];
+    } else if (arg === '-r') {
+      args.root = argv[++i];
+    } else if (arg === '-h' || arg === '--help') {
+      args.help = true;
+    } else {
+      args.sources.push(arg);
+    }
+  }
+  return args;
+}
+
+const args = parseArgs(process.argv.slice(2));
+
+if (args.help || !args.output || !args.root || args.sources.length === 0) {
+  process.stdout.write(`Convert WebIDL interfaces into JavaScriptCore static value tables
+Usage: node idl_to_binding.js -r /path/to/bridge -o /path/to/dist /path/to/event.idl ...\n`);
+  process.exit(args.help ? 0 : 1);
+}
+
+const NUMERIC_TYPES = new Set([
+  'byte', 'octet', 'short', 'unsigned short', 'long', 'unsigned long', 'long long', 'unsigned long long', 'float',
+  'unrestricted float', 'double', 'unrestricted double'
+]);
+
+function fail(file, message) {
+  process.stderr.write(`${file}: ${message}\n`);
+  process.exit(1);
+}
+
+function parseInterface(file, source) {
+  source = source.replace(/\/\/.*$/gm, '').replace(/\/\*[\s\S]*?\*\//g, '');
+
+  const match = /interface\s+(\w+)\s*(?::\s*(\w+))?\s*\{([\s\S]*?)\}\s*;/.exec(source);
+  if (match === null) fail(file, 'no interface definition found.');
+
+  const attributes = [];
+  for (let member of match[3].split(';')) {
+    member = member.trim().replace(/\s+/g, ' ');
+    if (member.length === 0) continue;
+
+    const attribute = /^(readonly )?attribute ([\w ]+?)(\?)? (\w+)$/.exec(member);
+    if (attribute === null) fail(file, `unsupported member "${member}".`);
+
+    attributes.push({
+      readonly: attribute[1] !== undefined,
+      type: attribute[2],
+      name: attribute[4]
+    });
+  }
+
+  return { name: match[1], attributes };
+}
+
+function capitalize(name) {
+  return name[0].toUpperCase() + name.slice(1);
+}
+
+function indent(prefix) {
+  return ' '.repeat(prefix.length);
+}
+
+function getterBody(attribute) {
+  const call = `instance->${attribute.name}()`;
+  if (attribute.type === 'boolean') {
+    return `  return JSValueMakeBoolean(ctx, ${call});`;
+  } else if (NUMERIC_TYPES.has(attribute.type)) {
+    return `  return JSValueMakeNumber(ctx, ${call});`;
+  }
+  return `  JSValueRef value = ${call};
+  if (value == nullptr) return JSValueMakeUndefined(ctx);
+  return value;`;
+}
+
+function setterBody(attribute) {
+  const setter = `instance->set${capitalize(attribute.name)}`;
+  if (attribute.type === 'boolean') {
+    return `  ${setter}(JSValueToBoolean(ctx, value));`;
+  } else if (NUMERIC_TYPES.has(attribute.type)) {
+    return `  double number = JSValueToNumber(ctx, value, exception);
+  if (exception != nullptr && *exception != nullptr) return false;
+  ${setter}(number);`;
+  } else if (attribute.type === 'DOMString') {
+    return `  JSStringRef string = JSValueToStringCopy(ctx, value, exception);
+  if (string == nullptr) return false;
+  ${setter}(string);
+  JSStringRelease(string);`;
+  }
+  return `  ${setter}(value);`;
+}
+
+// Parameters not used by the generated body are left unnamed, so the generated code builds without warnings.
+function setterUsesContext(attribute) {
+  return attribute.type === 'boolean' || NUMERIC_TYPES.has(attribute.type) || attribute.type === 'DOMString';
+}
+
+function setterUsesException(attribute) {
+  return NUMERIC_TYPES.has(attribute.type) || attribute.type === 'DOMString';
+}
+
+function generateHeader(idl, outputName) {
+  const guard = `KRAKENBRIDGE_${outputName.toUpperCase()}_H`;
+  return `/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+// Generated by scripts/idl_to_binding.js, do not edit.
+
+#ifndef ${guard}
+#define ${guard}
+
+#include <JavaScriptCore/JavaScript.h>
+
+namespace kraken::binding::jsc {
+
+// Accessors of ${idl.name} attributes, terminated by an empty entry.
+const JSStaticValue *get${idl.name}StaticValues();
+
+} // namespace kraken::binding::jsc
+
+#endif // ${guard}
+`;
+}
+
+function generateSource(idl, outputName, implHeader) {
+  const instanceClass = `${idl.name}Instance`;
+  const functions = [];
+  const entries = [];
+
+  for (let attribute of idl.attributes) {
+    const getter = `${attribute.name}AttributeGetter`;
+    const setter = attribute.readonly ? 'nullptr' : `${attribute.name}AttributeSetter`;
+
+    const getterSignature = `JSValueRef ${getter}(`;
+    functions.push(`${getterSignature}JSContextRef ctx, JSObjectRef object, JSStringRef, JSValueRef *) {
+  auto instance = toInstance(object);
+  if (instance == nullptr) return JSValueMakeUndefined(ctx);
+${getterBody(attribute)}
+}`);
+
+    if (!attribute.readonly) {
+      const setterSignature = `bool ${setter}(`;
+      const ctx = setterUsesContext(attribute) ? 'JSContextRef ctx' : 'JSContextRef';
+      const exception = setterUsesException(attribute) ? 'JSValueRef *exception' : 'JSValueRef *';
+      functions.push(`${setterSignature}${ctx}, JSObjectRef object, JSStringRef, JSValueRef value,
+${indent(setterSignature)}${exception}) {
+  auto instance = toInstance(object);
+  if (instance == nullptr) return false;
+${setterBody(attribute)}
+  return true;
+}`);
+    }
+
+    const attributes = ['kJSPropertyAttributeDontDelete'];
+    if (attribute.readonly) attributes.unshift('kJSPropertyAttributeReadOnly');
+    entries.push(`    {"${attribute.name}", ${getter}, ${setter}, ${attributes.join(' | ')}},`);
+  }
+  entries.push('    {nullptr, nullptr, nullptr, 0}');
+
+  return `/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+// Generated by scripts/idl_to_binding.js, do not edit.
+
+#include "${outputName}.h"
+#include "${implHeader}"
+
+namespace kraken::binding::jsc {
+
+namespace {
+
+${instanceClass} *toInstance(JSObjectRef object) {
+  auto instance = static_cast<HostClass::Instance *>(JSObjectGetPrivate(object));
+  return static_cast<${instanceClass} *>(instance);
+}
+
+${functions.join('\n\n')}
+
+} // namespace
+
+const JSStaticValue *get${idl.name}StaticValues() {
+  static const JSStaticValue staticValues[] = {
+${entries.join('\n')}
+  };
+  return staticValues;
+}
+
+} // namespace kraken::binding::jsc
+`;
+}
+
+fs.mkdirSync(args.output, { recursive: true });
+
+for (let source of args.sources) {
+  const idl = parseInterface(source, fs.readFileSync(source, 'utf-8'));
+  const baseName = path.basename(source, '.idl');
+  const outputName = `${baseName}_binding`;
+  const implHeader = path.relative(args.root, path.join(path.dirname(source), `${baseName}.h`)).split(path.sep).join('/');
+
+  fs.writeFileSync(path.join(args.output, `${outputName}.h`), generateHeader(idl, outputName));
+  fs.writeFileSync(path.join(args.output, `${outputName}.cc`), generateSource(idl, outputName, implHeader));
+}
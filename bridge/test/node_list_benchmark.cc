@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+// Mutate the children of a single node the way long lists do: prepend items when newer content arrives, remove
+// items from the middle, append items when scrolling to the end, and read the children by index, directly and
+// through childNodes. Each pattern runs against a node that already has the given number of children, so the cost
+// of an operation shows whether it depends on the length of the list.
+//
+// Usage: kraken_node_list_benchmark [children] [operations]
+
+#include "bindings/jsc/DOM/node.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+using namespace kraken::binding::jsc;
+
+namespace {
+
+constexpr int DEFAULT_CHILD_COUNT = 10000;
+constexpr int DEFAULT_OPERATION_COUNT = 10000;
+
+NodeInstance *createNode(JSContext *context) {
+  return new NodeInstance(JSNode::instance(context), NodeType::ELEMENT_NODE);
+}
+
+NodeInstance *createList(JSContext *context, int childCount) {
+  // Children are kept alive by the list, the list is protected by the benchmark.
+  auto list = createNode(context);
+  JSValueProtect(context->context(), list->object);
+  for (int i = 0; i < childCount; i++) {
+    list->internalAppendChild(createNode(context));
+  }
+  return list;
+}
+
+void run(JSContext *context, const char *pattern, int childCount, int operationCount,
+         const std::function<void(NodeInstance *list)> &operation) {
+  JSContextRef ctx = context->context();
+  auto list = createList(context, childCount);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < operationCount; i++) {
+    operation(list);
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double ms = std::chrono::duration<double, std::milli>(end - start).count();
+  std::printf("%s: %d operations on %d children in %.2f ms, %.3f us per operation (%u children left)\n", pattern,
+              operationCount, childCount, ms, ms * 1000 / operationCount, list->childCount());
+
+  JSValueUnprotect(ctx, list->object);
+  JSGarbageCollect(ctx);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  int childCount = argc > 1 ? std::atoi(argv[1]) : DEFAULT_CHILD_COUNT;
+  int operationCount = argc > 2 ? std::atoi(argv[2]) : DEFAULT_OPERATION_COUNT;
+  if (childCount <= 0 || operationCount <= 0) {
+    std::fprintf(stderr, "Usage: kraken_node_list_benchmark [children] [operations]\n");
+    return 1;
+  }
+
+  auto context = createJSContext(0, [](int32_t contextId, const char *errmsg, JSObjectRef error) {
+    std::fprintf(stderr, "%s\n", errmsg);
+  }, nullptr);
+  JSContext *jsContext = context.get();
+
+  run(jsContext, "front insert", childCount, operationCount, [jsContext](NodeInstance *list) {
+    JSValueRef exception = nullptr;
+    list->internalInsertBefore(createNode(jsContext), list->firstChild(), &exception);
+  });
+
+  // Keep the list at the same length, so every removal is in the middle of a list of the given size.
+  run(jsContext, "middle remove", childCount, operationCount, [jsContext](NodeInstance *list) {
+    JSValueRef exception = nullptr;
+    list->internalRemoveChild(list->childAt(list->childCount() / 2), &exception);
+    list->internalAppendChild(createNode(jsContext));
+  });
+
+  run(jsContext, "append", childCount, operationCount,
+      [jsContext](NodeInstance *list) { list->internalAppendChild(createNode(jsContext)); });
+
+  run(jsContext, "read by index", childCount, operationCount, [](NodeInstance *list) {
+    uint32_t count = list->childCount();
+    for (uint32_t i = 0; i < count; i++) {
+      if (list->childAt(i) == nullptr) abort();
+    }
+  });
+
+  // Each operation reads the next child through childNodes, the way `list.childNodes[i]` does in a js loop.
+  uint32_t next = 0;
+  run(jsContext, "read childNodes by index", childCount, operationCount, [jsContext, &next](NodeInstance *list) {
+    JSContextRef ctx = jsContext->context();
+    JSValueRef childNodes = JSObjectGetProperty(ctx, list->object, jsContext->atom("childNodes"), nullptr);
+    JSObjectRef childNodesObject = JSValueToObject(ctx, childNodes, nullptr);
+    JSValueRef child = JSObjectGetPropertyAtIndex(ctx, childNodesObject, next++ % list->childCount(), nullptr);
+    if (!JSValueIsObject(ctx, child)) abort();
+  });
+
+  return 0;
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+// Build a node tree the size of a long list page and measure the native heap used per node, first for the bare
+// tree and then after adding event listeners the way such pages do: most nodes have no listener, some have one and
+// a few have several of different types.
+//
+// Usage: kraken_node_memory_benchmark [nodes] [children per node]
+
+#include "bindings/jsc/DOM/node.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+static std::atomic<int64_t> heapAllocationCount{0};
+static std::atomic<int64_t> heapAllocationBytes{0};
+
+void *operator new(size_t size) {
+  heapAllocationCount++;
+  heapAllocationBytes += size;
+  void *p = malloc(size);
+  if (p == nullptr) abort();
+  return p;
+}
+
+void *operator new[](size_t size) {
+  heapAllocationCount++;
+  heapAllocationBytes += size;
+  void *p = malloc(size);
+  if (p == nullptr) abort();
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+void operator delete[](void *p) noexcept {
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+  free(p);
+}
+
+using namespace kraken::binding::jsc;
+
+namespace {
+
+constexpr int DEFAULT_NODE_COUNT = 20000;
+constexpr int DEFAULT_FAN_OUT = 8;
+// One node in LISTENER_INTERVAL has a click listener, one in MULTIPLE_LISTENER_INTERVAL has touch listeners too.
+constexpr int LISTENER_INTERVAL = 4;
+constexpr int MULTIPLE_LISTENER_INTERVAL = 100;
+
+void addEventListener(JSContextRef ctx, NodeInstance *node, const char *eventType, JSObjectRef listener) {
+  JSStringRef name = JSStringCreateWithUTF8CString("addEventListener");
+  JSStringRef type = JSStringCreateWithUTF8CString(eventType);
+  JSObjectRef function = JSValueToObject(ctx, JSObjectGetProperty(ctx, node->object, name, nullptr), nullptr);
+  const JSValueRef arguments[] = {JSValueMakeString(ctx, type), listener};
+  JSObjectCallAsFunction(ctx, function, node->object, 2, arguments, nullptr);
+  JSStringRelease(name);
+  JSStringRelease(type);
+}
+
+struct HeapUsage {
+  int64_t count;
+  int64_t bytes;
+};
+
+HeapUsage heapUsage() {
+  return {heapAllocationCount.load(), heapAllocationBytes.load()};
+}
+
+void report(const char *phase, HeapUsage from, HeapUsage to, int nodeCount) {
+  std::printf("%s: %lld allocations, %lld bytes, %.1f bytes per node\n", phase,
+              static_cast<long long>(to.count - from.count), static_cast<long long>(to.bytes - from.bytes),
+              static_cast<double>(to.bytes - from.bytes) / nodeCount);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  int nodeCount = argc > 1 ? std::atoi(argv[1]) : DEFAULT_NODE_COUNT;
+  int fanOut = argc > 2 ? std::atoi(argv[2]) : DEFAULT_FAN_OUT;
+  if (nodeCount <= 0 || fanOut <= 0) {
+    std::fprintf(stderr, "Usage: kraken_node_memory_benchmark [nodes] [children per node]\n");
+    return 1;
+  }
+
+  auto context = createJSContext(0, [](int32_t contextId, const char *errmsg, JSObjectRef error) {
+    std::fprintf(stderr, "%s\n", errmsg);
+  }, nullptr);
+  JSContextRef ctx = context->context();
+  auto Node = JSNode::instance(context.get());
+
+  JSStringRef listenerBody = JSStringCreateWithUTF8CString("return event.type;");
+  JSObjectRef listener = JSObjectMakeFunction(ctx, nullptr, 0, nullptr, listenerBody, nullptr, 1, nullptr);
+  JSStringRelease(listenerBody);
+  JSValueProtect(ctx, listener);
+
+  std::vector<NodeInstance *> nodes;
+  nodes.reserve(nodeCount);
+
+  HeapUsage start = heapUsage();
+  // Nodes are kept alive by their parents, the root is protected by the benchmark.
+  auto root = new NodeInstance(Node, NodeType::ELEMENT_NODE);
+  JSValueProtect(ctx, root->object);
+  nodes.emplace_back(root);
+  for (int i = 1; i < nodeCount; i++) {
+    auto node = new NodeInstance(Node, NodeType::ELEMENT_NODE);
+    nodes[(i - 1) / fanOut]->internalAppendChild(node);
+    nodes.emplace_back(node);
+  }
+  HeapUsage tree = heapUsage();
+
+  int listenerCount = 0;
+  for (int i = 0; i < nodeCount; i++) {
+    if (i % LISTENER_INTERVAL == 0) {
+      addEventListener(ctx, nodes[i], "click", listener);
+      listenerCount++;
+    }
+    if (i % MULTIPLE_LISTENER_INTERVAL == 0) {
+      addEventListener(ctx, nodes[i], "touchstart", listener);
+      addEventListener(ctx, nodes[i], "touchmove", listener);
+      addEventListener(ctx, nodes[i], "touchend", listener);
+      listenerCount += 3;
+    }
+  }
+  HeapUsage listeners = heapUsage();
+
+  std::printf("%d nodes with %d listeners, sizeof(NodeInstance) %zu bytes\n", nodeCount, listenerCount,
+              sizeof(NodeInstance));
+  report("tree", start, tree, nodeCount);
+  report("listeners", tree, listeners, nodeCount);
+  report("total", start, listeners, nodeCount);
+
+  JSValueUnprotect(ctx, root->object);
+  JSValueUnprotect(ctx, listener);
+  return 0;
+}
@@ -50,3 +50,24 @@ set(TEST_INCLUDE_DIR
         ./third_party/googletest/googlemock/include
         ${BRIDGE_INCLUDE}
         )
+
+### benchmarks
+add_executable(kraken_ui_command_string_arena_benchmark ./test/ui_command_string_arena_benchmark.cc)
+target_link_libraries(kraken_ui_command_string_arena_benchmark PRIVATE ${BRIDGE_LINK_LIBS} kraken)
+target_include_directories(kraken_ui_command_string_arena_benchmark PRIVATE ${BRIDGE_INCLUDE})
+
+add_executable(kraken_ui_command_trace_replay_benchmark ./test/ui_command_trace_replay_benchmark.cc)
+target_link_libraries(kraken_ui_command_trace_replay_benchmark PRIVATE ${BRIDGE_LINK_LIBS} kraken)
+target_include_directories(kraken_ui_command_trace_replay_benchmark PRIVATE ${BRIDGE_INCLUDE})
+
+add_executable(kraken_touchmove_benchmark ./test/touchmove_benchmark.cc)
+target_link_libraries(kraken_touchmove_benchmark PRIVATE ${BRIDGE_LINK_LIBS} kraken)
+target_include_directories(kraken_touchmove_benchmark PRIVATE ${BRIDGE_INCLUDE} ${CMAKE_CURRENT_SOURCE_DIR})
+
+add_executable(kraken_node_memory_benchmark ./test/node_memory_benchmark.cc)
+target_link_libraries(kraken_node_memory_benchmark PRIVATE ${BRIDGE_LINK_LIBS} kraken)
+target_include_directories(kraken_node_memory_benchmark PRIVATE ${BRIDGE_INCLUDE} ${CMAKE_CURRENT_SOURCE_DIR})
+
+add_executable(kraken_node_list_benchmark ./test/node_list_benchmark.cc)
+target_link_libraries(kraken_node_list_benchmark PRIVATE ${BRIDGE_LINK_LIBS} kraken)
+target_include_directories(kraken_node_list_benchmark PRIVATE ${BRIDGE_INCLUDE} ${CMAKE_CURRENT_SOURCE_DIR})
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+// Dispatch touchmove events the same way as dart side does on a touch heavy page: every event carries its touches
+// and changed touches, and is dispatched to a node nested in a deep tree, where a listener reads the position of the
+// first touch and a listener of the root reads the event when it bubbles. Measures the cost of building the event
+// with the TouchList and Touch objects its listeners read, and of the propagation. The same events are then
+// dispatched to a node without listeners, which frees them right away like events dispatched from dart side.
+//
+// Usage: kraken_touchmove_benchmark [events] [touches per event] [tree depth]
+
+#include "bindings/jsc/DOM/events/touch_event.h"
+#include "bindings/jsc/DOM/node.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace kraken::binding::jsc;
+
+namespace {
+
+constexpr int DEFAULT_EVENT_COUNT = 100000;
+constexpr int DEFAULT_TOUCH_COUNT = 2;
+constexpr int DEFAULT_DEPTH = 30;
+// Collect garbage as often as a page scrolling at 60fps would, one second worth of touchmove events.
+constexpr int GC_INTERVAL = 60;
+
+NativeTouch *createTouch(int64_t identifier, double position) {
+  auto touch = new NativeTouch();
+  touch->identifier = identifier;
+  touch->target = nullptr;
+  touch->clientX = touch->screenX = touch->pageX = position;
+  touch->clientY = touch->screenY = touch->pageY = position * 2;
+  touch->force = 1;
+  return touch;
+}
+
+NativeTouchEvent *createTouchMove(int touchCount, int index) {
+  std::string type = "touchmove";
+  auto nativeEvent = new NativeEvent(stringToNativeString(type));
+  nativeEvent->bubbles = 1;
+  nativeEvent->cancelable = 1;
+  nativeEvent->timeStamp = index;
+
+  // The event takes the ownership of the arrays and the native touches, same as the ones allocated by dart side.
+  auto touches = new NativeTouch *[touchCount];
+  auto changedTouches = new NativeTouch *[touchCount];
+  for (int i = 0; i < touchCount; i++) {
+    touches[i] = createTouch(i, index + i);
+    changedTouches[i] = createTouch(i, index + i);
+  }
+
+  auto nativeTouchEvent = new NativeTouchEvent(nativeEvent);
+  nativeTouchEvent->touches = touches;
+  nativeTouchEvent->touchLength = touchCount;
+  nativeTouchEvent->changedTouches = changedTouches;
+  nativeTouchEvent->changedTouchesLength = touchCount;
+  return nativeTouchEvent;
+}
+
+void addEventListener(JSContextRef ctx, NodeInstance *node, JSObjectRef listener) {
+  JSStringRef name = JSStringCreateWithUTF8CString("addEventListener");
+  JSStringRef type = JSStringCreateWithUTF8CString("touchmove");
+  JSObjectRef function = JSValueToObject(ctx, JSObjectGetProperty(ctx, node->object, name, nullptr), nullptr);
+  const JSValueRef arguments[] = {JSValueMakeString(ctx, type), listener};
+  JSObjectCallAsFunction(ctx, function, node->object, 2, arguments, nullptr);
+  JSStringRelease(name);
+  JSStringRelease(type);
+}
+
+JSObjectRef makeListener(JSContext *context, const char *body) {
+  JSStringRef listenerBody = JSStringCreateWithUTF8CString(body);
+  JSStringRef eventName = JSStringCreateWithUTF8CString("event");
+  JSValueRef exception = nullptr;
+  JSObjectRef listener =
+    JSObjectMakeFunction(context->context(), nullptr, 1, &eventName, listenerBody, nullptr, 1, &exception);
+  JSStringRelease(listenerBody);
+  JSStringRelease(eventName);
+  if (listener == nullptr) context->handleException(exception);
+  return listener;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  int eventCount = argc > 1 ? std::atoi(argv[1]) : DEFAULT_EVENT_COUNT;
+  int touchCount = argc > 2 ? std::atoi(argv[2]) : DEFAULT_TOUCH_COUNT;
+  int depth = argc > 3 ? std::atoi(argv[3]) : DEFAULT_DEPTH;
+  if (eventCount <= 0 || touchCount <= 0 || depth <= 0) {
+    std::fprintf(stderr, "Usage: kraken_touchmove_benchmark [events] [touches per event] [tree depth]\n");
+    return 1;
+  }
+
+  auto context = createJSContext(0, [](int32_t contextId, const char *errmsg, JSObjectRef error) {
+    std::fprintf(stderr, "%s\n", errmsg);
+  }, nullptr);
+  bindEvent(context);
+  bindTouchEvent(context);
+
+  JSContextRef ctx = context->context();
+  JSObjectRef listener =
+    makeListener(context.get(), "var t = event.touches[0]; globalThis.checksum = (globalThis.checksum || 0) + "
+                                "t.clientX + t.clientY;");
+  JSObjectRef rootListener =
+    makeListener(context.get(), "globalThis.checksum += event.changedTouches.length + event.eventPhase;");
+  if (listener == nullptr || rootListener == nullptr) return 1;
+
+  // Nodes are kept alive by their parents, the root is protected by the benchmark.
+  auto root = new NodeInstance(JSNode::instance(context.get()), NodeType::ELEMENT_NODE);
+  JSValueProtect(ctx, root->object);
+  NodeInstance *target = root;
+  for (int i = 1; i < depth; i++) {
+    auto node = new NodeInstance(JSNode::instance(context.get()), NodeType::ELEMENT_NODE);
+    target->internalAppendChild(node);
+    target = node;
+  }
+  addEventListener(ctx, target, listener);
+  addEventListener(ctx, root, rootListener);
+
+  auto touchEvent = JSTouchEvent::instance(context.get());
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < eventCount; i++) {
+    auto nativeTouchEvent = createTouchMove(touchCount, i);
+    // Same as the creator of touchmove events registered by document.
+    auto event = new TouchEventInstance(touchEvent, nativeTouchEvent);
+    event->nativeEvent->target = target;
+    target->dispatchEvent(event);
+
+    if (i % GC_INTERVAL == 0) JSGarbageCollect(ctx);
+  }
+  JSGarbageCollect(ctx);
+  auto end = std::chrono::steady_clock::now();
+
+  JSStringRef checksumName = JSStringCreateWithUTF8CString("checksum");
+  double checksum = JSValueToNumber(ctx, JSObjectGetProperty(ctx, JSContextGetGlobalObject(ctx), checksumName, nullptr),
+                                    nullptr);
+  JSStringRelease(checksumName);
+
+  double ms = std::chrono::duration<double, std::milli>(end - start).count();
+  std::printf("touchmove: %d events with %d touches at depth %d in %.2f ms, %.2f us per event (checksum %.0f)\n",
+              eventCount, touchCount, depth, ms, ms * 1000 / eventCount, checksum);
+
+  auto detached = new NodeInstance(JSNode::instance(context.get()), NodeType::ELEMENT_NODE);
+  JSValueProtect(ctx, detached->object);
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < eventCount; i++) {
+    auto event = new TouchEventInstance(touchEvent, createTouchMove(touchCount, i));
+    event->nativeEvent->target = detached;
+    detached->dispatchEvent(event);
+    // Same as NativeEventTarget::dispatchEventImpl.
+    if (!event->_exposed) touchEvent->recycleEventInstance(event);
+
+    if (i % GC_INTERVAL == 0) JSGarbageCollect(ctx);
+  }
+  JSGarbageCollect(ctx);
+  end = std::chrono::steady_clock::now();
+
+  ms = std::chrono::duration<double, std::milli>(end - start).count();
+  std::printf("touchmove without listeners: %d events in %.2f ms, %.2f us per event\n", eventCount, ms,
+              ms * 1000 / eventCount);
+
+  JSValueUnprotect(ctx, detached->object);
+  JSValueUnprotect(ctx, root->object);
+  return 0;
+}
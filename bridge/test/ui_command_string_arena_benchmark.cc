@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+// Compare heap allocations of ui command payload strings between per-command heap clones
+// and UICommandStringArena, by simulating style-heavy frames of setStyle commands.
+
+#include "include/kraken_foundation.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+static std::atomic<int64_t> heapAllocationCount{0};
+
+void *operator new(size_t size) {
+  heapAllocationCount++;
+  void *p = malloc(size);
+  if (p == nullptr) abort();
+  return p;
+}
+
+void *operator new[](size_t size) {
+  heapAllocationCount++;
+  void *p = malloc(size);
+  if (p == nullptr) abort();
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+void operator delete[](void *p) noexcept {
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+  free(p);
+}
+
+namespace {
+
+constexpr int FRAME_COUNT = 60;
+constexpr int COMMANDS_PER_FRAME = 20000;
+
+struct Payload {
+  std::u16string key;
+  std::u16string value;
+};
+
+struct Command {
+  const uint16_t *string_01;
+  size_t args_01_length;
+  const uint16_t *string_02;
+  size_t args_02_length;
+};
+
+const uint16_t *cloneString(const std::u16string &string) {
+  auto *newString = new uint16_t[string.size()];
+  for (size_t i = 0; i < string.size(); i++) {
+    newString[i] = string[i];
+  }
+  return newString;
+}
+
+template <typename Fn> void runBenchmark(const char *name, Fn frame) {
+  int64_t allocationStart = heapAllocationCount;
+  auto timeStart = std::chrono::steady_clock::now();
+  for (int i = 0; i < FRAME_COUNT; i++) {
+    frame();
+  }
+  auto duration =
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - timeStart).count();
+  int64_t allocations = heapAllocationCount - allocationStart;
+  printf("%-12s frames: %d commands/frame: %d heap allocations: %lld (%.2f per frame) time: %lldus\n", name,
+         FRAME_COUNT, COMMANDS_PER_FRAME, static_cast<long long>(allocations),
+         static_cast<double>(allocations) / FRAME_COUNT, static_cast<long long>(duration));
+}
+
+} // namespace
+
+int main() {
+  std::vector<Payload> payloads;
+  payloads.reserve(COMMANDS_PER_FRAME);
+  for (int i = 0; i < COMMANDS_PER_FRAME; i++) {
+    std::string value = "rgba(" + std::to_string(i % 255) + ", 0, 0, 0.5)";
+    payloads.emplace_back(Payload{u"backgroundColor", std::u16string(value.begin(), value.end())});
+  }
+
+  std::vector<Command> queue;
+  queue.reserve(COMMANDS_PER_FRAME);
+
+  runBenchmark("heap clone", [&]() {
+    for (auto &payload : payloads) {
+      queue.emplace_back(Command{cloneString(payload.key), payload.key.size(), cloneString(payload.value),
+                                 payload.value.size()});
+    }
+    for (auto &command : queue) {
+      delete[] command.string_01;
+      delete[] command.string_02;
+    }
+    queue.clear();
+  });
+
+  foundation::UICommandStringArena arena;
+  runBenchmark("arena", [&]() {
+    for (auto &payload : payloads) {
+      auto key = reinterpret_cast<const uint16_t *>(payload.key.c_str());
+      auto value = reinterpret_cast<const uint16_t *>(payload.value.c_str());
+      queue.emplace_back(Command{arena.copy(key, payload.key.size()), payload.key.size(),
+                                 arena.copy(value, payload.value.size()), payload.value.size()});
+    }
+    arena.reset();
+    queue.clear();
+  });
+
+  printf("arena chunks: %lld strings: %lld\n", static_cast<long long>(arena.heapAllocationCount()),
+         static_cast<long long>(arena.stringAllocationCount()));
+  return 0;
+}
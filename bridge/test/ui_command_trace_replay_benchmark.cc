@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2021 Alibaba Inc. All rights reserved.
+ * Author: Kraken Team.
+ */
+
+// Replay a ui command trace recorded by startUICommandTrace through UICommandBuffer, with a stub consumer which
+// decodes commands the same way as dart side does, to measure command processing throughput.
+//
+// Usage: kraken_ui_command_trace_replay_benchmark [trace file] [iterations]
+// A synthetic bootstrap trace is generated when no trace file is given.
+
+#include "foundation/ui_command_trace.h"
+#include "include/kraken_bridge.h"
+#include "include/kraken_foundation.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int32_t REPLAY_CONTEXT_ID = 0;
+constexpr int DEFAULT_ITERATIONS = 20;
+constexpr int SYNTHETIC_NODE_COUNT = 10000;
+
+// Consumer of the replayed stream, mirrors readNativeUICommandToDart of dart side.
+struct StubConsumer {
+  std::vector<std::u16string> atoms;
+  int64_t commandCount{0};
+  int64_t checksum{0};
+
+  std::u16string readString(int64_t string, int32_t length) {
+    if (length < 0) {
+      int32_t atom = -length - 1;
+      return atom < static_cast<int32_t>(atoms.size()) ? atoms[atom] : std::u16string();
+    }
+    if (string == 0) return std::u16string();
+    return std::u16string(reinterpret_cast<const char16_t *>(string), length);
+  }
+
+  void consume(UICommandItem *items, int64_t size) {
+    for (int64_t i = 0; i < size; i++) {
+      UICommandItem &item = items[i];
+      std::u16string args_01 = readString(item.string_01, item.args_01_length);
+      std::u16string args_02 = readString(item.string_02, item.args_02_length);
+      if (item.type == UICommand::registerAtom) {
+        if (item.id >= static_cast<int32_t>(atoms.size())) atoms.resize(item.id + 1);
+        atoms[item.id] = args_01;
+      }
+      checksum += item.id + args_01.size() + args_02.size() + item.int64_01 + item.int64_02;
+      commandCount++;
+    }
+  }
+};
+
+void addRecord(foundation::UICommandBuffer *buffer, foundation::UICommandTraceRecord &record) {
+  auto &command = record.command;
+  NativeString args_01{nullptr, command.args_01_length};
+  NativeString args_02{nullptr, command.args_02_length};
+  // Payload strings are copied into the arena as buildUICommandArgs does, empty strings are still allocated.
+  if (command.args_01_length >= 0 && (record.args & foundation::UICommandTraceArgs::hasArgs01)) {
+    args_01.string = buffer->stringArena().copy(reinterpret_cast<const uint16_t *>(record.args_01.c_str()),
+                                                record.args_01.size());
+  }
+  if (command.args_02_length >= 0 && (record.args & foundation::UICommandTraceArgs::hasArgs02)) {
+    args_02.string = buffer->stringArena().copy(reinterpret_cast<const uint16_t *>(record.args_02.c_str()),
+                                                record.args_02.size());
+  }
+
+  if (record.args & foundation::UICommandTraceArgs::hasArgs02) {
+    buffer->addCommand(command.id, command.type, args_01, args_02, nullptr);
+  } else if (record.args & foundation::UICommandTraceArgs::hasArgs01) {
+    buffer->addCommand(command.id, command.type, args_01, nullptr);
+  } else if (command.int64_01 != 0 || command.int64_02 != 0) {
+    buffer->addCommand(command.id, command.type, command.int64_01, command.int64_02, nullptr);
+  } else {
+    buffer->addCommand(command.id, command.type, nullptr);
+  }
+}
+
+// Read the same slice dart side did at the recorded flush.
+void flush(foundation::UICommandBuffer *buffer, StubConsumer &consumer, foundation::UICommandTraceRecord &record) {
+  buffer->setFlushPolicy(record.flushSize, 0);
+  foundation::UICommandBuffer::setFrameFlushing(!record.forced);
+  UICommandItem *items = buffer->data();
+  consumer.consume(items, buffer->size());
+  buffer->clear();
+  foundation::UICommandBuffer::setFrameFlushing(false);
+}
+
+// Read commands left at the end of trace.
+void flushAll(foundation::UICommandBuffer *buffer, StubConsumer &consumer) {
+  buffer->setFlushPolicy(0, 0);
+  while (true) {
+    UICommandItem *items = buffer->data();
+    int64_t size = buffer->size();
+    if (size == 0) break;
+    consumer.consume(items, size);
+    buffer->clear();
+  }
+}
+
+std::u16string toU16(const std::string &string) {
+  return std::u16string(string.begin(), string.end());
+}
+
+// Bootstrap of a list page: create nodes with a few styles each (one of them removed), insert them and flush once per
+// 1000 nodes.
+bool writeSyntheticTrace(const std::string &path) {
+  auto writer = foundation::UICommandTraceWriter::open(path);
+  if (writer == nullptr) return false;
+
+  // Missing arguments are passed as nullptr.
+  auto write = [&](int32_t id, int32_t type, const char *args_01, const char *args_02, int64_t int64_01,
+                   int64_t int64_02) {
+    std::u16string string_01 = args_01 == nullptr ? std::u16string() : toU16(args_01);
+    std::u16string string_02 = args_02 == nullptr ? std::u16string() : toU16(args_02);
+    NativeString nativeArgs_01{args_01 == nullptr ? nullptr : reinterpret_cast<const uint16_t *>(string_01.c_str()),
+                               static_cast<int32_t>(string_01.size())};
+    NativeString nativeArgs_02{args_02 == nullptr ? nullptr : reinterpret_cast<const uint16_t *>(string_02.c_str()),
+                               static_cast<int32_t>(string_02.size())};
+    UICommandItem item{id, type, nativeArgs_01, nativeArgs_02, nullptr};
+    item.int64_01 = int64_01;
+    item.int64_02 = int64_02;
+    writer->writeCommand(item);
+  };
+
+  int64_t pending = 0;
+  for (int32_t id = 1; id <= SYNTHETIC_NODE_COUNT; id++) {
+    std::string width = std::to_string(id % 300) + "px";
+    std::string color = "rgba(" + std::to_string(id % 255) + ", 0, 0, 0.5)";
+    write(id, UICommand::createElement, "div", nullptr, 0, 0);
+    write(id, UICommand::setStyle, "width", width.c_str(), 0, 0);
+    write(id, UICommand::setStyle, "height", "44px", 0, 0);
+    write(id, UICommand::setStyle, "backgroundColor", color.c_str(), 0, 0);
+    write(id, UICommand::setStyle, "opacity", "", 0, 0);
+    write(id, UICommand::setProperty, "className", "list-item", 0, 0);
+    write(-1, UICommand::insertAdjacentNode, nullptr, nullptr, id, AdjacentPosition::beforeEnd);
+    pending += 7;
+    if (id % 1000 == 0) {
+      writer->writeFlush(pending, false);
+      pending = 0;
+    }
+  }
+  if (pending > 0) writer->writeFlush(pending, false);
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string path = argc > 1 ? argv[1] : "/tmp/kraken_ui_command_trace_synthetic.bin";
+  int iterations = argc > 2 ? atoi(argv[2]) : DEFAULT_ITERATIONS;
+  if (argc <= 1 && !writeSyntheticTrace(path)) {
+    fprintf(stderr, "Failed to write synthetic trace to %s\n", path.c_str());
+    return 1;
+  }
+
+  // Load the whole trace first so file reading is not measured.
+  auto reader = foundation::UICommandTraceReader::open(path);
+  if (reader == nullptr) {
+    fprintf(stderr, "Failed to open ui command trace %s\n", path.c_str());
+    return 1;
+  }
+  std::vector<foundation::UICommandTraceRecord> records;
+  foundation::UICommandTraceRecord record;
+  int64_t payloadBytes = 0;
+  while (reader->next(record)) {
+    payloadBytes += (record.args_01.size() + record.args_02.size()) * sizeof(char16_t);
+    records.emplace_back(record);
+  }
+
+  auto buffer = foundation::UICommandBuffer::instance(REPLAY_CONTEXT_ID);
+  StubConsumer consumer;
+  auto timeStart = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    for (auto &item : records) {
+      switch (item.tag) {
+      case foundation::UICommandTraceTag::command:
+        addRecord(buffer, item);
+        break;
+      case foundation::UICommandTraceTag::flush:
+        flush(buffer, consumer, item);
+        break;
+      case foundation::UICommandTraceTag::discard:
+        buffer->clear();
+        break;
+      }
+    }
+    flushAll(buffer, consumer);
+  }
+  auto duration =
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - timeStart).count();
+
+  double seconds = duration / 1e6;
+  printf("records: %zu iterations: %d commands: %lld time: %lldus\n", records.size(), iterations,
+         static_cast<long long>(consumer.commandCount), static_cast<long long>(duration));
+  printf("throughput: %.0f commands/s %.2f MB/s payload checksum: %lld\n", consumer.commandCount / seconds,
+         payloadBytes * iterations / seconds / (1024 * 1024), static_cast<long long>(consumer.checksum));
+  return 0;
+}
@@ -35,6 +35,7 @@ type SimulatePointer = (list: [number, number, number][], pointer: number) => vo
 type SimulateInputText = (chars: string) => void;
 declare const simulatePointer: SimulatePointer;
 declare const simulateInputText: SimulateInputText;
+declare function getDispatchedEventCount(): number;
 
 interface Navigator {
   connection: {
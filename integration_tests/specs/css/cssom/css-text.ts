@@ -0,0 +1,47 @@
+describe('CSSStyleDeclaration cssText', () => {
+  it('sets and serializes declarations', () => {
+    const div = document.createElement('div');
+    div.style.cssText = 'width: 100px; background-color: red';
+
+    expect(div.style.width).toBe('100px');
+    expect(div.style.backgroundColor).toBe('red');
+    expect(div.style.cssText).toBe('width: 100px; background-color: red;');
+  });
+
+  it('keeps the case of values', () => {
+    const div = document.createElement('div');
+    div.style.cssText = 'font-family: AlibabaSans; background-image: url(Assets/Kraken.PNG);';
+
+    expect(div.style.fontFamily).toBe('AlibabaSans');
+    expect(div.style.backgroundImage).toBe('url(Assets/Kraken.PNG)');
+  });
+
+  it('matches property names case-insensitively', () => {
+    const div = document.createElement('div');
+    div.style.cssText = 'WIDTH: 10px; Height: 20px';
+
+    expect(div.style.width).toBe('10px');
+    expect(div.style.height).toBe('20px');
+  });
+
+  it('resets properties removed from cssText', async () => {
+    const div = document.createElement('div');
+    div.style.cssText = 'width: 100px; height: 50px; background-color: green';
+    document.body.appendChild(div);
+    expect(div.getBoundingClientRect().height).toBe(50);
+
+    div.style.cssText = 'width: 100px; background-color: green';
+
+    expect(div.style.height).toBe('');
+    expect(div.style.cssText).toBe('width: 100px; background-color: green;');
+    expect(div.getBoundingClientRect().height).toBe(0);
+  });
+
+  it('keeps the properties set one by one in sync', () => {
+    const div = document.createElement('div');
+    div.style.cssText = 'width: 100px';
+    div.style.height = '20px';
+
+    expect(div.style.cssText).toBe('width: 100px; height: 20px;');
+  });
+});
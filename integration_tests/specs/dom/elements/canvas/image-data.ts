@@ -0,0 +1,108 @@
+describe('Canvas image data', () => {
+  // getImageData resolves with pixels of every operation submitted before it.
+  async function readPixel(ctx: any, x: number, y: number) {
+    const imageData = await ctx.getImageData(x, y, 1, 1);
+    return Array.from(imageData.data);
+  }
+
+  it('getImageData returns transparent pixels of a blank canvas', async () => {
+    const canvas = <canvas />;
+    document.body.appendChild(canvas);
+    const ctx = canvas.getContext('2d');
+
+    const imageData = await (ctx as any).getImageData(0, 0, 4, 2);
+    expect(imageData.width).toBe(4);
+    expect(imageData.height).toBe(2);
+    expect(imageData.data.length).toBe(4 * 2 * 4);
+    expect(Array.from(imageData.data).every(value => value === 0)).toBe(true);
+  });
+
+  it('getImageData reads back drawn pixels', async () => {
+    const canvas = <canvas />;
+    document.body.appendChild(canvas);
+    const ctx = canvas.getContext('2d');
+
+    ctx.fillStyle = 'rgb(0, 128, 0)';
+    ctx.fillRect(0, 0, 10, 10);
+
+    expect(await readPixel(ctx, 5, 5)).toEqual([0, 128, 0, 255]);
+    expect(await readPixel(ctx, 20, 20)).toEqual([0, 0, 0, 0]);
+  });
+
+  it('getImageData does not see operations submitted after it', async () => {
+    const canvas = <canvas />;
+    document.body.appendChild(canvas);
+    const ctx = canvas.getContext('2d');
+
+    ctx.fillStyle = 'rgb(0, 128, 0)';
+    ctx.fillRect(0, 0, 10, 10);
+    const before = (ctx as any).getImageData(5, 5, 1, 1);
+    ctx.fillStyle = 'rgb(255, 0, 0)';
+    ctx.fillRect(0, 0, 10, 10);
+    const after = (ctx as any).getImageData(5, 5, 1, 1);
+
+    expect(Array.from((await before).data)).toEqual([0, 128, 0, 255]);
+    expect(Array.from((await after).data)).toEqual([255, 0, 0, 255]);
+  });
+
+  it('getImageData reads a canvas which is not in the document', async () => {
+    const canvas = <canvas />;
+    const ctx = canvas.getContext('2d');
+
+    ctx.fillStyle = 'rgb(0, 0, 255)';
+    ctx.fillRect(0, 0, 10, 10);
+
+    expect(await readPixel(ctx, 5, 5)).toEqual([0, 0, 255, 255]);
+  });
+
+  it('getImageData throws on a non-finite or too large rect', () => {
+    const canvas = <canvas />;
+    const ctx = canvas.getContext('2d') as any;
+
+    expect(() => ctx.getImageData(0, 0, NaN, 1)).toThrowError(/not finite/);
+    expect(() => ctx.getImageData(Infinity, 0, 1, 1)).toThrowError(/not finite/);
+    expect(() => ctx.getImageData(0, 0, 1e9, 1e9)).toThrowError(/too large/);
+  });
+
+  it('putImageData accepts a view at an offset of its buffer', async () => {
+    const canvas = <canvas />;
+    document.body.appendChild(canvas);
+    const ctx = canvas.getContext('2d');
+
+    // The leading pixel is green, it must not be drawn.
+    const buffer = new Uint8ClampedArray(4 + 2 * 2 * 4);
+    buffer.set([0, 255, 0, 255]);
+    const data = buffer.subarray(4);
+    for (let i = 0; i < data.length; i += 4) {
+      data.set([255, 0, 0, 255], i);
+    }
+    (ctx as any).putImageData({ width: 2, height: 2, data }, 10, 10);
+
+    expect(await readPixel(ctx, 10, 10)).toEqual([255, 0, 0, 255]);
+    expect(await readPixel(ctx, 11, 11)).toEqual([255, 0, 0, 255]);
+  });
+
+  it('appendPathSegments accepts a view at an offset of its buffer', async () => {
+    const canvas = <canvas />;
+    document.body.appendChild(canvas);
+    const ctx = canvas.getContext('2d');
+
+    // moveTo(0, 0) lineTo(20, 0) lineTo(20, 20) lineTo(0, 20) closePath, after a leading invalid verb.
+    const segments = new Float32Array([NaN, 0, 0, 0, 1, 20, 0, 1, 20, 20, 1, 0, 20, 4]).subarray(1);
+    ctx.beginPath();
+    (ctx as any).appendPathSegments(segments);
+    ctx.fillStyle = 'rgb(0, 0, 255)';
+    ctx.fill();
+
+    expect(await readPixel(ctx, 10, 10)).toEqual([0, 0, 255, 255]);
+  });
+
+  it('appendPathSegments throws on a malformed path', () => {
+    const canvas = <canvas />;
+    const ctx = canvas.getContext('2d');
+
+    expect(() => {
+      (ctx as any).appendPathSegments(new Float32Array([1, 20]));
+    }).toThrowError(/invalid segment at 0/);
+  });
+});
@@ -0,0 +1,91 @@
+describe('Event phase', () => {
+  const NONE = 0;
+  const CAPTURING_PHASE = 1;
+  const AT_TARGET = 2;
+  const BUBBLING_PHASE = 3;
+
+  function createTree() {
+    const outer = document.createElement('div');
+    const inner = document.createElement('div');
+    const target = document.createElement('div');
+    outer.appendChild(inner);
+    inner.appendChild(target);
+    document.body.appendChild(outer);
+    return { outer, inner, target };
+  }
+
+  it('runs capturing listeners from the root down before bubbling ones', () => {
+    const { outer, inner, target } = createTree();
+    const log: string[] = [];
+    outer.addEventListener('custom', () => log.push('outer bubble'));
+    outer.addEventListener('custom', () => log.push('outer capture'), true);
+    inner.addEventListener('custom', () => log.push('inner bubble'));
+    inner.addEventListener('custom', () => log.push('inner capture'), { capture: true });
+    target.addEventListener('custom', () => log.push('target'));
+
+    target.dispatchEvent(new Event('custom', { bubbles: true }));
+
+    expect(log).toEqual(['outer capture', 'inner capture', 'target', 'inner bubble', 'outer bubble']);
+  });
+
+  it('exposes eventPhase and currentTarget of every phase', () => {
+    const { outer, target } = createTree();
+    const phases: number[] = [];
+    outer.addEventListener('custom', (e) => {
+      expect(e.currentTarget).toBe(outer);
+      phases.push(e.eventPhase);
+    }, true);
+    target.addEventListener('custom', (e) => {
+      expect(e.currentTarget).toBe(target);
+      phases.push(e.eventPhase);
+    });
+    outer.addEventListener('custom', (e) => phases.push(e.eventPhase));
+
+    const event = new Event('custom', { bubbles: true });
+    target.dispatchEvent(event);
+
+    expect(phases).toEqual([CAPTURING_PHASE, AT_TARGET, BUBBLING_PHASE]);
+    expect(event.eventPhase).toBe(NONE);
+  });
+
+  it('does not bubble events without bubbles, but still captures them', () => {
+    const { outer, target } = createTree();
+    const log: string[] = [];
+    outer.addEventListener('custom', () => log.push('capture'), true);
+    outer.addEventListener('custom', () => log.push('bubble'));
+
+    target.dispatchEvent(new Event('custom'));
+
+    expect(log).toEqual(['capture']);
+  });
+
+  it('stops propagation in the capturing phase', () => {
+    const { outer, inner, target } = createTree();
+    const log: string[] = [];
+    outer.addEventListener('custom', (e) => {
+      log.push('outer capture');
+      e.stopPropagation();
+    }, true);
+    inner.addEventListener('custom', () => log.push('inner capture'), true);
+    target.addEventListener('custom', () => log.push('target'));
+
+    target.dispatchEvent(new Event('custom', { bubbles: true }));
+
+    expect(log).toEqual(['outer capture']);
+  });
+
+  it('removes capturing and bubbling listeners separately', () => {
+    const { outer, target } = createTree();
+    const log: string[] = [];
+    const listener = (e: Event) => log.push(String(e.eventPhase));
+    outer.addEventListener('custom', listener, true);
+    outer.addEventListener('custom', listener);
+    // Duplicated registration is ignored.
+    outer.addEventListener('custom', listener, { capture: true });
+
+    outer.removeEventListener('custom', listener, true);
+    target.dispatchEvent(new Event('custom', { bubbles: true }));
+
+    expect(log).toEqual([String(BUBBLING_PHASE)]);
+  });
+});
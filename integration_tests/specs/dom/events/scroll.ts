@@ -27,4 +27,35 @@ describe('Event scroll', () => {
     container.addEventListener('scroll', scrollListener);
     container.scrollTo(0, 50);
   });
+
+  it('should update scrollTop scrolled by dart side without scroll listener', async () => {
+    const container = document.createElement('div');
+    Object.assign(container.style, {
+      height: '100px',
+      overflow: 'auto',
+    });
+
+    const first = document.createElement('div');
+    for (var i = 0; i < 9; i ++) {
+      const item = i === 0 ? first : document.createElement('div');
+      Object.assign(item.style, {
+        height: '45px',
+        background: 'red',
+        marginBottom: '10px',
+      });
+      container.appendChild(item);
+    }
+    document.body.appendChild(container);
+
+    // Geometry read before the scroll must not be returned after it.
+    expect(container.scrollTop).toBe(0);
+    const top = first.getBoundingClientRect().top;
+
+    await simulateSwipe(20, 80, 20, 20, 0.1);
+    await sleep(0.1);
+
+    const scrollTop = container.scrollTop;
+    expect(scrollTop).toBeGreaterThan(0);
+    expect(first.getBoundingClientRect().top).toBe(top - scrollTop);
+  });
 });
\ No newline at end of file
@@ -175,4 +175,22 @@ describe('TouchEvent', () => {
     
     await simulateSwipe(0, 0, 0, 100, 0.5);
   });
+
+  it('should not dispatch to js when no target of the path listens', async () => {
+    const div = document.createElement('div');
+    div.style.backgroundColor = 'blue';
+    div.style.width = '30px';
+    div.style.height = '30px';
+    document.body.appendChild(div);
+
+    const count = getDispatchedEventCount();
+    await simulateClick(10, 10);
+    expect(getDispatchedEventCount()).toBe(count);
+
+    let touchNum = 0;
+    document.body.addEventListener('touchstart', () => touchNum++);
+    await simulateClick(10, 10);
+    expect(touchNum).toBe(1);
+    expect(getDispatchedEventCount()).toBeGreaterThan(count);
+  });
 });
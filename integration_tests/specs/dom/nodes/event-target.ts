@@ -171,4 +171,37 @@ describe('DOM EventTarget', () => {
     expect(shouldNotBeTrue).toEqual(false);
   });
 
+  it('preventDefault should be ignored in passive listeners', () => {
+    const div = document.createElement('div');
+    document.body.appendChild(div);
+
+    div.addEventListener('passive', (event: Event) => {
+      event.preventDefault();
+    }, { passive: true });
+    div.addEventListener('active', (event: Event) => {
+      event.preventDefault();
+    });
+    const passiveEvent = new CustomEvent('passive', { cancelable: true });
+    div.dispatchEvent(passiveEvent);
+    expect(passiveEvent.defaultPrevented).toEqual(false);
+
+    const activeEvent = new CustomEvent('active', { cancelable: true });
+    div.dispatchEvent(activeEvent);
+    expect(activeEvent.defaultPrevented).toEqual(true);
+  });
+
+  it('getCoalescedEvents should contain the event itself', () => {
+    const div = document.createElement('div');
+    document.body.appendChild(div);
+
+    let coalescedEvents: Event[] = [];
+    div.addEventListener('custom', (event: any) => {
+      coalescedEvents = event.getCoalescedEvents();
+    });
+    const event = new Event('custom');
+    div.dispatchEvent(event);
+    expect(coalescedEvents.length).toEqual(1);
+    expect(coalescedEvents[0]).toBe(event);
+  });
+
 });
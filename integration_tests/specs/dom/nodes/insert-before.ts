@@ -28,6 +28,31 @@ describe('Insert before', () => {
     expect(node.parentNode).toBe(otherContainer);
     expect(container.childNodes.length).toBe(0);
   });
+  it('with node is the reference node', () => {
+    let container = document.createElement('div');
+    let first = document.createElement('div');
+    let node = document.createElement('div');
+    let last = document.createElement('div');
+    container.appendChild(first);
+    container.appendChild(node);
+    container.appendChild(last);
+    container.insertBefore(node, node);
+    expect(container.childNodes.length).toBe(3);
+    expect(node.parentNode).toBe(container);
+    expect(node.previousSibling).toBe(first);
+    expect(node.nextSibling).toBe(last);
+  });
+  it('with node is the reference node and the last child', () => {
+    let container = document.createElement('div');
+    let first = document.createElement('div');
+    let node = document.createElement('div');
+    container.appendChild(first);
+    container.appendChild(node);
+    container.insertBefore(node, node);
+    expect(container.childNodes.length).toBe(2);
+    expect(container.firstChild).toBe(first);
+    expect(container.lastChild).toBe(node);
+  });
   it('basic', async () => {
     var div = document.createElement('div');
     var span = document.createElement('span');
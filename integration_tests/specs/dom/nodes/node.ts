@@ -119,4 +119,35 @@ describe('Node API', () => {
     let img = new Image();
     expect(img.ownerDocument).toBe(document);
   });
+
+  it('childNodes should be live and read by index', () => {
+    let container = document.createElement('div');
+    let childNodes = container.childNodes;
+    expect(childNodes.length).toBe(0);
+    expect(childNodes[0]).toBe(undefined);
+
+    let children: HTMLElement[] = [];
+    for (let i = 0; i < 100; i++) {
+      let child = document.createElement('div');
+      children.push(child);
+      container.appendChild(child);
+    }
+    expect(container.childNodes).toBe(childNodes);
+    expect(childNodes.length).toBe(100);
+    for (let i = 0; i < childNodes.length; i++) {
+      expect(childNodes[i]).toBe(children[i]);
+    }
+    for (let i = childNodes.length - 1; i >= 0; i--) {
+      expect(childNodes[i]).toBe(children[i]);
+    }
+
+    container.removeChild(children[50]);
+    expect(childNodes.length).toBe(99);
+    expect(childNodes[50]).toBe(children[51]);
+    expect(childNodes[99]).toBe(undefined);
+    expect(Array.prototype.indexOf.call(childNodes, children[99])).toBe(98);
+    let count = 0;
+    childNodes.forEach(() => count++);
+    expect(count).toBe(99);
+  });
 });
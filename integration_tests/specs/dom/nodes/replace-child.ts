@@ -17,4 +17,27 @@ describe('Replace child', () => {
     expect(node.parentNode).toBe(null);
     expect(newChild.parentNode).toBe(container);
   });
+  it('with new child is the old child', () => {
+    let container = document.createElement('div');
+    let first = document.createElement('div');
+    let node = document.createElement('div');
+    let last = document.createElement('div');
+    container.appendChild(first);
+    container.appendChild(node);
+    container.appendChild(last);
+    container.replaceChild(node, node);
+    expect(container.childNodes.length).toBe(3);
+    expect(node.parentNode).toBe(container);
+    expect(node.previousSibling).toBe(first);
+    expect(node.nextSibling).toBe(last);
+  });
+  it('with new child is the only child', () => {
+    let container = document.createElement('div');
+    let node = document.createElement('div');
+    container.appendChild(node);
+    container.replaceChild(node, node);
+    expect(container.firstChild).toBe(node);
+    expect(container.lastChild).toBe(node);
+    expect(node.parentNode).toBe(container);
+  });
 });
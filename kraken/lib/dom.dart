@@ -5,6 +5,7 @@
 
 export 'src/dom/binding.dart';
 export 'src/dom/element.dart';
+export 'src/dom/element_native_methods.dart' show ViewModuleProperty;
 export 'src/dom/element_manager.dart';
 export 'src/dom/event_handler.dart';
 export 'src/dom/event.dart';
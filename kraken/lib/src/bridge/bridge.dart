@@ -37,7 +37,12 @@ int initBridge() {
       // Port flutter's frame callback into bridge.
       SchedulerBinding.instance!.addPersistentFrameCallback((_) {
         assert(contextId != -1);
-        flushUICommand();
+        // Layout of this frame is done, publish geometry before applying new commands.
+        publishGeometrySnapshot();
+        flushUICommand(frame: true);
+        flushCanvasDisplayLists();
+        // Only releases native structs of batches which have been fully handed over, later slices of a batch may
+        // still refer to them.
         flushUICommandCallback();
       });
     });
@@ -303,6 +303,20 @@ void _flushUICommand() {
 
 final Pointer<NativeFunction<NativeFlushUICommand>> _nativeFlushUICommand = Pointer.fromFunction(_flushUICommand);
 
+typedef NativeFlushContextUICommand = Void Function(Int32 contextId);
+
+void _flushContextUICommand(int contextId) {
+  if (kProfileMode) {
+    PerformanceTiming.instance().mark(PERF_DOM_FLUSH_UI_COMMAND_START);
+  }
+  flushContextUICommand(contextId);
+  if (kProfileMode) {
+    PerformanceTiming.instance().mark(PERF_DOM_FLUSH_UI_COMMAND_END);
+  }
+}
+
+final Pointer<NativeFunction<NativeFlushContextUICommand>> _nativeFlushContextUICommand = Pointer.fromFunction(_flushContextUICommand);
+
 // HTML Element is special element which created at initialize time, so we can't use UICommandQueue to init.
 typedef NativeInitHTML = Void Function(Int32 contextId, Pointer<NativeElement> nativePtr);
 void _initHTML(int contextId, Pointer<NativeElement> nativePtr) {
@@ -328,6 +342,34 @@ void _initDocument(int contextId, Pointer<NativeDocument> nativePtr) {
 
 final Pointer<NativeFunction<NativeInitDocument>> _nativeInitDocument = Pointer.fromFunction(_initDocument);
 
+// Read bounding client rects of many elements with one call, such as measuring all items of a list on scroll.
+typedef NativeGetBoundingClientRects = Void Function(
+    Int32 contextId, Pointer<Int32> targetIds, Int32 length, Pointer<Double> rects);
+
+// Keep in sync with the fields of NativeBoundingClientRect.
+const int _boundingClientRectSize = 8;
+
+void _getBoundingClientRects(int contextId, Pointer<Int32> targetIds, int length, Pointer<Double> rects) {
+  KrakenController? controller = KrakenController.getControllerOfJSContextId(contextId);
+  Int32List ids = targetIds.asTypedList(length);
+  Float64List values = rects.asTypedList(length * _boundingClientRectSize);
+  for (int i = 0; i < length; i++) {
+    int base = i * _boundingClientRectSize;
+    EventTarget? element = controller?.view.getEventTargetById(ids[i]);
+    if (element is! Element) {
+      values.fillRange(base, base + _boundingClientRectSize, 0);
+      continue;
+    }
+    // Only the first element lays out, the others read the layout done by it.
+    element.flushLayout();
+    BoundingClientRect rect = element.boundingClientRect;
+    values.setAll(base, [rect.x, rect.y, rect.width, rect.height, rect.top, rect.right, rect.bottom, rect.left]);
+  }
+}
+
+final Pointer<NativeFunction<NativeGetBoundingClientRects>> _nativeGetBoundingClientRects =
+    Pointer.fromFunction(_getBoundingClientRects);
+
 typedef NativePerformanceGetEntries = Pointer<NativePerformanceEntryList> Function(Int32 contextId);
 typedef DartPerformanceGetEntries = Pointer<NativePerformanceEntryList> Function(int contextId);
 
@@ -367,9 +409,11 @@ final List<int> _dartNativeMethods = [
   _nativePlatformBrightness.address,
   _nativeToBlob.address,
   _nativeFlushUICommand.address,
+  _nativeFlushContextUICommand.address,
   _nativeInitHTML.address,
   _nativeInitWindow.address,
   _nativeInitDocument.address,
+  _nativeGetBoundingClientRects.address,
   _nativeGetEntries.address,
   _nativeOnJsError.address,
 ];
@@ -224,12 +224,25 @@ class NativeBoundingClientRect extends Struct {
   external double left;
 }
 
+class NativeGeometrySnapshot extends Struct {
+  external Pointer<Int32> targetIds;
+
+  external Pointer<Double> rows;
+
+  @Int64()
+  external int length;
+}
+
 typedef NativeDispatchEvent = Void Function(
     Pointer<NativeEventTarget> nativeEventTarget, Pointer<NativeString> eventType, Pointer<Void> nativeEvent, Int32 isCustomEvent);
 
 class NativeEventTarget extends Struct {
   external Pointer<Void> instance;
   external Pointer<NativeFunction<NativeDispatchEvent>> dispatchEvent;
+  // Bit i is set when the target or one of its descendants has js listeners of the i-th event type of
+  // click, touchstart, touchmove, touchend, touchcancel, scroll, swipe, pan, longpress and scale.
+  @Uint32()
+  external int subtreeListenerMask;
 }
 
 class NativeNode extends Struct {
@@ -326,76 +339,54 @@ class NativeCanvasElement extends Struct {
   external Pointer<NativeFunction<NativeCanvasGetContext>> getContext;
 }
 
-typedef NativeRenderingContextSetProperty = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> value);
-
-typedef NativeRenderingContextArc = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double x, Double y, Double radius, Double startAngle, Double endAngle, Double counterclockwise);
-typedef NativeRenderingContextArcTo = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double x1, Double y1, Double x2, Double y2, Double radius);
-typedef NativeRenderingContextBeginPath = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr);
-typedef NativeRenderingContextClosePath = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr);
-typedef NativeRenderingContextClearRect = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double x, Double y, Double width, Double height);
-typedef NativeRenderingContextDrawImage = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Int32 argumentCount, Pointer<NativeImgElement> image,
-  Double sx, Double sy, Double sWidth, Double sHeight, Double dx, Double dy, Double dWidth, Double dHeight);
-typedef NativeRenderingContextStrokeRect = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double x, Double y, Double width, Double height);
-typedef NativeRenderingContextStrokeText = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> text, Double x, Double y, Double maxWidth);
-typedef NativeRenderingContextSave = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr);
-typedef NativeRenderingContextRestore = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr);
-typedef NativeRenderingContextBezierCurveTo = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double x1, Double y1, Double x2, Double y2, Double x, Double y);
-typedef NativeRenderingContextClip = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> fillRule);
-typedef NativeRenderingContextEllipse = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double x, Double y, Double radiusX, Double radiusY, Double rotation, Double startAngle, Double endAngle, Double counterclockwise);
-typedef NativeRenderingContextFill = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> fillRule);
-typedef NativeRenderingContextFillRect = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double x, Double y, Double width, Double height);
-typedef NativeRenderingContextFillText = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> text, Double x, Double y, Double maxWidth);
-typedef NativeRenderingContextLineTo = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double x, Double y);
-typedef NativeRenderingContextMoveTo = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double x, Double y);
-typedef NativeRenderingContextQuadraticCurveTo = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double cpx, Double cpy, Double x, Double y);
-typedef NativeRenderingContextRect = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double x, Double y, Double width, Double height);
-typedef NativeRenderingContextRotate = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double angle);
-typedef NativeRenderingContextResetTransform = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr);
-typedef NativeRenderingContextScale = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double x, Double y);
-typedef NativeRenderingContextStroke = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr);
-typedef NativeRenderingContextSetTransform = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double a, Double b, Double c, Double d, Double e, Double f);
-typedef NativeRenderingContextTransform = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double a, Double b, Double c, Double d, Double e, Double f);
-typedef NativeRenderingContextTranslate = Void Function(Pointer<NativeCanvasRenderingContext2D> nativePtr, Double x, Double y);
+// Draw operations recorded by native side, see NativeCanvasDisplayList in canvas_element.h.
+class NativeCanvasDisplayList extends Struct {
+  external Pointer<Double> ops;
+
+  @Int64()
+  external int length;
+
+  external Pointer<NativeString> strings;
+
+  @Int64()
+  external int stringsLength;
+
+  external Pointer<Float> floats;
+
+  @Int64()
+  external int floatsLength;
+}
+
+// Pixels passed to the callback of getImageData, released by native side with free.
+class NativeImageData extends Struct {
+  external Pointer<Uint8> data;
+
+  @Int64()
+  external int length;
+
+  @Int64()
+  external int width;
+
+  @Int64()
+  external int height;
+}
+
+typedef NativeRenderingContextSubmitDisplayList = Void Function(
+    Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeCanvasDisplayList> displayList);
+typedef NativeImageDataCallback = Void Function(
+    Pointer<Void> callbackContext, Int32 contextId, Pointer<Utf8> errmsg, Pointer<NativeImageData> imageData);
+typedef DartImageDataCallback = void Function(
+    Pointer<Void> callbackContext, int contextId, Pointer<Utf8> errmsg, Pointer<NativeImageData> imageData);
+typedef NativeRenderingContextGetImageData = Void Function(
+    Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<Void> callbackContext, Int32 contextId,
+    Pointer<NativeFunction<NativeImageDataCallback>> callback, Double sx, Double sy, Double sw, Double sh);
+typedef NativeRenderingContextPutImageData = Void Function(
+    Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<Uint8> data, Int64 width, Int64 height, Double dx, Double dy);
 
 class NativeCanvasRenderingContext2D extends Struct {
-  external Pointer<NativeFunction<NativeRenderingContextSetProperty>> setDirection;
-  external Pointer<NativeFunction<NativeRenderingContextSetProperty>> setFont;
-  external Pointer<NativeFunction<NativeRenderingContextSetProperty>> setFillStyle;
-  external Pointer<NativeFunction<NativeRenderingContextSetProperty>> setStrokeStyle;
-  external Pointer<NativeFunction<NativeRenderingContextSetProperty>> setLineCap;
-  external Pointer<NativeFunction<NativeRenderingContextSetProperty>> setLineDashOffset;
-  external Pointer<NativeFunction<NativeRenderingContextSetProperty>> setLineJoin;
-  external Pointer<NativeFunction<NativeRenderingContextSetProperty>> setLineWidth;
-  external Pointer<NativeFunction<NativeRenderingContextSetProperty>> setMiterLimit;
-  external Pointer<NativeFunction<NativeRenderingContextSetProperty>> setTextAlign;
-  external Pointer<NativeFunction<NativeRenderingContextSetProperty>> setTextBaseline;
-  external Pointer<NativeFunction<NativeRenderingContextArc>> arc;
-  external Pointer<NativeFunction<NativeRenderingContextArcTo>> arcTo;
-  external Pointer<NativeFunction<NativeRenderingContextBeginPath>> beginPath;
-  external Pointer<NativeFunction<NativeRenderingContextBezierCurveTo>> bezierCurveTo;
-  external Pointer<NativeFunction<NativeRenderingContextClearRect>> clearRect;
-  external Pointer<NativeFunction<NativeRenderingContextClip>> clip;
-  external Pointer<NativeFunction<NativeRenderingContextClosePath>> closePath;
-  external Pointer<NativeFunction<NativeRenderingContextDrawImage>> drawImage;
-  external Pointer<NativeFunction<NativeRenderingContextEllipse>> ellipse;
-  external Pointer<NativeFunction<NativeRenderingContextFill>> fill;
-  external Pointer<NativeFunction<NativeRenderingContextFillRect>> fillRect;
-  external Pointer<NativeFunction<NativeRenderingContextFillText>> fillText;
-  external Pointer<NativeFunction<NativeRenderingContextLineTo>> lineTo;
-  external Pointer<NativeFunction<NativeRenderingContextMoveTo>> moveTo;
-  external Pointer<NativeFunction<NativeRenderingContextQuadraticCurveTo>> quadraticCurveTo;
-  external Pointer<NativeFunction<NativeRenderingContextRect>> rect;
-  external Pointer<NativeFunction<NativeRenderingContextRestore>> restore;
-  external Pointer<NativeFunction<NativeRenderingContextRotate>> rotate;
-  external Pointer<NativeFunction<NativeRenderingContextResetTransform>> resetTransform;
-  external Pointer<NativeFunction<NativeRenderingContextSave>> save;
-  external Pointer<NativeFunction<NativeRenderingContextScale>> scale;
-  external Pointer<NativeFunction<NativeRenderingContextStroke>> stroke;
-  external Pointer<NativeFunction<NativeRenderingContextStrokeRect>> strokeRect;
-  external Pointer<NativeFunction<NativeRenderingContextStrokeText>> strokeText;
-  external Pointer<NativeFunction<NativeRenderingContextSetTransform>> setTransform;
-  external Pointer<NativeFunction<NativeRenderingContextTransform>> transform;
-  external Pointer<NativeFunction<NativeRenderingContextTranslate>> translate;
+  external Pointer<NativeFunction<NativeRenderingContextSubmitDisplayList>> submitDisplayList;
+  external Pointer<NativeFunction<NativeRenderingContextGetImageData>> getImageData;
+  external Pointer<NativeFunction<NativeRenderingContextPutImageData>> putImageData;
 }
 
 class NativePerformanceEntry extends Struct {
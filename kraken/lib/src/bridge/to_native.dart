@@ -1,6 +1,7 @@
 import 'dart:async';
 import 'dart:ffi';
 import 'dart:io';
+import 'dart:typed_data';
 
 import 'package:ffi/ffi.dart';
 import 'package:flutter/foundation.dart';
@@ -268,6 +269,7 @@ enum UICommandType {
   removeProperty,
   cloneNode,
   removeEvent,
+  registerAtom,
 }
 
 class UICommandItem extends Struct {
@@ -303,15 +305,110 @@ typedef DartClearUICommandItems = void Function(int contextId);
 final DartClearUICommandItems _clearUICommandItems =
     nativeDynamicLibrary.lookup<NativeFunction<NativeClearUICommandItems>>('clearUICommandItems').asFunction();
 
+typedef NativeSetUICommandFrameFlushing = Void Function(Int32 flushing);
+typedef DartSetUICommandFrameFlushing = void Function(int flushing);
+
+final DartSetUICommandFrameFlushing _setUICommandFrameFlushing =
+    nativeDynamicLibrary.lookup<NativeFunction<NativeSetUICommandFrameFlushing>>('setUICommandFrameFlushing').asFunction();
+
+typedef NativeGetGeometrySnapshot = Pointer<NativeGeometrySnapshot> Function(Int32 contextId);
+typedef DartGetGeometrySnapshot = Pointer<NativeGeometrySnapshot> Function(int contextId);
+
+final DartGetGeometrySnapshot _getGeometrySnapshot =
+    nativeDynamicLibrary.lookup<NativeFunction<NativeGetGeometrySnapshot>>('getGeometrySnapshot').asFunction();
+
+typedef NativeCommitGeometrySnapshot = Void Function(Int32 contextId);
+typedef DartCommitGeometrySnapshot = void Function(int contextId);
+
+final DartCommitGeometrySnapshot _commitGeometrySnapshot =
+    nativeDynamicLibrary.lookup<NativeFunction<NativeCommitGeometrySnapshot>>('commitGeometrySnapshot').asFunction();
+
+typedef NativeFlushCanvasDisplayLists = Void Function(Int32 contextId);
+typedef DartFlushCanvasDisplayLists = void Function(int contextId);
+
+final DartFlushCanvasDisplayLists _flushCanvasDisplayLists =
+    nativeDynamicLibrary.lookup<NativeFunction<NativeFlushCanvasDisplayLists>>('flushCanvasDisplayLists').asFunction();
+
+// Replay canvas draw operations recorded by js side since the last frame.
+void flushCanvasDisplayLists() {
+  Map<int, KrakenController?> controllerMap = KrakenController.getControllerMap();
+  for (KrakenController? controller in controllerMap.values) {
+    if (controller == null) continue;
+    _flushCanvasDisplayLists(controller.view.contextId);
+  }
+}
+
+typedef NativeSetCanvasRecordingEnabled = Void Function(Int32 enabled);
+typedef DartSetCanvasRecordingEnabled = void Function(int enabled);
+
+final DartSetCanvasRecordingEnabled _setCanvasRecordingEnabled =
+    nativeDynamicLibrary.lookup<NativeFunction<NativeSetCanvasRecordingEnabled>>('setCanvasRecordingEnabled').asFunction();
+
+// Disable to submit every canvas draw operation at once instead of once per frame.
+void setCanvasRecordingEnabled(bool enabled) {
+  _setCanvasRecordingEnabled(enabled ? 1 : 0);
+}
+
+typedef NativeGetGeometryLayoutEpoch = Pointer<Int64> Function();
+typedef DartGetGeometryLayoutEpoch = Pointer<Int64> Function();
+
+final DartGetGeometryLayoutEpoch _getGeometryLayoutEpoch =
+    nativeDynamicLibrary.lookup<NativeFunction<NativeGetGeometryLayoutEpoch>>('getGeometryLayoutEpoch').asFunction();
+
+final Pointer<Int64> _geometryLayoutEpoch = _getGeometryLayoutEpoch();
+
+// Should be called whenever the render tree is marked for layout, such as an image decoded or text typed into an
+// input. Geometry published to js side is out of date until the next publishGeometrySnapshot().
+void invalidateGeometrySnapshots() {
+  _geometryLayoutEpoch.value++;
+}
+
+// Keep in sync with GEOMETRY_ROW_SIZE in kraken_bridge.h.
+const int _geometryRowSize = 20;
+const int _geometryBoundingClientRectOffset = 12;
+
+// Write geometry of elements which js side had read from into the native snapshot, should be called right after
+// layout so js side can read geometry without calling back to dart.
+void publishGeometrySnapshot() {
+  Map<int, KrakenController?> controllerMap = KrakenController.getControllerMap();
+  for (KrakenController? controller in controllerMap.values) {
+    if (controller == null) continue;
+    int contextId = controller.view.contextId;
+    NativeGeometrySnapshot snapshot = _getGeometrySnapshot(contextId).ref;
+    int length = snapshot.length;
+    if (length == 0) continue;
+
+    Int32List targetIds = snapshot.targetIds.asTypedList(length);
+    Float64List rows = snapshot.rows.asTypedList(length * _geometryRowSize);
+    for (int i = 0; i < length; i++) {
+      int base = i * _geometryRowSize;
+      EventTarget? element = controller.view.getEventTargetById(targetIds[i]);
+      if (element is! Element) {
+        rows.fillRange(base, base + _geometryRowSize, 0);
+        continue;
+      }
+      for (ViewModuleProperty kind in ViewModuleProperty.values) {
+        rows[base + kind.index] = element.getViewModuleProperty(kind);
+      }
+      BoundingClientRect rect = element.boundingClientRect;
+      rows.setAll(base + _geometryBoundingClientRectOffset,
+          [rect.x, rect.y, rect.width, rect.height, rect.top, rect.right, rect.bottom, rect.left]);
+    }
+    _commitGeometrySnapshot(contextId);
+  }
+}
+
 class UICommand {
   late final UICommandType type;
   late final int id;
   late final List<String> args;
   late final Pointer nativePtr;
+  late final int int64Arg01;
+  late final int int64Arg02;
 
   @override
   String toString() {
-    return 'UICommand(type: $type, id: $id, args: $args, nativePtr: $nativePtr)';
+    return 'UICommand(type: $type, id: $id, args: $args, int64Args: [$int64Arg01, $int64Arg02], nativePtr: $nativePtr)';
   }
 }
 
@@ -323,16 +420,37 @@ class UICommand {
 //   const uint16_t *string_01;// offset: 2
 //   const uint16_t *string_02;// offset: 3
 //   void* nativePtr;          // offset: 4
+//   int64_t int64_01;         // offset: 5
+//   int64_t int64_02;         // offset: 6
 // };
-const int nativeCommandSize = 5;
+const int nativeCommandSize = 7;
 const int typeAndIdMemOffset = 0;
 const int args01And02LengthMemOffset = 1;
 const int args01StringMemOffset = 2;
 const int args02StringMemOffset = 3;
 const int nativePtrMemOffset = 4;
+const int int64Args01MemOffset = 5;
+const int int64Args02MemOffset = 6;
+
+// Keep the same order with AdjacentPosition enum in bridge.
+const List<String> _adjacentPositions = ['beforebegin', 'afterbegin', 'beforeend', 'afterend'];
 
 final bool isEnabledLog = kDebugMode && Platform.environment['ENABLE_KRAKEN_JS_LOG'] == 'true';
 
+// Tag names, style property names and event types are interned by bridge, commands carry the atom id
+// with a negative args length: -(atom + 1). Atoms are registered by registerAtom command before their first use.
+final Map<int, List<String>> _uiCommandAtoms = {};
+
+void _registerUICommandAtom(int contextId, int atom, String name) {
+  List<String> atoms = _uiCommandAtoms.putIfAbsent(contextId, () => []);
+  // Bridge will restart atom from 0 when js context recreated.
+  if (atom < atoms.length) {
+    atoms[atom] = name;
+  } else {
+    atoms.add(name);
+  }
+}
+
 // We found there are performance bottleneck of reading native memory with Dart FFI API.
 // So we align all UI instructions to a whole block of memory, and then convert them into a dart array at one time,
 // To ensure the fastest subsequent random access.
@@ -356,6 +474,8 @@ List<UICommand> readNativeUICommandToDart(Pointer<Uint64> nativeCommandItems, in
     command.id = id;
     int nativePtrValue = rawMemory[i + nativePtrMemOffset];
     command.nativePtr = nativePtrValue != 0 ? Pointer.fromAddress(rawMemory[i + nativePtrMemOffset]) : nullptr;
+    command.int64Arg01 = rawMemory[i + int64Args01MemOffset];
+    command.int64Arg02 = rawMemory[i + int64Args02MemOffset];
     command.args = List.empty(growable: true);
 
     int args01And02Length = rawMemory[i + args01And02LengthMemOffset];
@@ -366,14 +486,18 @@ List<UICommand> readNativeUICommandToDart(Pointer<Uint64> nativeCommandItems, in
       args01Length = args02Length = 0;
     } else {
       args02Length = args01And02Length >> 32;
-      args01Length = args01And02Length ^ (args02Length << 32);
+      args01Length = (args01And02Length & 0xffffffff).toSigned(32);
     }
 
     int args01StringMemory = rawMemory[i + args01StringMemOffset];
-    if (args01StringMemory != 0) {
+    if (args01Length < 0) {
+      command.args.add(_uiCommandAtoms[contextId]![-args01Length - 1]);
+    } else if (args01StringMemory != 0) {
       Pointer<Uint16> args_01 = Pointer.fromAddress(args01StringMemory);
       command.args.add(uint16ToString(args_01, args01Length));
+    }
 
+    if (command.args.isNotEmpty) {
       int args02StringMemory = rawMemory[i + args02StringMemOffset];
       if (args02StringMemory != 0) {
         Pointer<Uint16> args_02 = Pointer.fromAddress(args02StringMemory);
@@ -381,11 +505,16 @@ List<UICommand> readNativeUICommandToDart(Pointer<Uint64> nativeCommandItems, in
       }
     }
 
+    if (command.type == UICommandType.registerAtom) {
+      _registerUICommandAtom(contextId, command.id, command.args[0]);
+    }
+
     if (isEnabledLog) {
       String printMsg = '${command.type}, id: ${command.id}';
       for (int i = 0; i < command.args.length; i ++) {
         printMsg += ' args[$i]: ${command.args[i]}';
       }
+      printMsg += ' int64Args: [${command.int64Arg01}, ${command.int64Arg02}]';
       printMsg += ' nativePtr: ${command.nativePtr}';
       print(printMsg);
     }
@@ -402,98 +531,122 @@ void clearUICommand(int contextId) {
   _clearUICommandItems(contextId);
 }
 
-void flushUICommand() {
+void flushUICommand({ bool frame = false }) {
+  // Let native side count batches of this flush as frame flushes.
+  if (frame) _setUICommandFrameFlushing(1);
+  _flushControllersUICommand(frame);
+  if (frame) _setUICommandFrameFlushing(0);
+}
+
+void _flushControllersUICommand(bool frame) {
   Map<int, KrakenController?> controllerMap = KrakenController.getControllerMap();
   for (KrakenController? controller in controllerMap.values) {
     if (controller == null) continue;
-    Pointer<Uint64> nativeCommandItems = _getUICommandItems(controller.view.contextId);
-    int commandLength = _getUICommandItemSize(controller.view.contextId);
+    // With a flush policy, native side hands over commands in slices. A frame flush applies one slice and leave
+    // the rest to the next frames, while a sync flush (such as reading layout) must apply all pending commands.
+    while (_flushControllerUICommand(controller) && !frame) {}
+  }
+}
 
-    if (commandLength == 0) {
-      continue;
-    }
+// Sync flush of a single context, used by layout reads of js side.
+void flushContextUICommand(int contextId) {
+  KrakenController? controller = KrakenController.getControllerOfJSContextId(contextId);
+  if (controller == null) return;
+  while (_flushControllerUICommand(controller)) {}
+}
 
-    if (kProfileMode) {
-      PerformanceTiming.instance().mark(PERF_FLUSH_UI_COMMAND_START);
-    }
+// Returns false if there are no pending commands.
+bool _flushControllerUICommand(KrakenController controller) {
+  Pointer<Uint64> nativeCommandItems = _getUICommandItems(controller.view.contextId);
+  int commandLength = _getUICommandItemSize(controller.view.contextId);
 
-    List<UICommand> commands = readNativeUICommandToDart(nativeCommandItems, commandLength, controller.view.contextId);
+  if (commandLength == 0) {
+    return false;
+  }
 
-    SchedulerBinding.instance!.scheduleFrame();
+  if (kProfileMode) {
+    PerformanceTiming.instance().mark(PERF_FLUSH_UI_COMMAND_START);
+  }
 
-    if (kProfileMode) {
-      PerformanceTiming.instance().mark(PERF_FLUSH_UI_COMMAND_END);
-    }
+  List<UICommand> commands = readNativeUICommandToDart(nativeCommandItems, commandLength, controller.view.contextId);
 
-    List<List<String>> _renderStyleCommands = [];
-
-    // For new ui commands, we needs to tell engine to update frames.
-    for (int i = 0; i < commandLength; i++) {
-      UICommand command = commands[i];
-      UICommandType commandType = command.type;
-      int id = command.id;
-      Pointer nativePtr = command.nativePtr;
-
-      try {
-        switch (commandType) {
-          case UICommandType.createElement:
-            controller.view.createElement(id, nativePtr, command.args[0]);
-            break;
-          case UICommandType.createTextNode:
-            controller.view.createTextNode(id, nativePtr.cast<NativeTextNode>(), command.args[0]);
-            break;
-          case UICommandType.createComment:
-            controller.view.createComment(id, nativePtr.cast<NativeCommentNode>(), command.args[0]);
-            break;
-          case UICommandType.disposeEventTarget:
-            ElementManager.disposeEventTarget(controller.view.contextId, id);
-            break;
-          case UICommandType.addEvent:
-            controller.view.addEvent(id, command.args[0]);
-            break;
-          case UICommandType.removeEvent:
-            controller.view.removeEvent(id, command.args[0]);
-            break;
-          case UICommandType.insertAdjacentNode:
-            int childId = int.parse(command.args[0]);
-            String position = command.args[1];
-            controller.view.insertAdjacentNode(id, position, childId);
-            break;
-          case UICommandType.removeNode:
-            controller.view.removeNode(id);
-            break;
-          case UICommandType.cloneNode:
-            int newId = int.parse(command.args[0]);
-            controller.view.cloneNode(id, newId);
-            break;
-          case UICommandType.setStyle:
-            String key = command.args[0];
-            String value = command.args[1];
-            controller.view.setStyle(id, key, value);
-            _renderStyleCommands.add([id.toString(), key, value]);
-            break;
-          case UICommandType.setProperty:
-            String key = command.args[0];
-            String value = command.args[1];
-            controller.view.setProperty(id, key, value);
-            break;
-          case UICommandType.removeProperty:
-            String key = command.args[0];
-            controller.view.removeProperty(id, key);
-            break;
-          default:
-            break;
-        }
-      } catch (e, stack) {
-        print('$e\n$stack');
-      }
-    }
+  SchedulerBinding.instance!.scheduleFrame();
+
+  if (kProfileMode) {
+    PerformanceTiming.instance().mark(PERF_FLUSH_UI_COMMAND_END);
+  }
 
-    for (int i = 0; i < _renderStyleCommands.length; i ++) {
-      var pair = _renderStyleCommands[i];
-      controller.view.setRenderStyle(int.parse(pair[0]), pair[1], pair[2]);
+  List<List<String>> _renderStyleCommands = [];
+
+  // For new ui commands, we needs to tell engine to update frames.
+  for (int i = 0; i < commandLength; i++) {
+    UICommand command = commands[i];
+    UICommandType commandType = command.type;
+    int id = command.id;
+    Pointer nativePtr = command.nativePtr;
+
+    try {
+      switch (commandType) {
+        case UICommandType.createElement:
+          controller.view.createElement(id, nativePtr, command.args[0]);
+          break;
+        case UICommandType.createTextNode:
+          controller.view.createTextNode(id, nativePtr.cast<NativeTextNode>(), command.args[0]);
+          break;
+        case UICommandType.createComment:
+          controller.view.createComment(id, nativePtr.cast<NativeCommentNode>(), command.args[0]);
+          break;
+        case UICommandType.disposeEventTarget:
+          ElementManager.disposeEventTarget(controller.view.contextId, id);
+          break;
+        case UICommandType.addEvent:
+          // Bridge sends "passive" as the second argument when every listener of the type is passive.
+          bool passive = command.args.length > 1 && command.args[1] == 'passive';
+          controller.view.addEvent(id, command.args[0], passive: passive);
+          break;
+        case UICommandType.removeEvent:
+          controller.view.removeEvent(id, command.args[0]);
+          break;
+        case UICommandType.insertAdjacentNode:
+          int childId = command.int64Arg01;
+          String position = _adjacentPositions[command.int64Arg02];
+          controller.view.insertAdjacentNode(id, position, childId);
+          break;
+        case UICommandType.removeNode:
+          controller.view.removeNode(id);
+          break;
+        case UICommandType.cloneNode:
+          int newId = command.int64Arg01;
+          controller.view.cloneNode(id, newId);
+          break;
+        case UICommandType.setStyle:
+          String key = command.args[0];
+          String value = command.args[1];
+          controller.view.setStyle(id, key, value);
+          _renderStyleCommands.add([id.toString(), key, value]);
+          break;
+        case UICommandType.setProperty:
+          String key = command.args[0];
+          String value = command.args[1];
+          controller.view.setProperty(id, key, value);
+          break;
+        case UICommandType.removeProperty:
+          String key = command.args[0];
+          controller.view.removeProperty(id, key);
+          break;
+        default:
+          break;
+      }
+    } catch (e, stack) {
+      print('$e\n$stack');
     }
+  }
 
-    _renderStyleCommands.clear();
+  for (int i = 0; i < _renderStyleCommands.length; i ++) {
+    var pair = _renderStyleCommands[i];
+    controller.view.setRenderStyle(int.parse(pair[0]), pair[1], pair[2]);
   }
+
+  _renderStyleCommands.clear();
+  return true;
 }
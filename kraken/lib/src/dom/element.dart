@@ -340,10 +340,12 @@ class Element extends Node
 
   // TODO: debounce scroll listener
   void _scrollListener(double scrollOffset, AxisDirection axisDirection) {
+    // Scroll offsets and client rects read by js change without any layout, whether js listens scroll or not.
+    invalidateGeometrySnapshots();
     applyStickyChildrenOffset();
     paintFixedChildren(scrollOffset, axisDirection);
 
-    if (eventHandlers.containsKey(EVENT_SCROLL)) {
+    if (hasListenerOnPath(EVENT_SCROLL)) {
       _fireScrollEvent();
     }
   }
@@ -1388,6 +1390,7 @@ class Element extends Node
   }
 
   void eventResponder(Event event) {
+    if (!hasListenerOnPath(event.type)) return;
     emitUIEvent(elementManager.controller.view.contextId, nativeElementPtr.ref.nativeNode.ref.nativeEventTarget, event);
   }
 
@@ -315,11 +315,12 @@ class ElementManager implements WidgetsBindingObserver, ElementsBindingObserver
     _debugDOMTreeChanged();
   }
 
-  void addEvent(int targetId, String eventType) {
+  void addEvent(int targetId, String eventType, { bool passive = false }) {
     assert(existsTarget(targetId), 'targetId: $targetId event: $eventType');
     EventTarget target = getEventTargetByTargetId<EventTarget>(targetId)!;
 
     target.addEvent(eventType);
+    target.setListenerPassive(eventType, passive);
   }
 
   void removeEvent(int targetId, String eventType) {
@@ -328,6 +329,7 @@ class ElementManager implements WidgetsBindingObserver, ElementsBindingObserver
     Element target = getEventTargetByTargetId<Element>(targetId)!;
 
     target.removeEvent(eventType);
+    target.setListenerPassive(eventType, true);
   }
 
   RenderBox getRootRenderBox() {
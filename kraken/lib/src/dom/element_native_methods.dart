@@ -44,13 +44,17 @@ mixin ElementNativeMethods on Node {
       PerformanceTiming.instance().mark(PERF_DOM_FORCE_LAYOUT_END);
     }
 
+    return element.getViewModuleProperty(ViewModuleProperty.values[property]);
+  }
+
+  double getViewModuleProperty(ViewModuleProperty kind) {
+    Element element = this as Element;
     RenderBoxModel? elementRenderBoxModel = element.renderBoxModel;
 
     if (elementRenderBoxModel == null) {
       return 0.0;
     }
 
-    ViewModuleProperty kind = ViewModuleProperty.values[property];
     switch(kind) {
       case ViewModuleProperty.offsetTop:
         return element.getOffsetY();
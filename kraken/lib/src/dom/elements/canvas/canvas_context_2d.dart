@@ -2,6 +2,7 @@
  * Copyright (C) 2019-present Alibaba Inc. All rights reserved.
  * Author: Kraken Team.
  */
+import 'dart:async';
 import 'dart:core';
 import 'dart:typed_data';
 import 'dart:ui';
@@ -17,45 +18,94 @@ import 'package:vector_math/vector_math_64.dart';
 import 'canvas_context.dart';
 import 'canvas_path_2d.dart';
 
-final Pointer<NativeFunction<NativeRenderingContextSetProperty>> nativeSetDirection = Pointer.fromFunction(CanvasRenderingContext2D._setDirection);
-final Pointer<NativeFunction<NativeRenderingContextSetProperty>> nativeSetFont = Pointer.fromFunction(CanvasRenderingContext2D._setFont);
-final Pointer<NativeFunction<NativeRenderingContextSetProperty>> nativeSetFillStyle = Pointer.fromFunction(CanvasRenderingContext2D._setFillStyle);
-final Pointer<NativeFunction<NativeRenderingContextSetProperty>> nativeSetStrokeStyle = Pointer.fromFunction(CanvasRenderingContext2D._setStrokeStyle);
-final Pointer<NativeFunction<NativeRenderingContextSetProperty>> nativeSetLineCap = Pointer.fromFunction(CanvasRenderingContext2D._setLineCap);
-final Pointer<NativeFunction<NativeRenderingContextSetProperty>> nativeSetLineDashOffset = Pointer.fromFunction(CanvasRenderingContext2D._setLineDashOffset);
-final Pointer<NativeFunction<NativeRenderingContextSetProperty>> nativeSetLineJoin = Pointer.fromFunction(CanvasRenderingContext2D._setLineJoin);
-final Pointer<NativeFunction<NativeRenderingContextSetProperty>> nativeSetLineWidth = Pointer.fromFunction(CanvasRenderingContext2D._setLineWidth);
-final Pointer<NativeFunction<NativeRenderingContextSetProperty>> nativeSetMiterLimit = Pointer.fromFunction(CanvasRenderingContext2D._setMiterLimit);
-final Pointer<NativeFunction<NativeRenderingContextSetProperty>> nativeSetTextAlign = Pointer.fromFunction(CanvasRenderingContext2D._setTextAlign);
-final Pointer<NativeFunction<NativeRenderingContextSetProperty>> nativeSetTextBaseline = Pointer.fromFunction(CanvasRenderingContext2D._setTextBaseline);
-
-final Pointer<NativeFunction<NativeRenderingContextArc>> nativeArc= Pointer.fromFunction(CanvasRenderingContext2D._arc);
-final Pointer<NativeFunction<NativeRenderingContextArcTo>> nativeArcTo = Pointer.fromFunction(CanvasRenderingContext2D._arcTo);
-final Pointer<NativeFunction<NativeRenderingContextFillRect>> nativeFillRect = Pointer.fromFunction(CanvasRenderingContext2D._fillRect);
-final Pointer<NativeFunction<NativeRenderingContextBeginPath>> nativeBeginPath = Pointer.fromFunction(CanvasRenderingContext2D._beginPath);
-final Pointer<NativeFunction<NativeRenderingContextBezierCurveTo>> nativeBezierCurveTo = Pointer.fromFunction(CanvasRenderingContext2D._bezierCurveTo);
-final Pointer<NativeFunction<NativeRenderingContextClip>> nativeClip = Pointer.fromFunction(CanvasRenderingContext2D._clip);
-final Pointer<NativeFunction<NativeRenderingContextClearRect>> nativeClearRect = Pointer.fromFunction(CanvasRenderingContext2D._clearRect);
-final Pointer<NativeFunction<NativeRenderingContextClosePath>> nativeClosePath = Pointer.fromFunction(CanvasRenderingContext2D._closePath);
-final Pointer<NativeFunction<NativeRenderingContextDrawImage>> nativeDrawImage = Pointer.fromFunction(CanvasRenderingContext2D._drawImage);
-final Pointer<NativeFunction<NativeRenderingContextEllipse>> nativeEllipse = Pointer.fromFunction(CanvasRenderingContext2D._ellipse);
-final Pointer<NativeFunction<NativeRenderingContextFill>> nativeFill = Pointer.fromFunction(CanvasRenderingContext2D._fill);
-final Pointer<NativeFunction<NativeRenderingContextFillText>> nativeFillText = Pointer.fromFunction(CanvasRenderingContext2D._fillText);
-final Pointer<NativeFunction<NativeRenderingContextLineTo>> nativeLineTo = Pointer.fromFunction(CanvasRenderingContext2D._lineTo);
-final Pointer<NativeFunction<NativeRenderingContextMoveTo>> nativeMoveTo = Pointer.fromFunction(CanvasRenderingContext2D._moveTo);
-final Pointer<NativeFunction<NativeRenderingContextQuadraticCurveTo>> nativeQuadraticCurveTo = Pointer.fromFunction(CanvasRenderingContext2D._quadraticCurveTo);
-final Pointer<NativeFunction<NativeRenderingContextRect>> nativeRect = Pointer.fromFunction(CanvasRenderingContext2D._rect);
-final Pointer<NativeFunction<NativeRenderingContextRestore>> nativeRestore = Pointer.fromFunction(CanvasRenderingContext2D._restore);
-final Pointer<NativeFunction<NativeRenderingContextRotate>> nativeRotate = Pointer.fromFunction(CanvasRenderingContext2D._rotate);
-final Pointer<NativeFunction<NativeRenderingContextResetTransform>> nativeResetTransform = Pointer.fromFunction(CanvasRenderingContext2D._resetTransform);
-final Pointer<NativeFunction<NativeRenderingContextSave>> nativeSave = Pointer.fromFunction(CanvasRenderingContext2D._save);
-final Pointer<NativeFunction<NativeRenderingContextScale>> nativeScale = Pointer.fromFunction(CanvasRenderingContext2D._scale);
-final Pointer<NativeFunction<NativeRenderingContextStroke>> nativeStroke = Pointer.fromFunction(CanvasRenderingContext2D._stroke);
-final Pointer<NativeFunction<NativeRenderingContextStrokeText>> nativeStrokeText = Pointer.fromFunction(CanvasRenderingContext2D._strokeText);
-final Pointer<NativeFunction<NativeRenderingContextStrokeRect>> nativeStrokeRect = Pointer.fromFunction(CanvasRenderingContext2D._strokeRect);
-final Pointer<NativeFunction<NativeRenderingContextSetTransform>> nativeSetTransform = Pointer.fromFunction(CanvasRenderingContext2D._setTransform);
-final Pointer<NativeFunction<NativeRenderingContextTransform>> nativeTransform = Pointer.fromFunction(CanvasRenderingContext2D._transform);
-final Pointer<NativeFunction<NativeRenderingContextTranslate>> nativeTranslate = Pointer.fromFunction(CanvasRenderingContext2D._translate);
+final Pointer<NativeFunction<NativeRenderingContextSubmitDisplayList>> nativeSubmitDisplayList = Pointer.fromFunction(CanvasRenderingContext2D._submitDisplayList);
+final Pointer<NativeFunction<NativeRenderingContextGetImageData>> nativeGetImageData = Pointer.fromFunction(CanvasRenderingContext2D._getImageData);
+final Pointer<NativeFunction<NativeRenderingContextPutImageData>> nativePutImageData = Pointer.fromFunction(CanvasRenderingContext2D._putImageData);
+
+// The order must be as same as the CanvasDisplayListOp of native side.
+enum CanvasDisplayListOp {
+  setDirection,
+  setFont,
+  setFillStyle,
+  setStrokeStyle,
+  setLineCap,
+  setLineDashOffset,
+  setLineJoin,
+  setLineWidth,
+  setMiterLimit,
+  setTextAlign,
+  setTextBaseline,
+  arc,
+  arcTo,
+  beginPath,
+  bezierCurveTo,
+  clearRect,
+  clip,
+  closePath,
+  drawImage,
+  ellipse,
+  fill,
+  fillRect,
+  fillText,
+  lineTo,
+  moveTo,
+  quadraticCurveTo,
+  rect,
+  restore,
+  rotate,
+  resetTransform,
+  save,
+  scale,
+  stroke,
+  strokeRect,
+  strokeText,
+  setTransform,
+  transform,
+  translate,
+  pathSegments,
+}
+
+// The order must be as same as the CanvasPathVerb of native side.
+enum CanvasPathVerb {
+  moveTo,
+  lineTo,
+  quadraticCurveTo,
+  bezierCurveTo,
+  closePath,
+}
+
+// Argument count of each CanvasDisplayListOp.
+const List<int> _displayListArgumentCount = [
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // setDirection ... setTextBaseline
+  6, // arc
+  5, // arcTo
+  0, // beginPath
+  6, // bezierCurveTo
+  4, // clearRect
+  1, // clip
+  0, // closePath
+  10, // drawImage
+  8, // ellipse
+  1, // fill
+  4, // fillRect
+  4, // fillText
+  2, // lineTo
+  2, // moveTo
+  4, // quadraticCurveTo
+  4, // rect
+  0, // restore
+  1, // rotate
+  0, // resetTransform
+  0, // save
+  2, // scale
+  0, // stroke
+  4, // strokeRect
+  4, // strokeText
+  6, // setTransform
+  6, // transform
+  2, // translate
+  2, // pathSegments
+];
 
 const String _DEFAULT_FONT = '10px sans-serif';
 const String START = 'start';
@@ -90,45 +140,9 @@ class CanvasRenderingContext2D {
 
     _nativeMap[nativeCanvasRenderingContext2D.address] = this;
 
-    nativeCanvasRenderingContext2D.ref.setDirection = nativeSetDirection;
-    nativeCanvasRenderingContext2D.ref.setFont = nativeSetFont;
-    nativeCanvasRenderingContext2D.ref.setFillStyle = nativeSetFillStyle;
-    nativeCanvasRenderingContext2D.ref.setStrokeStyle = nativeSetStrokeStyle;
-    nativeCanvasRenderingContext2D.ref.setLineCap = nativeSetLineCap;
-    nativeCanvasRenderingContext2D.ref.setLineDashOffset = nativeSetLineDashOffset;
-    nativeCanvasRenderingContext2D.ref.setLineJoin = nativeSetLineJoin;
-    nativeCanvasRenderingContext2D.ref.setLineWidth = nativeSetLineWidth;
-    nativeCanvasRenderingContext2D.ref.setMiterLimit = nativeSetMiterLimit;
-    nativeCanvasRenderingContext2D.ref.setTextAlign = nativeSetTextAlign;
-    nativeCanvasRenderingContext2D.ref.setTextBaseline = nativeSetTextBaseline;
-
-    nativeCanvasRenderingContext2D.ref.arc = nativeArc;
-    nativeCanvasRenderingContext2D.ref.arcTo = nativeArcTo;
-    nativeCanvasRenderingContext2D.ref.beginPath = nativeBeginPath;
-    nativeCanvasRenderingContext2D.ref.bezierCurveTo = nativeBezierCurveTo;
-    nativeCanvasRenderingContext2D.ref.clearRect = nativeClearRect;
-    nativeCanvasRenderingContext2D.ref.clip = nativeClip;
-    nativeCanvasRenderingContext2D.ref.closePath = nativeClosePath;
-    nativeCanvasRenderingContext2D.ref.drawImage = nativeDrawImage;
-    nativeCanvasRenderingContext2D.ref.ellipse = nativeEllipse;
-    nativeCanvasRenderingContext2D.ref.fill = nativeFill;
-    nativeCanvasRenderingContext2D.ref.fillRect = nativeFillRect;
-    nativeCanvasRenderingContext2D.ref.fillText = nativeFillText;
-    nativeCanvasRenderingContext2D.ref.lineTo = nativeLineTo;
-    nativeCanvasRenderingContext2D.ref.moveTo = nativeMoveTo;
-    nativeCanvasRenderingContext2D.ref.quadraticCurveTo = nativeQuadraticCurveTo;
-    nativeCanvasRenderingContext2D.ref.rect = nativeRect;
-    nativeCanvasRenderingContext2D.ref.rotate = nativeRotate;
-    nativeCanvasRenderingContext2D.ref.restore = nativeRestore;
-    nativeCanvasRenderingContext2D.ref.resetTransform = nativeResetTransform;
-    nativeCanvasRenderingContext2D.ref.scale = nativeScale;
-    nativeCanvasRenderingContext2D.ref.stroke = nativeStroke;
-    nativeCanvasRenderingContext2D.ref.strokeText = nativeStrokeText;
-    nativeCanvasRenderingContext2D.ref.strokeRect = nativeStrokeRect;
-    nativeCanvasRenderingContext2D.ref.save = nativeSave;
-    nativeCanvasRenderingContext2D.ref.setTransform = nativeSetTransform;
-    nativeCanvasRenderingContext2D.ref.transform = nativeTransform;
-    nativeCanvasRenderingContext2D.ref.translate = nativeTranslate;
+    nativeCanvasRenderingContext2D.ref.submitDisplayList = nativeSubmitDisplayList;
+    nativeCanvasRenderingContext2D.ref.getImageData = nativeGetImageData;
+    nativeCanvasRenderingContext2D.ref.putImageData = nativePutImageData;
   }
 
   static final SplayTreeMap<int, CanvasRenderingContext2D> _nativeMap = SplayTreeMap();
@@ -143,220 +157,208 @@ class CanvasRenderingContext2D {
     _nativeMap.remove(nativeCanvasRenderingContext2D.address);
   }
 
-  static void _setDirection(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> value) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.direction = parseDirection(nativeStringToString(value));
-  }
-
-  static void _setFont(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> value) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.font = nativeStringToString(value);
-  }
-
-  static void _setFillStyle(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> value) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    Color? color = CSSColor.parseColor(nativeStringToString(value));
-    if (color != null) canvasRenderingContext2D.fillStyle = color;
-  }
-
-  static void _setStrokeStyle(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> value) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    Color? color = CSSColor.parseColor(nativeStringToString(value));
-    if (color != null) canvasRenderingContext2D.strokeStyle = color;
-  }
-
-  static void _setLineCap(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> value) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.lineCap = parseLineCap(nativeStringToString(value));
-  }
-
-  static void _setLineDashOffset(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> value) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    double? _v = double.tryParse(nativeStringToString(value));
-    if (_v != null) canvasRenderingContext2D.lineDashOffset = _v;
-  }
-
-  static void _setLineJoin(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> value) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.lineJoin = parseLineJoin(nativeStringToString(value));
-  }
-
-  static void _setLineWidth(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> value) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    double? _v = double.tryParse(nativeStringToString(value));
-    if (_v != null) canvasRenderingContext2D.lineWidth = _v;
-  }
-
-  static void _setMiterLimit(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> value) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    double? _v = double.tryParse(nativeStringToString(value));
-    if (_v != null) canvasRenderingContext2D.miterLimit = _v;
-  }
-
-  static void _setTextAlign(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> value) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.textAlign = parseTextAlign(nativeStringToString(value));
-  }
-
-  static void _setTextBaseline(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> value) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.textBaseline = parseTextBaseline(nativeStringToString(value));
-  }
-
-  static void _arc(Pointer<NativeCanvasRenderingContext2D> nativePtr, double x, double y, double radius, double startAngle, double endAngle, double counterclockwise) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.arc(x, y, radius, startAngle, endAngle, anticlockwise : counterclockwise == 1 ? true : false);
-  }
-
-  static void _arcTo(Pointer<NativeCanvasRenderingContext2D> nativePtr, double x1, double y1, double x2, double y2, double radius) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.arcTo(x1, y1, x2, y2, radius);
-  }
-
-  static void _fillRect(Pointer<NativeCanvasRenderingContext2D> nativePtr, double x, double y, double width, double height) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.fillRect(x, y, width, height);
-  }
-
-  static void _clearRect(Pointer<NativeCanvasRenderingContext2D> nativePtr, double x, double y, double width, double height) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.clearRect(x, y, width, height);
-  }
-
-  static void _strokeRect(Pointer<NativeCanvasRenderingContext2D> nativePtr, double x, double y, double width, double height) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.strokeRect(x, y, width, height);
-  }
-
-  static void _fillText(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> text, double x, double y, double maxWidth) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    if (!maxWidth.isNaN) {
-      canvasRenderingContext2D.fillText(nativeStringToString(text), x, y, maxWidth: maxWidth);
-    } else {
-      canvasRenderingContext2D.fillText(nativeStringToString(text), x, y);
+  static void _submitDisplayList(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeCanvasDisplayList> displayListPtr) {
+    // Display list of a released js context may arrive after the canvas disposed.
+    CanvasRenderingContext2D? canvasRenderingContext2D = _nativeMap[nativePtr.address];
+    if (canvasRenderingContext2D == null) return;
+    NativeCanvasDisplayList displayList = displayListPtr.ref;
+    Float64List ops = displayList.ops.asTypedList(displayList.length);
+    // The image of drawImage is recorded as the raw bits of its pointer.
+    Int64List bits = displayList.ops.cast<Int64>().asTypedList(displayList.length);
+    Float32List floats = displayList.floats.asTypedList(displayList.floatsLength);
+    canvasRenderingContext2D._replayDisplayList(ops, bits, displayList.strings, floats);
+  }
+
+  // Native side checks the rect is finite and small enough to be rounded and allocated.
+  static void _getImageData(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<Void> callbackContext, int contextId,
+      Pointer<NativeFunction<NativeImageDataCallback>> callback, double sx, double sy, double sw, double sh) {
+    DartImageDataCallback func = callback.asFunction();
+    CanvasRenderingContext2D? canvasRenderingContext2D = _nativeMap[nativePtr.address];
+    if (canvasRenderingContext2D == null) {
+      func(callbackContext, contextId, 'The canvas is disposed.'.toNativeUtf8(), nullptr);
+      return;
     }
+    canvasRenderingContext2D.canvas.painter.getImageData(sx.floor(), sy.floor(), sw.ceil(), sh.ceil()).then((Pointer<NativeImageData> imageData) {
+      func(callbackContext, contextId, nullptr, imageData);
+    }).catchError((error, stack) {
+      func(callbackContext, contextId, ('$error\n$stack').toNativeUtf8(), nullptr);
+    });
   }
 
-  static void _strokeText(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> text,
-                          double x, double y, double maxWidth) {
+  static void _putImageData(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<Uint8> data, int width, int height, double dx, double dy) {
     CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    if (!maxWidth.isNaN) {
-      canvasRenderingContext2D.strokeText(nativeStringToString(text), x, y, maxWidth: maxWidth);
-    } else {
-      canvasRenderingContext2D.strokeText(nativeStringToString(text), x, y);
+    // Pixels of js side are only valid during this call.
+    Uint8List pixels = Uint8List.fromList(data.asTypedList(width * height * 4));
+    canvasRenderingContext2D.putImageData(pixels, width, height, dx, dy);
+  }
+
+  bool _replaying = false;
+
+  void _replayDisplayList(Float64List ops, Int64List bits, Pointer<NativeString> strings, Float32List floats) {
+    String string(int index) => nativeStringToString(strings.elementAt(ops[index].toInt()));
+    PathFillType fillType(int index) => string(index) == EVENODD ? PathFillType.evenOdd : PathFillType.nonZero;
+
+    _replaying = true;
+    int i = 0;
+    while (i < ops.length) {
+      int op = ops[i].toInt();
+      int a = i + 1;
+      switch (CanvasDisplayListOp.values[op]) {
+        case CanvasDisplayListOp.setDirection:
+          direction = parseDirection(string(a));
+          break;
+        case CanvasDisplayListOp.setFont:
+          font = string(a);
+          break;
+        case CanvasDisplayListOp.setFillStyle: {
+          Color? color = CSSColor.parseColor(string(a));
+          if (color != null) fillStyle = color;
+          break;
+        }
+        case CanvasDisplayListOp.setStrokeStyle: {
+          Color? color = CSSColor.parseColor(string(a));
+          if (color != null) strokeStyle = color;
+          break;
+        }
+        case CanvasDisplayListOp.setLineCap:
+          lineCap = parseLineCap(string(a));
+          break;
+        case CanvasDisplayListOp.setLineDashOffset: {
+          double? _v = double.tryParse(string(a));
+          if (_v != null) lineDashOffset = _v;
+          break;
+        }
+        case CanvasDisplayListOp.setLineJoin:
+          lineJoin = parseLineJoin(string(a));
+          break;
+        case CanvasDisplayListOp.setLineWidth: {
+          double? _v = double.tryParse(string(a));
+          if (_v != null) lineWidth = _v;
+          break;
+        }
+        case CanvasDisplayListOp.setMiterLimit: {
+          double? _v = double.tryParse(string(a));
+          if (_v != null) miterLimit = _v;
+          break;
+        }
+        case CanvasDisplayListOp.setTextAlign:
+          textAlign = parseTextAlign(string(a));
+          break;
+        case CanvasDisplayListOp.setTextBaseline:
+          textBaseline = parseTextBaseline(string(a));
+          break;
+        case CanvasDisplayListOp.arc:
+          arc(ops[a], ops[a + 1], ops[a + 2], ops[a + 3], ops[a + 4], anticlockwise: ops[a + 5] == 1);
+          break;
+        case CanvasDisplayListOp.arcTo:
+          arcTo(ops[a], ops[a + 1], ops[a + 2], ops[a + 3], ops[a + 4]);
+          break;
+        case CanvasDisplayListOp.beginPath:
+          beginPath();
+          break;
+        case CanvasDisplayListOp.bezierCurveTo:
+          bezierCurveTo(ops[a], ops[a + 1], ops[a + 2], ops[a + 3], ops[a + 4], ops[a + 5]);
+          break;
+        case CanvasDisplayListOp.clearRect:
+          clearRect(ops[a], ops[a + 1], ops[a + 2], ops[a + 3]);
+          break;
+        case CanvasDisplayListOp.clip:
+          clip(fillType(a));
+          break;
+        case CanvasDisplayListOp.closePath:
+          closePath();
+          break;
+        // https://developer.mozilla.org/en-US/docs/Web/API/CanvasRenderingContext2D/drawImage
+        case CanvasDisplayListOp.drawImage: {
+          ImageElement imageElement = ImageElement.getImageElementOfNativePtr(Pointer.fromAddress(bits[a + 1]));
+          drawImage(ops[a].toInt(), imageElement.image, ops[a + 2], ops[a + 3], ops[a + 4], ops[a + 5], ops[a + 6],
+              ops[a + 7], ops[a + 8], ops[a + 9]);
+          break;
+        }
+        case CanvasDisplayListOp.ellipse:
+          ellipse(ops[a], ops[a + 1], ops[a + 2], ops[a + 3], ops[a + 4], ops[a + 5], ops[a + 6], anticlockwise: ops[a + 7] == 1);
+          break;
+        case CanvasDisplayListOp.fill:
+          fill(fillType(a));
+          break;
+        case CanvasDisplayListOp.fillRect:
+          fillRect(ops[a], ops[a + 1], ops[a + 2], ops[a + 3]);
+          break;
+        case CanvasDisplayListOp.fillText: {
+          double maxWidth = ops[a + 3];
+          if (!maxWidth.isNaN) {
+            fillText(string(a), ops[a + 1], ops[a + 2], maxWidth: maxWidth);
+          } else {
+            fillText(string(a), ops[a + 1], ops[a + 2]);
+          }
+          break;
+        }
+        case CanvasDisplayListOp.lineTo:
+          lineTo(ops[a], ops[a + 1]);
+          break;
+        case CanvasDisplayListOp.moveTo:
+          moveTo(ops[a], ops[a + 1]);
+          break;
+        case CanvasDisplayListOp.quadraticCurveTo:
+          quadraticCurveTo(ops[a], ops[a + 1], ops[a + 2], ops[a + 3]);
+          break;
+        case CanvasDisplayListOp.rect:
+          rect(ops[a], ops[a + 1], ops[a + 2], ops[a + 3]);
+          break;
+        case CanvasDisplayListOp.restore:
+          restore();
+          break;
+        case CanvasDisplayListOp.rotate:
+          rotate(ops[a]);
+          break;
+        case CanvasDisplayListOp.resetTransform:
+          resetTransform();
+          break;
+        case CanvasDisplayListOp.save:
+          save();
+          break;
+        case CanvasDisplayListOp.scale:
+          scale(ops[a], ops[a + 1]);
+          break;
+        case CanvasDisplayListOp.stroke:
+          stroke();
+          break;
+        case CanvasDisplayListOp.strokeRect:
+          strokeRect(ops[a], ops[a + 1], ops[a + 2], ops[a + 3]);
+          break;
+        case CanvasDisplayListOp.strokeText: {
+          double maxWidth = ops[a + 3];
+          if (!maxWidth.isNaN) {
+            strokeText(string(a), ops[a + 1], ops[a + 2], maxWidth: maxWidth);
+          } else {
+            strokeText(string(a), ops[a + 1], ops[a + 2]);
+          }
+          break;
+        }
+        case CanvasDisplayListOp.setTransform:
+          setTransform(ops[a], ops[a + 1], ops[a + 2], ops[a + 3], ops[a + 4], ops[a + 5]);
+          break;
+        case CanvasDisplayListOp.transform:
+          transform(ops[a], ops[a + 1], ops[a + 2], ops[a + 3], ops[a + 4], ops[a + 5]);
+          break;
+        case CanvasDisplayListOp.translate:
+          translate(ops[a], ops[a + 1]);
+          break;
+        case CanvasDisplayListOp.pathSegments: {
+          int offset = ops[a].toInt();
+          // Floats of native side are only valid during this call.
+          appendPathSegments(floats.sublist(offset, offset + ops[a + 1].toInt()));
+          break;
+        }
+      }
+      i = a + _displayListArgumentCount[op];
     }
-  }
-
-  static void _save(Pointer<NativeCanvasRenderingContext2D> nativePtr) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.save();
-  }
-
-  static void _restore(Pointer<NativeCanvasRenderingContext2D> nativePtr) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.restore();
-  }
+    _replaying = false;
 
-  static void _beginPath(Pointer<NativeCanvasRenderingContext2D> nativePtr) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.beginPath();
-  }
-
-  static void _bezierCurveTo(Pointer<NativeCanvasRenderingContext2D> nativePtr, double x1, double y1,
-                            double x2, double y2, double x, double y) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.bezierCurveTo(x1, y1, x2, y2, x, y);
-  }
-
-  static void _clip(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> fillRule) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-
-    PathFillType fillType = nativeStringToString(fillRule) == EVENODD ? PathFillType.evenOdd : PathFillType.nonZero;
-    canvasRenderingContext2D.clip(fillType);
-  }
-
-  static void _closePath(Pointer<NativeCanvasRenderingContext2D> nativePtr) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.closePath();
-  }
-
-  // https://developer.mozilla.org/en-US/docs/Web/API/CanvasRenderingContext2D/drawImage
-  static void _drawImage(Pointer<NativeCanvasRenderingContext2D> nativePtr, int argumentCount, Pointer<NativeImgElement> imagePtr,
-      double sx, double sy, double sWidth, double sHeight, double dx, double dy, double dWidth, double dHeight) {
-    ImageElement imageElement = ImageElement.getImageElementOfNativePtr(imagePtr);
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.drawImage(argumentCount, imageElement.image, sx, sy, sWidth, sHeight, dx, dy, dWidth, dHeight);
-  }
-
-  static void _ellipse(Pointer<NativeCanvasRenderingContext2D> nativePtr, double x, double y,
-                      double radiusX, double radiusY, double rotation, double startAngle, double endAngle,
-                      double counterclockwise) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.ellipse(x, y, radiusX, radiusY, rotation, startAngle, endAngle, anticlockwise : counterclockwise == 1 ? true : false);
-  }
-
-  static void _fill(Pointer<NativeCanvasRenderingContext2D> nativePtr, Pointer<NativeString> fillRule) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    PathFillType fillType = nativeStringToString(fillRule) == EVENODD ? PathFillType.evenOdd : PathFillType.nonZero;
-
-    canvasRenderingContext2D.fill(fillType);
-  }
-
-  static void _lineTo(Pointer<NativeCanvasRenderingContext2D> nativePtr, double x, double y) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.lineTo(x, y);
-  }
-
-  static void _moveTo(Pointer<NativeCanvasRenderingContext2D> nativePtr, double x, double y) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.moveTo(x, y);
-  }
-
-  static void _quadraticCurveTo(Pointer<NativeCanvasRenderingContext2D> nativePtr, double cpx, double cpy,
-                                double x, double y) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.quadraticCurveTo(cpx, cpy, x, y);
-  }
-
-  static void _rect(Pointer<NativeCanvasRenderingContext2D> nativePtr, double x, double y,
-                    double width, double height) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.rect(x, y, width, height);
-  }
-
-  static void _rotate(Pointer<NativeCanvasRenderingContext2D> nativePtr, double angle) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.rotate(angle);
-  }
-
-  static void _resetTransform(Pointer<NativeCanvasRenderingContext2D> nativePtr) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.resetTransform();
-  }
-
-  static void _scale(Pointer<NativeCanvasRenderingContext2D> nativePtr, double x, double y) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.scale(x, y);
-  }
-
-  static void _stroke(Pointer<NativeCanvasRenderingContext2D> nativePtr) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.stroke();
-  }
-
-  static void _setTransform(Pointer<NativeCanvasRenderingContext2D> nativePtr, double a, double b, double c, double d, double e, double f) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.setTransform(a, b, c, d, e, f);
-  }
-
-  static void _transform(Pointer<NativeCanvasRenderingContext2D> nativePtr, double a, double b, double c, double d, double e, double f) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.transform(a, b, c, d, e, f);
-  }
-
-  static void _translate(Pointer<NativeCanvasRenderingContext2D> nativePtr, double x, double y) {
-    CanvasRenderingContext2D canvasRenderingContext2D = getCanvasRenderContext2DOfNativePtr(nativePtr);
-    canvasRenderingContext2D.translate(x, y);
+    // Repaint once for the whole display list.
+    if (_actions.isNotEmpty) {
+      canvas.repaintNotifier.notifyListeners(); // ignore: invalid_use_of_visible_for_testing_member, invalid_use_of_protected_member
+    }
   }
 
   late CanvasRenderingContext2DSettings _settings;
@@ -376,8 +378,27 @@ class CanvasRenderingContext2D {
 
   final List<CanvasAction> _actions = [];
 
+  int _pendingImageDecodes = 0;
+  final List<CanvasAction> _deferredActions = [];
+  final List<Completer<void>> _imageDecodeCompleters = [];
+
+  bool get hasPendingImageDecodes => _pendingImageDecodes > 0;
+
+  // Completes once the actions deferred by decoding images are added.
+  Future<void> whenImagesDecoded() {
+    Completer<void> completer = Completer();
+    _imageDecodeCompleters.add(completer);
+    return completer.future;
+  }
+
   void addAction(CanvasAction action) {
+    if (_pendingImageDecodes > 0) {
+      _deferredActions.add(action);
+      return;
+    }
     _actions.add(action);
+    // Display list triggers repaint after all actions added.
+    if (_replaying) return;
     // Must trigger repaint after action
     canvas.repaintNotifier.notifyListeners(); // ignore: invalid_use_of_visible_for_testing_member, invalid_use_of_protected_member
   }
@@ -637,6 +658,64 @@ class CanvasRenderingContext2D {
     });
   }
 
+  // Segments are in the form of [verb, points..., verb, points...], validated by native side.
+  void appendPathSegments(Float32List segments) {
+    addAction((Canvas canvas, Size size) {
+      int i = 0;
+      while (i < segments.length) {
+        CanvasPathVerb verb = CanvasPathVerb.values[segments[i].toInt()];
+        int p = i + 1;
+        switch (verb) {
+          case CanvasPathVerb.moveTo:
+            path2d.moveTo(segments[p], segments[p + 1]);
+            i = p + 2;
+            break;
+          case CanvasPathVerb.lineTo:
+            path2d.lineTo(segments[p], segments[p + 1]);
+            i = p + 2;
+            break;
+          case CanvasPathVerb.quadraticCurveTo:
+            path2d.quadraticCurveTo(segments[p], segments[p + 1], segments[p + 2], segments[p + 3]);
+            i = p + 4;
+            break;
+          case CanvasPathVerb.bezierCurveTo:
+            path2d.bezierCurveTo(segments[p], segments[p + 1], segments[p + 2], segments[p + 3], segments[p + 4], segments[p + 5]);
+            i = p + 6;
+            break;
+          case CanvasPathVerb.closePath:
+            path2d.closePath();
+            i = p;
+            break;
+        }
+      }
+    });
+  }
+
+  // https://developer.mozilla.org/en-US/docs/Web/API/CanvasRenderingContext2D/putImageData
+  void putImageData(Uint8List pixels, int width, int height, double dx, double dy) {
+    Image? image;
+    // Pixels are decoded asynchronously, actions after it wait for the decoding to keep the drawing order.
+    _pendingImageDecodes++;
+    addAction((Canvas canvas, Size size) {
+      if (image == null) return;
+      // Pixels replace the content instead of blending with it.
+      canvas.drawImage(image!, Offset(dx, dy), Paint()..blendMode = BlendMode.src);
+    });
+    decodeImageFromPixels(pixels, width, height, PixelFormat.rgba8888, (Image decoded) {
+      image = decoded;
+      _pendingImageDecodes--;
+      if (_pendingImageDecodes == 0) {
+        _actions.addAll(_deferredActions);
+        _deferredActions.clear();
+        canvas.repaintNotifier.notifyListeners(); // ignore: invalid_use_of_visible_for_testing_member, invalid_use_of_protected_member
+        for (Completer<void> completer in _imageDecodeCompleters) {
+          completer.complete();
+        }
+        _imageDecodeCompleters.clear();
+      }
+    });
+  }
+
   void rect(double x, double y, double w, double h) {
     addAction((Canvas canvas, Size size) {
       path2d.rect(x, y, w, h);
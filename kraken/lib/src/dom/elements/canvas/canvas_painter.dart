@@ -2,9 +2,13 @@
  * Copyright (C) 2019-present Alibaba Inc. All rights reserved.
  * Author: Kraken Team.
  */
+import 'dart:ffi';
+import 'dart:typed_data';
 import 'dart:ui';
+import 'package:ffi/ffi.dart';
 import 'package:flutter/foundation.dart';
 import 'package:flutter/rendering.dart';
+import 'package:kraken/bridge.dart';
 import 'canvas_context_2d.dart';
 
 class CanvasPainter extends CustomPainter {
@@ -41,12 +45,19 @@ class CanvasPainter extends CustomPainter {
 
   final Paint _saveLayerPaint = Paint();
 
+  // Size of the last paint, actions are recorded with it when pixels are read between frames.
+  Size? _paintSize;
+
   @override
   void paint(Canvas canvas, Size size) {
-    if (_hasSnapshot && !_shouldPainting) {
-      return canvas.drawPicture(_picture!);
+    _paintSize = size;
+    if (!_hasSnapshot || _shouldPainting) {
+      _recordPicture(size);
     }
+    canvas.drawPicture(_picture!);
+  }
 
+  void _recordPicture(Size size) {
     _pictureRecorder = PictureRecorder();
     _canvas = Canvas(_pictureRecorder!);
 
@@ -77,9 +88,96 @@ class CanvasPainter extends CustomPainter {
     // After calling this function, both the picture recorder
     // and the canvas objects are invalid and cannot be used further.
     _picture = _pictureRecorder!.endRecording();
+    _pictureVersion++;
+  }
 
-    canvas.drawPicture(_picture!);
+  // Record the actions submitted so far into the picture, so pixels read back include them.
+  void _recordPendingActions() {
+    CanvasRenderingContext2D? context = this.context;
+    if (context == null || !_shouldPainting) return;
+    // Scale follows the style of canvas instead of layout, so the painted size is known before the first paint.
+    _recordPicture(_paintSize ?? Size(context.canvas.attrWidth * _scaleX, context.canvas.attrHeight * _scaleY));
+  }
+
+  // dart:ui reads pixels back only asynchronously, so the pixels of a read are rasterized from the picture recorded
+  // with every action submitted before it. Pixels are kept until the picture changes.
+  int _pictureVersion = 0;
+  _CanvasPixels? _pixels;
+
+  Future<_CanvasPixels?> _rasterize() async {
+    Picture? picture = _picture;
+    if (picture == null || context == null) return null;
+    int version = _pictureVersion;
+
+    // Pixels are in the coordinate space of canvas bitmap, which is scaled to the size of element when painting.
+    // The picture is drawn into a new one right away, later resizing may dispose it.
+    int width = context!.canvas.attrWidth.toInt();
+    int height = context!.canvas.attrHeight.toInt();
+    PictureRecorder recorder = PictureRecorder();
+    Canvas canvas = Canvas(recorder);
+    canvas.scale(1 / _scaleX, 1 / _scaleY);
+    canvas.drawPicture(picture);
+    Picture bitmapPicture = recorder.endRecording();
+
+    Image image = await bitmapPicture.toImage(width, height);
+    ByteData? bytes = await image.toByteData(format: ImageByteFormat.rawRgba);
+    image.dispose();
+    bitmapPicture.dispose();
+
+    if (bytes == null) return null;
+    _CanvasPixels pixels = _CanvasPixels(bytes.buffer.asUint8List(), width, height, version);
+    // A newer picture may have been rasterized meanwhile.
+    if (_pixels == null || _pixels!.version < version) {
+      _pixels = pixels;
+    }
+    return pixels;
+  }
 
+  // Copy pixels of the rect into memory released by native side. Pixels out of canvas are transparent black.
+  Future<Pointer<NativeImageData>> getImageData(int sx, int sy, int sw, int sh) async {
+    // Actions after a putImageData are added once its pixels are decoded.
+    if (context != null && context!.hasPendingImageDecodes) {
+      await context!.whenImagesDecoded();
+    }
+    // The picture is taken before the next await, a later read or paint does not change what this read sees.
+    _recordPendingActions();
+    _CanvasPixels? pixels = _pixels;
+    if (pixels == null || pixels.version != _pictureVersion) {
+      pixels = await _rasterize();
+    }
+
+    int length = sw * sh * 4;
+    Pointer<Uint8> data = malloc.allocate<Uint8>(length);
+    Uint8List target = data.asTypedList(length);
+    target.fillRange(0, length, 0);
+
+    if (pixels != null) {
+      Uint8List bytes = pixels.bytes;
+      int left = sx < 0 ? 0 : sx;
+      int top = sy < 0 ? 0 : sy;
+      int right = sx + sw > pixels.width ? pixels.width : sx + sw;
+      int bottom = sy + sh > pixels.height ? pixels.height : sy + sh;
+      for (int y = top; y < bottom; y++) {
+        for (int x = left; x < right; x++) {
+          int from = (y * pixels.width + x) * 4;
+          int to = ((y - sy) * sw + (x - sx)) * 4;
+          int alpha = bytes[from + 3];
+          target[to + 3] = alpha;
+          if (alpha == 0) continue;
+          // Raw rgba of flutter is premultiplied, while ImageData is not.
+          target[to] = (bytes[from] * 255 / alpha).round().clamp(0, 255).toInt();
+          target[to + 1] = (bytes[from + 1] * 255 / alpha).round().clamp(0, 255).toInt();
+          target[to + 2] = (bytes[from + 2] * 255 / alpha).round().clamp(0, 255).toInt();
+        }
+      }
+    }
+
+    Pointer<NativeImageData> imageData = malloc.allocate<NativeImageData>(sizeOf<NativeImageData>());
+    imageData.ref.data = data;
+    imageData.ref.length = length;
+    imageData.ref.width = sw;
+    imageData.ref.height = sh;
+    return imageData;
   }
 
   @override
@@ -94,6 +192,9 @@ class CanvasPainter extends CustomPainter {
   void _resetPaintingContext() {
     _picture?.dispose();
     _picture = null;
+    _pictureVersion++;
+    // Resizing clears the canvas.
+    _pixels = null;
     _shouldRepaint = true;
   }
 
@@ -108,5 +209,16 @@ class CanvasPainter extends CustomPainter {
     _picture?.dispose();
     _picture = null;
     _canvas = null;
+    _pixels = null;
   }
 }
+
+// Rasterized pixels of a picture version, premultiplied rgba.
+class _CanvasPixels {
+  _CanvasPixels(this.bytes, this.width, this.height, this.version);
+
+  final Uint8List bytes;
+  final int width;
+  final int height;
+  final int version;
+}
@@ -383,7 +383,7 @@ class IntersectionChangeEvent extends Event {
 
 /// reference: https://w3c.github.io/touch-events/#touchevent-interface
 class TouchEvent extends Event {
-  TouchEvent(String type) : super(type, EventInit(bubbles: true, cancelable: true));
+  TouchEvent(String type, { bool cancelable = true }) : super(type, EventInit(bubbles: true, cancelable: cancelable));
 
   TouchList touches = TouchList();
   TouchList targetTouches = TouchList();
@@ -11,6 +11,12 @@ import 'package:meta/meta.dart';
 
 typedef EventHandler = void Function(Event event);
 
+// Event types of NativeEventTarget.subtreeListenerMask in bit order.
+const List<String> _subtreeListenerEventTypes = [
+  EVENT_CLICK, EVENT_TOUCH_START, EVENT_TOUCH_MOVE, EVENT_TOUCH_END, EVENT_TOUCH_CANCEL,
+  EVENT_SCROLL, EVENT_SWIPE, EVENT_PAN, EVENT_LONG_PRESS, EVENT_SCALE
+];
+
 class EventTarget {
   // A unique target identifier.
   final int targetId;
@@ -24,15 +30,47 @@ class EventTarget {
   @protected
   Map<String, List<EventHandler>> eventHandlers = {};
 
+  // Event types listened in JS by a listener which is not passive, so the listener may cancel the event.
+  final Set<String> _activeListenerTypes = {};
+
   EventTarget(this.targetId, this.nativeEventTargetPtr, this.elementManager);
 
   void addEvent(String eventType) {}
 
+  void setListenerPassive(String eventType, bool passive) {
+    if (passive) {
+      _activeListenerTypes.remove(eventType);
+    } else {
+      _activeListenerTypes.add(eventType);
+    }
+  }
+
+  bool hasActiveListener(String eventType) {
+    return _activeListenerTypes.contains(eventType);
+  }
+
+  // Whether js may listen events of the type on this target or its ancestors, events are not sent to js otherwise.
+  // The mask has the bit of a type when the target or one of its descendants listens, so a bit found on the path
+  // may come from another subtree, then the event is still sent. Types without a bit are always sent.
+  bool hasListenerOnPath(String eventType) {
+    int index = _subtreeListenerEventTypes.indexOf(eventType);
+    if (index < 0) return true;
+    int bit = 1 << index;
+    EventTarget? current = this;
+    while (current != null) {
+      if ((current.nativeEventTargetPtr.ref.subtreeListenerMask & bit) != 0) return true;
+      current = current is Node ? current.parentNode : null;
+    }
+    return false;
+  }
+
   void addEventListener(String eventType, EventHandler eventHandler) {
     List<EventHandler>? existHandler = eventHandlers[eventType];
     if (existHandler == null) {
       eventHandlers[eventType] = existHandler = [];
     }
+    // Adding the same handler twice is ignored, as addEvent may be called again for a type already listened.
+    if (existHandler.contains(eventHandler)) return;
     existHandler.add(eventHandler);
   }
 
@@ -67,5 +105,6 @@ class EventTarget {
   void dispose() {
     elementManager.removeTarget(this);
     eventHandlers.clear();
+    _activeListenerTypes.clear();
   }
 }
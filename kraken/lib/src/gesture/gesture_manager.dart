@@ -67,6 +67,17 @@ class GestureManager {
     _hitTestList = [];
   }
 
+  // Whether a listener which is not passive is on the propagation path of the target.
+  bool _hasActiveListener(EventTarget target, String eventType) {
+    EventTarget? current = target;
+    while (current != null) {
+      if (current.hasActiveListener(eventType)) return true;
+      current = current is Node ? current.parentNode : null;
+    }
+    Window? window = target.elementManager.getEventTargetByTargetId<Window>(WINDOW_ID);
+    return window != null && window.hasActiveListener(eventType);
+  }
+
   void addPointer(PointerEvent event) {
     // Collect the events in the hitTest.
     List<String> events = [];
@@ -139,52 +150,9 @@ class GestureManager {
     if (_pointerToTarget[event.pointer] != null) {
       RenderPointerListenerMixin currentTarget = _pointerToTarget[event.pointer] as RenderPointerListenerMixin;
 
-      TouchEvent e = TouchEvent(touchType);
-      var pointerEventOriginal = event.original;
-      // Use original event, prevent to be relative coordinate
-      if (pointerEventOriginal != null) event = pointerEventOriginal;
-
-      for (int i = 0; i < _points.length; i++) {
-        int pointer = _points[i];
-        PointerEvent point = _pointerToEvent[pointer] as PointerEvent;
-        RenderPointerListenerMixin target = _pointerToTarget[pointer] as RenderPointerListenerMixin;
-
-        EventTarget node = target.getEventTarget!();
-
-        Touch touch = Touch(
-          identifier: point.pointer,
-          target: node,
-          screenX: point.position.dx,
-          screenY: point.position.dy,
-          clientX: point.localPosition.dx,
-          clientY: point.localPosition.dy,
-          pageX: point.localPosition.dx,
-          pageY: point.localPosition.dy,
-          radiusX: point.radiusMajor,
-          radiusY: point.radiusMinor,
-          rotationAngle: point.orientation,
-          force: point.pressure,
-        );
-
-        if (pointer == event.pointer) {
-          e.changedTouches.append(touch);
-        }
-
-        if (currentTarget == target) {
-          e.targetTouches.append(touch);
-        }
-
-        e.touches.append(touch);
-      }
-
-      if (currentTarget.dispatchEvent != null) {
-        if (touchType == EVENT_TOUCH_MOVE) {
-          _throttler.throttle(() {
-            currentTarget.dispatchEvent!(e);
-          });
-        } else {
-          currentTarget.dispatchEvent!(e);
-        }
+      // Touches are not collected when js has no listener of the type on the path of the target.
+      if (currentTarget.dispatchEvent != null && currentTarget.getEventTarget!().hasListenerOnPath(touchType)) {
+        _dispatchTouchEvent(event, touchType, currentTarget);
       }
 
       if (event is PointerUpEvent || event is PointerCancelEvent) {
@@ -202,6 +170,56 @@ class GestureManager {
     }
   }
 
+  void _dispatchTouchEvent(PointerEvent event, String touchType, RenderPointerListenerMixin currentTarget) {
+    // A touchmove only listened by passive listeners can not be canceled, dispatch it as not cancelable.
+    bool cancelable = touchType != EVENT_TOUCH_MOVE || _hasActiveListener(currentTarget.getEventTarget!(), touchType);
+    TouchEvent e = TouchEvent(touchType, cancelable: cancelable);
+    var pointerEventOriginal = event.original;
+    // Use original event, prevent to be relative coordinate
+    if (pointerEventOriginal != null) event = pointerEventOriginal;
+
+    for (int i = 0; i < _points.length; i++) {
+      int pointer = _points[i];
+      PointerEvent point = _pointerToEvent[pointer] as PointerEvent;
+      RenderPointerListenerMixin target = _pointerToTarget[pointer] as RenderPointerListenerMixin;
+
+      EventTarget node = target.getEventTarget!();
+
+      Touch touch = Touch(
+        identifier: point.pointer,
+        target: node,
+        screenX: point.position.dx,
+        screenY: point.position.dy,
+        clientX: point.localPosition.dx,
+        clientY: point.localPosition.dy,
+        pageX: point.localPosition.dx,
+        pageY: point.localPosition.dy,
+        radiusX: point.radiusMajor,
+        radiusY: point.radiusMinor,
+        rotationAngle: point.orientation,
+        force: point.pressure,
+      );
+
+      if (pointer == event.pointer) {
+        e.changedTouches.append(touch);
+      }
+
+      if (currentTarget == target) {
+        e.targetTouches.append(touch);
+      }
+
+      e.touches.append(touch);
+    }
+
+    if (touchType == EVENT_TOUCH_MOVE) {
+      _throttler.throttle(() {
+        currentTarget.dispatchEvent!(e);
+      });
+    } else {
+      currentTarget.dispatchEvent!(e);
+    }
+  }
+
   void onDoubleClick() {
     if (_target != null && _target!.onClick != null) {
       if (_target!.onDoubleClick != null) {
@@ -271,11 +271,11 @@ class KrakenViewController {
     }
   }
 
-  void addEvent(int targetId, String eventType) {
+  void addEvent(int targetId, String eventType, { bool passive = false }) {
     if (kProfileMode) {
       PerformanceTiming.instance().mark(PERF_ADD_EVENT_START, uniqueId: targetId);
     }
-    _elementManager.addEvent(targetId, eventType);
+    _elementManager.addEvent(targetId, eventType, passive: passive);
     if (kProfileMode) {
       PerformanceTiming.instance().mark(PERF_ADD_EVENT_END, uniqueId: targetId);
     }
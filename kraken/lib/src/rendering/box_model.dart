@@ -8,6 +8,7 @@ import 'dart:ui';
 import 'package:flutter/rendering.dart';
 import 'package:flutter/foundation.dart';
 
+import 'package:kraken/bridge.dart';
 import 'package:kraken/css.dart';
 import 'package:kraken/dom.dart';
 import 'package:kraken/kraken.dart';
@@ -705,6 +706,7 @@ class RenderBoxModel extends RenderBox
   void markNeedsLayout() {
     super.markNeedsLayout();
     needsLayout = true;
+    invalidateGeometrySnapshots();
   }
 
   /// Mark children needs layout when drop child as Flutter did
@@ -4,6 +4,7 @@
  */
 
 import 'package:flutter/rendering.dart';
+import 'package:kraken/bridge.dart';
 import 'package:kraken/dom.dart';
 import 'package:kraken/rendering.dart';
 import 'package:kraken/css.dart';
@@ -100,6 +101,7 @@ class RenderTextBox extends RenderBox
   void markNeedsLayout() {
     super.markNeedsLayout();
     needsLayout = true;
+    invalidateGeometrySnapshots();
   }
 
   /// Mark own needs layout